@@ -4,16 +4,42 @@ in vec2 texcoord;
 in vec2 position;
 in vec4 diffuse;
 
+// One quad per instance: center and half size, rotation in radians and
+// the texcoords of the top left and bottom right corner.
+in vec4 instance_rect;
+in float instance_angle;
+in vec4 instance_texcoords;
+
 out vec2 texcoord_var;
 out vec4 diffuse_var;
 
 uniform mat3 modelviewprojection;
+uniform bool instanced;
+
+// Same corner order as the two triangles of GLPainter::draw_texture()
+const vec2 corners[6] = vec2[6](vec2(-1.0, -1.0), vec2(1.0, -1.0), vec2(1.0, 1.0),
+                                vec2(-1.0, 1.0), vec2(-1.0, -1.0), vec2(1.0, 1.0));
 
 void main(void)
 {
-  texcoord_var = texcoord;
+  vec2 pos = position;
+  vec2 uv = texcoord;
+
+  if (instanced)
+  {
+    vec2 corner = corners[gl_VertexID];
+    vec2 offset = corner * instance_rect.zw;
+    float s = sin(instance_angle);
+    float c = cos(instance_angle);
+
+    pos = instance_rect.xy + vec2(offset.x * c - offset.y * s,
+                                  offset.x * s + offset.y * c);
+    uv = mix(instance_texcoords.xy, instance_texcoords.zw, corner * 0.5 + 0.5);
+  }
+
+  texcoord_var = uv;
   diffuse_var = diffuse;
-  gl_Position = vec4(vec3(position, 1) * modelviewprojection, 1.0);
+  gl_Position = vec4(vec3(pos, 1) * modelviewprojection, 1.0);
 }
 
 /* EOF */
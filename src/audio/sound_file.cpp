@@ -41,10 +41,10 @@ const std::string& get_fallback_path(const std::string& file_path);
 ReaderDocument doc_from_file_fallback(std::string& filename)
 {
   try {
-    return ReaderDocument::from_file(filename);
+    return ReaderDocument::from_file_silent(filename);
   } catch(const std::exception&) {
     filename = get_fallback_path(filename);
-    return ReaderDocument::from_file(filename);
+    return ReaderDocument::from_file_silent(filename);
   }
 }
 
@@ -17,7 +17,9 @@
 #include "audio/sound_manager.hpp"
 
 #include <SDL.h>
+#include <algorithm>
 #include <assert.h>
+#include <chrono>
 #include <iostream>
 #include <stdexcept>
 #include <sstream>
@@ -27,14 +29,57 @@
 #include "audio/sound_file.hpp"
 #include "audio/stream_sound_source.hpp"
 #include "util/log.hpp"
+#include "util/string_util.hpp"
+#include "util/thread_pool.hpp"
+
+namespace {
+
+// Larger sounds are streamed instead of being kept in a buffer, this is
+// about 6 seconds of 44.1 kHz stereo.
+const size_t MAX_BUFFERED_SOUND_SIZE = 1024 * 1024;
+
+const size_t DEFAULT_SOUND_CACHE_SIZE = 32 * 1024 * 1024;
+
+// Number of sources that play() mixes at most, OpenAL implementations
+// usually provide at least this many.
+const int MAX_VOICES = 32;
+
+// Range of seconds that streamed sounds decode ahead, more would keep
+// a long piece of music in memory.
+const float MIN_STREAM_LOOKAHEAD = 0.1f;
+const float MAX_STREAM_LOOKAHEAD = 10.0f;
+
+// Filenames of the handles of SoundManager::get_sound_id(), shared by
+// all SoundManagers.
+struct SoundNames final
+{
+  std::vector<std::string> names;
+  std::unordered_map<std::string, SoundManager::SoundId> ids;
+};
+
+SoundNames& get_sound_names()
+{
+  static SoundNames s_names;
+  return s_names;
+}
+
+} // namespace
 
 SoundManager::SoundManager() :
   m_device(alcOpenDevice(nullptr)),
   m_context(alcCreateContext(m_device, nullptr)),
   m_sound_enabled(false),
   m_sound_volume(0),
-  m_buffers(),
+  m_stream_thread(),
+  m_stream_lookahead(2.0f),
+  m_stream_underruns(0),
+  m_sounds(),
+  m_cache_budget(DEFAULT_SOUND_CACHE_SIZE),
+  m_cache_usage(0),
+  m_use_counter(0),
+  m_prefetched(),
   m_sources(),
+  m_voices(),
   m_update_list(),
   m_music_source(),
   m_music_enabled(false),
@@ -54,6 +99,7 @@ SoundManager::SoundManager() :
     m_music_enabled = true;
 
     set_listener_orientation(Vector(0.0f, 0.0f), Vector(0.0f, -1.0f));
+    create_voices();
   } catch(std::exception& e) {
     if (m_context != nullptr) {
       alcDestroyContext(m_context);
@@ -72,9 +118,12 @@ SoundManager::~SoundManager()
 {
   m_music_source.reset();
   m_sources.clear();
+  m_prefetched.clear();
+  delete_voices();
 
-  for (const auto& buffer : m_buffers) {
-    alDeleteBuffers(1, &buffer.second);
+  for (const auto& sound : m_sounds) {
+    if (sound.state == Sound::BUFFERED)
+      alDeleteBuffers(1, &sound.buffer);
   }
 
   if (m_context != nullptr) {
@@ -88,14 +137,17 @@ SoundManager::~SoundManager()
 }
 
 ALuint
-SoundManager::load_file_into_buffer(SoundFile& file)
+SoundManager::load_file_into_buffer(SoundFile& file, std::unique_ptr<char[]> samples)
 {
   ALenum format = get_sample_format(file);
   ALuint buffer;
   alGenBuffers(1, &buffer);
   check_al_error("Couldn't create audio buffer: ");
-  std::unique_ptr<char[]> samples(new char[file.m_size]);
-  file.read(samples.get(), file.m_size);
+  if (!samples)
+  {
+    samples.reset(new char[file.m_size]);
+    file.read(samples.get(), file.m_size);
+  }
   log_debug << "buffer: " << buffer << "\n"
             << "format: " << format << "\n"
             << "samples: " << samples.get() << "\n"
@@ -110,40 +162,194 @@ SoundManager::load_file_into_buffer(SoundFile& file)
   return buffer;
 }
 
-std::unique_ptr<OpenALSoundSource>
-SoundManager::intern_create_sound_source(const std::string& filename)
+void
+SoundManager::create_voices()
 {
-  assert(m_sound_enabled);
+  for (int i = 0; i < MAX_VOICES; ++i)
+  {
+    ALuint source;
+    alGenSources(1, &source);
+    if (alGetError() != AL_NO_ERROR)
+      break;
 
-  auto source = std::make_unique<OpenALSoundSource>();
-  source->set_volume(static_cast<float>(m_sound_volume) / 100.0f);
+    alSourcef(source, AL_REFERENCE_DISTANCE, 128);
+    m_voices.add(source);
+  }
+  log_debug << "Created " << m_voices.get_voices().size() << " sound voices" << std::endl;
+}
 
-  ALuint buffer;
+void
+SoundManager::delete_voices()
+{
+  for (const auto& voice : m_voices.get_voices()) {
+    alSourceStop(voice.source);
+    alSourcei(voice.source, AL_BUFFER, AL_NONE);
+    alDeleteSources(1, &voice.source);
+  }
+  m_voices.clear();
+}
 
-  // reuse an existing static sound buffer
-  auto it = m_buffers.find(filename);
-  if (it != m_buffers.end()) {
-    buffer = it->second;
-  } else {
-    // Load sound file
-    std::unique_ptr<SoundFile> file(load_sound_file(filename));
-
-    if (file->m_size < 100000) {
-      log_debug << "Adding \"" << filename <<
-        "\" into the buffer, file size: " << file->m_size << std::endl;
-      buffer = load_file_into_buffer(*file);
-      m_buffers.insert(std::make_pair(filename, buffer));
-    } else {
-      log_debug << "Playing \"" << filename <<
-        "\" as StreamSoundSource, file size: " << file->m_size << std::endl;
-      auto stream_source = std::make_unique<StreamSoundSource>();
-      stream_source->set_sound_file(std::move(file));
-      stream_source->set_volume(static_cast<float>(m_sound_volume) / 100.0f);
-      return std::unique_ptr<OpenALSoundSource>(stream_source.release());
+bool
+SoundManager::is_voice_busy(const SoundVoicePool::Voice& voice)
+{
+  ALint state = AL_STOPPED;
+  alGetSourcei(voice.source, AL_SOURCE_STATE, &state);
+  return state == AL_PLAYING || state == AL_PAUSED;
+}
+
+SoundManager::SoundId
+SoundManager::get_sound_id(const std::string& filename)
+{
+  SoundNames& names = get_sound_names();
+  auto it = names.ids.find(filename);
+  if (it != names.ids.end())
+    return it->second;
+
+  const auto id = static_cast<SoundId>(names.names.size());
+  names.names.push_back(filename);
+  names.ids.insert(std::make_pair(filename, id));
+  return id;
+}
+
+SoundManager::Sound&
+SoundManager::get_sound(SoundId id)
+{
+  if (id >= m_sounds.size()) {
+    const auto& names = get_sound_names().names;
+    assert(id < names.size());
+    for (size_t i = m_sounds.size(); i <= id; ++i)
+      m_sounds.push_back({ names[i], Sound::UNLOADED, AL_NONE, 0, 0 });
+  }
+  return m_sounds[id];
+}
+
+std::unique_ptr<SoundFile>
+SoundManager::load_sound(Sound& sound)
+{
+  if (sound.state == Sound::BUFFERED)
+    return {};
+
+  // Load sound file
+  std::unique_ptr<char[]> samples;
+  std::unique_ptr<SoundFile> file = open_sound_file(sound.filename, samples);
+
+  if (file->m_size < MAX_BUFFERED_SOUND_SIZE) {
+    log_debug << "Adding \"" << sound.filename <<
+      "\" into the buffer, file size: " << file->m_size << std::endl;
+    sound.buffer = load_file_into_buffer(*file, std::move(samples));
+    sound.size = file->m_size;
+    sound.state = Sound::BUFFERED;
+    sound.last_use = m_use_counter++;
+    m_cache_usage += sound.size;
+    trim_cache(&sound);
+    return {};
+  }
+
+  sound.state = Sound::STREAMED;
+  return file;
+}
+
+void
+SoundManager::set_sound_cache_size(size_t bytes)
+{
+  m_cache_budget = bytes;
+  trim_cache(nullptr);
+}
+
+void
+SoundManager::trim_cache(const Sound* keep)
+{
+  // Buffers that are still attached to a source can't be deleted, they
+  // count as used and get tried again later.
+  for (size_t attempts = m_sounds.size(); m_cache_usage > m_cache_budget && attempts > 0; --attempts)
+  {
+    Sound* oldest = nullptr;
+    for (auto& sound : m_sounds) {
+      if (sound.state == Sound::BUFFERED && &sound != keep &&
+          (!oldest || sound.last_use < oldest->last_use))
+        oldest = &sound;
+    }
+    if (!oldest)
+      return;
+
+    // Voices that finished playing the sound still hold its buffer.
+    try {
+      for (const auto& voice : m_voices.get_voices()) {
+        ALint buffer = 0;
+        alGetSourcei(voice.source, AL_BUFFER, &buffer);
+        check_al_error("Couldn't query voice buffer: ");
+        if (static_cast<ALuint>(buffer) == oldest->buffer && !is_voice_busy(voice)) {
+          alSourcei(voice.source, AL_BUFFER, AL_NONE);
+          check_al_error("Couldn't detach sound buffer: ");
+        }
+      }
+    } catch(std::exception& e) {
+      log_warning << e.what() << std::endl;
+    }
+
+    alDeleteBuffers(1, &oldest->buffer);
+    try {
+      check_al_error("Couldn't delete sound buffer: ");
+    } catch(std::exception& e) {
+      // Most likely a voice is still playing it.
+      log_debug << e.what() << std::endl;
+      oldest->last_use = m_use_counter++;
+      continue;
     }
+
+    log_debug << "Dropping \"" << oldest->filename << "\" from the sound cache" << std::endl;
+    m_cache_usage -= oldest->size;
+    oldest->state = Sound::UNLOADED;
+    oldest->buffer = AL_NONE;
+    oldest->size = 0;
   }
+}
 
-  alSourcei(source->m_source, AL_BUFFER, buffer);
+void
+SoundManager::load_prefetched()
+{
+  auto it = m_prefetched.begin();
+  while (it != m_prefetched.end()) {
+    auto next = std::next(it);
+    if (!StringUtil::has_suffix(it->first, ".music") &&
+        it->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+      Sound& sound = get_sound(get_sound_id(it->first));
+      if (sound.state == Sound::UNLOADED) {
+        // Takes the entry out of m_prefetched, large files are opened
+        // again when they play.
+        try {
+          load_sound(sound);
+        } catch(std::exception& e) {
+          log_warning << "Error while preloading sound file: " << e.what() << std::endl;
+        }
+      } else {
+        m_prefetched.erase(it);
+      }
+    }
+    it = next;
+  }
+}
+
+std::unique_ptr<OpenALSoundSource>
+SoundManager::intern_create_sound_source(const std::string& filename)
+{
+  assert(m_sound_enabled);
+
+  Sound& sound = get_sound(get_sound_id(filename));
+  sound.last_use = m_use_counter++;
+  std::unique_ptr<SoundFile> file = load_sound(sound);
+  if (file) {
+    log_debug << "Playing \"" << filename <<
+      "\" as StreamSoundSource, file size: " << file->m_size << std::endl;
+    auto stream_source = std::make_unique<StreamSoundSource>();
+    stream_source->set_sound_file(std::move(file));
+    stream_source->set_volume(static_cast<float>(m_sound_volume) / 100.0f);
+    return std::unique_ptr<OpenALSoundSource>(stream_source.release());
+  }
+
+  auto source = std::make_unique<OpenALSoundSource>();
+  source->set_volume(static_cast<float>(m_sound_volume) / 100.0f);
+  alSourcei(source->m_source, AL_BUFFER, sound.buffer);
   return source;
 }
 
@@ -167,26 +373,87 @@ SoundManager::preload(const std::string& filename)
   if (!m_sound_enabled)
     return;
 
-  auto it = m_buffers.find(filename);
-  // already loaded?
-  if (it != m_buffers.end())
+  Sound& sound = get_sound(get_sound_id(filename));
+  // already loaded? large files are only kept open while they play
+  if (sound.state != Sound::UNLOADED)
     return;
-  try {
-    std::unique_ptr<SoundFile> file (load_sound_file(filename));
-    // only keep small files
-    if (file->m_size >= 100000)
-      return;
 
-    ALuint buffer = load_file_into_buffer(*file);
-    m_buffers.insert(std::make_pair(filename, buffer));
+  if (ThreadPool::current()) {
+    prefetch(filename);
+    return;
+  }
+
+  try {
+    load_sound(sound);
   } catch(std::exception& e) {
     log_warning << "Error while preloading sound file: " << e.what() << std::endl;
   }
 }
 
 void
-SoundManager::play(const std::string& filename, const Vector& pos,
-  const float gain)
+SoundManager::prefetch(const std::string& filename)
+{
+  ThreadPool* thread_pool = ThreadPool::current();
+  if (!thread_pool || filename.empty())
+    return;
+
+  const bool is_music = StringUtil::has_suffix(filename, ".music");
+  if (is_music ? (!m_music_enabled || filename == m_current_music) : !m_sound_enabled)
+    return;
+
+  // Streamed sounds open their file again every time they play.
+  if (!is_music && get_sound(get_sound_id(filename)).state != Sound::UNLOADED)
+    return;
+  if (m_prefetched.find(filename) != m_prefetched.end())
+    return;
+
+  m_prefetched[filename] = thread_pool->schedule([filename, is_music]{
+    PrefetchedSound sound;
+    sound.file = load_sound_file(filename);
+
+    // Music is always streamed.
+    if (!is_music && sound.file->m_size < MAX_BUFFERED_SOUND_SIZE)
+    {
+      sound.samples.reset(new char[sound.file->m_size]);
+      sound.file->read(sound.samples.get(), sound.file->m_size);
+    }
+    return sound;
+  });
+}
+
+void
+SoundManager::drop_prefetched()
+{
+  // Unloaded sounds are picked up by load_prefetched().
+  auto it = m_prefetched.begin();
+  while (it != m_prefetched.end()) {
+    if (!StringUtil::has_suffix(it->first, ".music") &&
+        get_sound(get_sound_id(it->first)).state == Sound::UNLOADED) {
+      ++it;
+    } else {
+      it = m_prefetched.erase(it);
+    }
+  }
+}
+
+std::unique_ptr<SoundFile>
+SoundManager::open_sound_file(const std::string& filename, std::unique_ptr<char[]>& samples)
+{
+  auto it = m_prefetched.find(filename);
+  if (it == m_prefetched.end())
+    return load_sound_file(filename);
+
+  auto sound = std::move(it->second);
+  m_prefetched.erase(it);
+
+  // Rethrows the error the file failed to load with.
+  PrefetchedSound prefetched = sound.get();
+  samples = std::move(prefetched.samples);
+  return std::move(prefetched.file);
+}
+
+void
+SoundManager::play(SoundId id, const Vector& pos, const float gain)
 {
   if (!m_sound_enabled)
     return;
@@ -194,9 +461,34 @@ SoundManager::play(const std::string& filename, const Vector& pos,
   // Test gain for invalid values; it must not exceed 1 because in the end
   // the value is set to min(sound_gain * sound_volume, 1)
   assert(gain >= 0.0f && gain <= 1.0f);
-
+  Sound& sound = get_sound(id);
+  sound.last_use = m_use_counter++;
   try {
-    std::unique_ptr<OpenALSoundSource> source(intern_create_sound_source(filename));
+    std::unique_ptr<SoundFile> file = load_sound(sound);
+    if (!file) {
+      // Louder sounds take precedence when all voices are in use.
+      SoundVoicePool::Voice* voice = m_voices.acquire(gain, is_voice_busy);
+      if (!voice)
+        return;
+
+      alSourceStop(voice->source);
+      alSourcei(voice->source, AL_BUFFER, sound.buffer);
+      alSourcef(voice->source, AL_GAIN, gain * static_cast<float>(m_sound_volume) / 100.0f);
+      if (pos.x < 0 || pos.y < 0) {
+        alSourcei(voice->source, AL_SOURCE_RELATIVE, AL_TRUE);
+        alSource3f(voice->source, AL_POSITION, 0, 0, 0);
+      } else {
+        alSourcei(voice->source, AL_SOURCE_RELATIVE, AL_FALSE);
+        alSource3f(voice->source, AL_POSITION, pos.x, pos.y, 0);
+      }
+      alSourcePlay(voice->source);
+      check_al_error("Couldn't play audio source: ");
+      return;
+    }
+
+    auto source = std::make_unique<StreamSoundSource>();
+    source->set_sound_file(std::move(file));
+    source->set_volume(static_cast<float>(m_sound_volume) / 100.0f);
     source->set_gain(gain);
 
     if (pos.x < 0 || pos.y < 0) {
@@ -207,7 +499,7 @@ SoundManager::play(const std::string& filename, const Vector& pos,
     source->play();
     m_sources.push_back(std::move(source));
   } catch(std::exception& e) {
-    log_warning << "Couldn't play sound " << filename << ": " << e.what() << std::endl;
+    log_warning << "Couldn't play sound " << sound.filename << ": " << e.what() << std::endl;
   }
 }
 
@@ -318,7 +610,8 @@ SoundManager::play_music(const std::string& filename, float fadetime)
 
   try {
     auto newmusic = std::make_unique<StreamSoundSource>();
-    newmusic->set_sound_file(load_sound_file(filename));
+    std::unique_ptr<char[]> samples;
+    newmusic->set_sound_file(open_sound_file(filename, samples));
     newmusic->set_looping(true);
     newmusic->set_relative(true);
     newmusic->set_volume(static_cast<float>(m_music_volume) / 100.0f);
@@ -327,6 +620,10 @@ SoundManager::play_music(const std::string& filename, float fadetime)
     newmusic->play();
 
     m_music_source = std::move(newmusic);
+
+    // Music that didn't start with the level is opened again when it
+    // plays, instead of keeping its file open until then.
+    drop_prefetched();
   } catch(std::exception& e) {
     log_warning << "Couldn't play music file '" << filename << "': " << e.what() << std::endl;
     // When this happens, previous music continued playing, stop it, just in case.
@@ -362,6 +659,12 @@ SoundManager::pause_sounds()
       source->pause();
     }
   }
+  for (const auto& voice : m_voices.get_voices()) {
+    ALint state = AL_STOPPED;
+    alGetSourcei(voice.source, AL_SOURCE_STATE, &state);
+    if (state == AL_PLAYING)
+      alSourcePause(voice.source);
+  }
 }
 
 void
@@ -372,6 +675,12 @@ SoundManager::resume_sounds()
       source->resume();
     }
   }
+  for (const auto& voice : m_voices.get_voices()) {
+    ALint state = AL_STOPPED;
+    alGetSourcei(voice.source, AL_SOURCE_STATE, &state);
+    if (state == AL_PAUSED)
+      alSourcePlay(voice.source);
+  }
 }
 
 void
@@ -380,6 +689,19 @@ SoundManager::stop_sounds()
   for (auto& source : m_sources) {
     source->stop();
   }
+  for (const auto& voice : m_voices.get_voices()) {
+    alSourceStop(voice.source);
+  }
+}
+
+void
+SoundManager::set_stream_lookahead(float seconds)
+{
+  // Also catches NaN from a broken config file.
+  if (!(seconds >= MIN_STREAM_LOOKAHEAD))
+    m_stream_lookahead = MIN_STREAM_LOOKAHEAD;
+  else
+    m_stream_lookahead = std::min(seconds, MAX_STREAM_LOOKAHEAD);
 }
 
 void
@@ -389,6 +711,10 @@ SoundManager::set_sound_volume(int volume)
   for (auto& source : m_sources) {
     source->set_volume(static_cast<float>(volume) / 100.0f);
   }
+  // The priority of a voice is the gain it was started with.
+  for (const auto& voice : m_voices.get_voices()) {
+    alSourcef(voice.source, AL_GAIN, voice.priority * static_cast<float>(volume) / 100.0f);
+  }
 }
 
 void
@@ -436,6 +762,13 @@ SoundManager::set_listener_orientation(const Vector& at, const Vector& up)
 void
 SoundManager::update()
 {
+  // Refilling the streams every frame only hands samples that the stream
+  // thread decoded to OpenAL. The music source is a StreamSoundSource,
+  // so it is in the list as well.
+  for (auto* stream_source : m_update_list) {
+    stream_source->update();
+  }
+
   static Uint32 lasttime = SDL_GetTicks();
   Uint32 now = SDL_GetTicks();
 
@@ -443,35 +776,27 @@ SoundManager::update()
     return;
   lasttime = now;
 
+  load_prefetched();
+
   // update and check for finished sound sources
-  for (auto it = m_sources.begin(); it != m_sources.end(); ) {
-    auto& source = *it;
+  for (size_t i = 0; i < m_sources.size(); ) {
+    auto& source = m_sources[i];
 
     source->update();
 
     if (!source->playing()) {
-      it = m_sources.erase(it);
+      source = std::move(m_sources.back());
+      m_sources.pop_back();
     } else {
-      ++it;
+      ++i;
     }
   }
-  // check streaming sounds
-  if (m_music_source) {
-    m_music_source->update();
-  }
 
   if (m_context)
   {
     alcProcessContext(m_context);
     check_alc_error("Error while processing audio context: ");
   }
-
-  //run update() for stream_sound_source
-  auto s = m_update_list.begin();
-  while (s != m_update_list.end()) {
-    (*s)->update();
-    ++s;
-  }
 }
 
 ALenum
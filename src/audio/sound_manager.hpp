@@ -16,14 +16,19 @@
 
 #pragma once
 
+#include <future>
 #include <map>
 #include <memory>
+#include <stdint.h>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <al.h>
 #include <alc.h>
 
+#include "audio/sound_stream_thread.hpp"
+#include "audio/sound_voice_pool.hpp"
 #include "math/vector.hpp"
 #include "util/currenton.hpp"
 
@@ -38,12 +43,17 @@ class SoundManager final : public Currenton<SoundManager>
   friend class StreamSoundSource;
 
 private:
-  static ALuint load_file_into_buffer(SoundFile& file);
+  /** @c samples are the already decoded samples of @c file, if any */
+  static ALuint load_file_into_buffer(SoundFile& file, std::unique_ptr<char[]> samples = {});
   static ALenum get_sample_format(const SoundFile& file);
 
   static void print_openal_version();
   static void check_al_error(const char* message);
 
+public:
+  /** Handle of a sound file, see get_sound_id() */
+  using SoundId = uint32_t;
+
 public:
   SoundManager();
   ~SoundManager() override;
@@ -56,9 +66,23 @@ public:
       This function never throws exceptions, but might return a DummySoundSource */
   std::unique_ptr<SoundSource> create_sound_source(const std::string& filename);
 
-  /** Convenience functions to simply play a sound at a given position. */
-  void play(const std::string& name, const Vector& pos = Vector(-1, -1),
+  /** Returns the handle of @c filename. Playing a sound by its handle
+      skips looking up the filename. Handles are valid for the whole run,
+      so hot call sites keep them as constants. Create them on the main
+      thread. */
+  static SoundId get_sound_id(const std::string& filename);
+
+  /** Convenience functions to simply play a sound at a given position.
+      Buffered sounds are played on a fixed set of sources, when all of
+      them are busy the quietest and oldest sound is cut off, unless
+      it is louder than the new one. */
+  void play(SoundId id, const Vector& pos = Vector(-1, -1),
     const float gain = 0.5f);
+  void play(const std::string& name, const Vector& pos = Vector(-1, -1),
+    const float gain = 0.5f)
+  {
+    play(get_sound_id(name), pos, gain);
+  }
   void play(const std::string& name, const float gain)
   {
     play(name, Vector(-1, -1), gain);
@@ -69,9 +93,20 @@ public:
       when it finished playing) */
   void manage_source(std::unique_ptr<SoundSource> source);
 
-  /** preloads a sound, so that you don't get a lag later when playing it */
+  /** preloads a sound, so that you don't get a lag later when playing it.
+      With a ThreadPool the sound is decoded in the background and
+      update() fills its buffer once it is done. */
   void preload(const std::string& name);
 
+  /** Starts opening a sound or music file on the ThreadPool, small
+      sounds get decoded completely, so that preload() and play() only
+      have to fill the OpenAL buffer afterwards. */
+  void prefetch(const std::string& filename);
+
+  /** Forgets the prefetched files that nothing is going to take: the
+      sounds that got streamed meanwhile and all music */
+  void drop_prefetched();
+
   void set_listener_position(const Vector& position);
   void set_listener_velocity(const Vector& velocity);
   void set_listener_orientation(const Vector& at, const Vector& up);
@@ -94,6 +129,22 @@ public:
 
   inline bool is_audio_enabled() const { return m_device != nullptr && m_context != nullptr; }
   inline const std::string& get_current_music() const { return m_current_music; }
+
+  /** Seconds of samples that streamed sounds decode ahead of playback,
+      applies to streams opened afterwards. Clamped to a sane range. */
+  void set_stream_lookahead(float seconds);
+  inline float get_stream_lookahead() const { return m_stream_lookahead; }
+
+  /** Number of times a streamed sound ran out of samples and had to be
+      restarted */
+  inline int get_stream_underruns() const { return m_stream_underruns; }
+
+  /** Bytes of samples kept in buffers, the least recently played sounds
+      are dropped when they exceed the budget. Sounds that a source is
+      attached to stay. */
+  void set_sound_cache_size(size_t bytes);
+  inline size_t get_sound_cache_usage() const { return m_cache_usage; }
+
   void update();
 
   /** Tell soundmanager to call update() for stream_sound_source. */
@@ -103,20 +154,89 @@ public:
   void remove_from_update(StreamSoundSource* sss);
 
 private:
+  /** A sound file by its SoundId */
+  struct Sound
+  {
+    enum State { UNLOADED, BUFFERED, STREAMED };
+
+    std::string filename;
+    State state;
+
+    /** The samples of BUFFERED sounds and their size in bytes */
+    ALuint buffer;
+    size_t size;
+
+    /** Value of m_use_counter when the sound was last played */
+    uint64_t last_use;
+  };
+
+private:
+  /** The state of the sound file with handle @c id */
+  Sound& get_sound(SoundId id);
+
   /** creates a new sound source, might throw exceptions, never returns nullptr */
   std::unique_ptr<OpenALSoundSource> intern_create_sound_source(const std::string& filename);
 
+  /** Fills the buffer of @c sound if it is small enough and wasn't
+      loaded before. Returns the opened file of sounds that have to be
+      streamed, nullptr otherwise. Throws if the file can't be loaded. */
+  std::unique_ptr<SoundFile> load_sound(Sound& sound);
+
+  /** Deletes the buffers of the least recently played sounds until the
+      cache fits its budget again, @c keep is never deleted. */
+  void trim_cache(const Sound* keep);
+
+  /** Fills the buffers of the sounds that finished decoding in the
+      background */
+  void load_prefetched();
+
+  /** Generates the sources of m_voices, as many as OpenAL allows up to
+      a limit. */
+  void create_voices();
+  void delete_voices();
+
+  static bool is_voice_busy(const SoundVoicePool::Voice& voice);
+
   void check_alc_error(const char* message) const;
 
+  /** Takes the prefetched file for @c filename or opens it now,
+      @c samples receives the decoded samples if they are known. */
+  std::unique_ptr<SoundFile> open_sound_file(const std::string& filename,
+                                             std::unique_ptr<char[]>& samples);
+
+private:
+  /** A sound file opened in the background, with all its samples if it
+      is small enough to be kept in a buffer */
+  struct PrefetchedSound
+  {
+    std::unique_ptr<SoundFile> file;
+    std::unique_ptr<char[]> samples;
+  };
+
 private:
   ALCdevice* m_device;
   ALCcontext* m_context;
   bool m_sound_enabled;
   int m_sound_volume;
 
-  std::map<std::string, ALuint> m_buffers;
+  /** Decodes the StreamSoundSources, declared before anything that
+      owns them */
+  SoundStreamThread m_stream_thread;
+  float m_stream_lookahead;
+  int m_stream_underruns;
+
+  /** Sounds by SoundId, grown as handles get used */
+  std::vector<Sound> m_sounds;
+  size_t m_cache_budget;
+  size_t m_cache_usage;
+  uint64_t m_use_counter;
+  std::map<std::string, std::future<PrefetchedSound>> m_prefetched;
   std::vector<std::unique_ptr<OpenALSoundSource> > m_sources;
 
+  /** Sources for play(), the stream sources it creates for large
+      sounds go to m_sources */
+  SoundVoicePool m_voices;
+
   std::vector<StreamSoundSource*> m_update_list;
 
   std::unique_ptr<StreamSoundSource> m_music_source;
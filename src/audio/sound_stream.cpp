@@ -0,0 +1,120 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "audio/sound_stream.hpp"
+
+#include "audio/sound_file.hpp"
+#include "util/log.hpp"
+
+SoundStream::SoundStream(std::unique_ptr<SoundFile> file, size_t fragment_size, size_t fragment_count) :
+  m_file(std::move(file)),
+  m_fragments(fragment_count),
+  m_fragment_size(fragment_size),
+  m_read(0),
+  m_write(0),
+  m_looping(false),
+  m_end(false)
+{
+  for (auto& fragment : m_fragments)
+  {
+    fragment.data.reset(new char[m_fragment_size]);
+    fragment.size = 0;
+  }
+}
+
+SoundStream::~SoundStream()
+{
+}
+
+bool
+SoundStream::decode(size_t max_fragments)
+{
+  if (m_end.load(std::memory_order_acquire))
+  {
+    // Looping got turned on after the end was reached.
+    if (!m_looping.load())
+      return false;
+    m_file->reset();
+    m_end.store(false, std::memory_order_release);
+  }
+
+  bool decoded = false;
+  size_t write = m_write.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < max_fragments &&
+         write - m_read.load(std::memory_order_acquire) < m_fragments.size(); ++i)
+  {
+    Fragment& fragment = m_fragments[write % m_fragments.size()];
+    size_t bytesread = 0;
+    try
+    {
+      do {
+        bytesread += m_file->read(fragment.data.get() + bytesread,
+                                  m_fragment_size - bytesread);
+        // end of sound file
+        if (bytesread < m_fragment_size) {
+          if (m_looping.load())
+            m_file->reset();
+          else
+            break;
+        }
+      } while (bytesread < m_fragment_size);
+    }
+    catch (const std::exception& e)
+    {
+      log_warning << "Couldn't decode sound stream: " << e.what() << std::endl;
+      m_looping.store(false);
+      bytesread = 0;
+    }
+
+    fragment.size = bytesread;
+    if (bytesread > 0)
+    {
+      write += 1;
+      m_write.store(write, std::memory_order_release);
+      decoded = true;
+    }
+
+    if (bytesread < m_fragment_size)
+    {
+      m_end.store(true, std::memory_order_release);
+      break;
+    }
+  }
+  return decoded;
+}
+
+const SoundStream::Fragment*
+SoundStream::front() const
+{
+  const size_t read = m_read.load(std::memory_order_relaxed);
+  if (read == m_write.load(std::memory_order_acquire))
+    return nullptr;
+
+  return &m_fragments[read % m_fragments.size()];
+}
+
+void
+SoundStream::pop()
+{
+  m_read.store(m_read.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+bool
+SoundStream::is_finished() const
+{
+  return m_end.load(std::memory_order_acquire) &&
+         m_read.load(std::memory_order_relaxed) == m_write.load(std::memory_order_acquire);
+}
@@ -0,0 +1,80 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class SoundFile;
+
+/**
+ * Decoded samples of a streamed sound file, kept in a fixed ring of
+ * fragments. One thread decodes into the ring with decode() while
+ * another one takes the fragments out with front() and pop(), neither
+ * of them blocks the other.
+ */
+class SoundStream final
+{
+public:
+  struct Fragment
+  {
+    std::unique_ptr<char[]> data;
+
+    /** Bytes of decoded samples in data */
+    size_t size;
+  };
+
+public:
+  SoundStream(std::unique_ptr<SoundFile> file, size_t fragment_size, size_t fragment_count);
+  ~SoundStream();
+
+  /** Decodes into up to @c max_fragments free fragments, returns
+      whether any got filled. Errors end the stream. */
+  bool decode(size_t max_fragments = static_cast<size_t>(-1));
+
+  /** The oldest decoded fragment, nullptr if the decoder fell behind
+      or the stream is finished */
+  const Fragment* front() const;
+  void pop();
+
+  /** True once all samples of a non-looping stream are taken out */
+  bool is_finished() const;
+
+  /** Starts the file over when reaching its end */
+  inline void set_looping(bool looping) { m_looping.store(looping); }
+
+  /** The format of the samples, which doesn't change after opening */
+  inline const SoundFile& get_file() const { return *m_file; }
+
+private:
+  std::unique_ptr<SoundFile> m_file;
+  std::vector<Fragment> m_fragments;
+  const size_t m_fragment_size;
+
+  /** Number of fragments taken out and filled so far, their difference
+      is the number of decoded fragments in the ring */
+  std::atomic<size_t> m_read;
+  std::atomic<size_t> m_write;
+
+  std::atomic<bool> m_looping;
+  std::atomic<bool> m_end;
+
+private:
+  SoundStream(const SoundStream&) = delete;
+  SoundStream& operator=(const SoundStream&) = delete;
+};
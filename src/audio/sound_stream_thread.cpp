@@ -0,0 +1,131 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "audio/sound_stream_thread.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <system_error>
+
+#include "audio/sound_stream.hpp"
+#include "util/log.hpp"
+
+namespace {
+
+// Streams get checked this often even when nobody calls wake().
+const std::chrono::milliseconds POLL_INTERVAL(50);
+
+} // namespace
+
+SoundStreamThread::SoundStreamThread() :
+  m_thread(),
+  m_mutex(),
+  m_cv(),
+  m_streams(),
+  m_woken(false),
+  m_quit(false),
+  m_failed(false)
+{
+}
+
+SoundStreamThread::~SoundStreamThread()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_quit = true;
+  }
+  m_cv.notify_all();
+
+  if (m_thread.joinable())
+    m_thread.join();
+}
+
+bool
+SoundStreamThread::add(std::shared_ptr<SoundStream> stream)
+{
+#ifdef __EMSCRIPTEN__
+  return false;
+#else
+  if (m_failed)
+    return false;
+
+  if (!m_thread.joinable())
+  {
+    try
+    {
+      m_thread = std::thread(&SoundStreamThread::run, this);
+    }
+    catch (const std::system_error& e)
+    {
+      log_warning << "Couldn't start sound streaming thread: " << e.what() << std::endl;
+      m_failed = true;
+      return false;
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_streams.push_back(std::move(stream));
+    m_woken = true;
+  }
+  m_cv.notify_one();
+  return true;
+#endif
+}
+
+void
+SoundStreamThread::remove(const SoundStream* stream)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_streams.erase(std::remove_if(m_streams.begin(), m_streams.end(),
+                                 [stream](const std::shared_ptr<SoundStream>& other) {
+                                   return other.get() == stream;
+                                 }),
+                  m_streams.end());
+}
+
+void
+SoundStreamThread::wake()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_woken = true;
+  }
+  m_cv.notify_one();
+}
+
+void
+SoundStreamThread::run()
+{
+  // Keeps the streams alive while they decode without holding the lock,
+  // a stream removed meanwhile is destroyed here afterwards.
+  std::vector<std::shared_ptr<SoundStream>> streams;
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (!m_quit)
+  {
+    m_woken = false;
+    streams = m_streams;
+    lock.unlock();
+
+    for (const auto& stream : streams)
+      stream->decode();
+    streams.clear();
+
+    lock.lock();
+    m_cv.wait_for(lock, POLL_INTERVAL, [this]{ return m_quit || m_woken; });
+  }
+}
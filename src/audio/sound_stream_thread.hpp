@@ -0,0 +1,62 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class SoundStream;
+
+/**
+ * Background thread that decodes all streamed sounds ahead of their
+ * OpenAL queues, so that the main thread only has to hand the decoded
+ * samples to OpenAL. The thread is started with the first stream.
+ */
+class SoundStreamThread final
+{
+public:
+  SoundStreamThread();
+  ~SoundStreamThread();
+
+  /** Starts decoding @c stream in the background. Returns false when
+      no thread can run, the owner has to call SoundStream::decode()
+      itself then. */
+  bool add(std::shared_ptr<SoundStream> stream);
+  void remove(const SoundStream* stream);
+
+  /** Tells the thread that fragments got taken out of a stream */
+  void wake();
+
+private:
+  void run();
+
+private:
+  std::thread m_thread;
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::vector<std::shared_ptr<SoundStream>> m_streams;
+  bool m_woken;
+  bool m_quit;
+  bool m_failed;
+
+private:
+  SoundStreamThread(const SoundStreamThread&) = delete;
+  SoundStreamThread& operator=(const SoundStreamThread&) = delete;
+};
@@ -0,0 +1,95 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * Fixed set of OpenAL sources for the sounds that SoundManager::play()
+ * starts and forgets. When all of them are busy, the least important
+ * sound is cut off for a new one, of equally important ones the one
+ * that has been playing the longest.
+ */
+class SoundVoicePool final
+{
+public:
+  struct Voice
+  {
+    unsigned int source;
+    float priority;
+
+    /** Number of the acquire() that handed out the voice, lower ones
+        are older */
+    uint64_t serial;
+  };
+
+public:
+  SoundVoicePool() :
+    m_voices(),
+    m_serial(0),
+    m_steal_count(0)
+  {}
+
+  inline void add(unsigned int source) { m_voices.push_back({ source, 0.0f, 0 }); }
+  inline void clear() { m_voices.clear(); }
+
+  inline std::vector<Voice>& get_voices() { return m_voices; }
+  inline uint64_t get_steal_count() const { return m_steal_count; }
+
+  /** Returns a voice for a sound of @c priority, or nullptr if all of
+      them play more important sounds. @c is_busy tells whether a voice
+      is still in use. A returned voice may still be playing and needs
+      to be stopped before it is reused. */
+  template<typename IsBusy>
+  Voice* acquire(float priority, const IsBusy& is_busy)
+  {
+    Voice* victim = nullptr;
+    for (auto& voice : m_voices)
+    {
+      if (!is_busy(voice))
+        return take(voice, priority);
+
+      if (!victim || voice.priority < victim->priority ||
+          (voice.priority == victim->priority && voice.serial < victim->serial))
+        victim = &voice;
+    }
+
+    if (!victim || victim->priority > priority)
+      return nullptr;
+
+    m_steal_count += 1;
+    return take(*victim, priority);
+  }
+
+private:
+  inline Voice* take(Voice& voice, float priority)
+  {
+    voice.priority = priority;
+    voice.serial = m_serial++;
+    return &voice;
+  }
+
+private:
+  std::vector<Voice> m_voices;
+  uint64_t m_serial;
+  uint64_t m_steal_count;
+
+private:
+  SoundVoicePool(const SoundVoicePool&) = delete;
+  SoundVoicePool& operator=(const SoundVoicePool&) = delete;
+};
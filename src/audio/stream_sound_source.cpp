@@ -14,14 +14,25 @@
 //  You should have received a copy of the GNU General Public License
 //  along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
+#include "audio/stream_sound_source.hpp"
+
+#include <algorithm>
+#include <math.h>
+
 #include "audio/sound_file.hpp"
 #include "audio/sound_manager.hpp"
-#include "audio/stream_sound_source.hpp"
+#include "audio/sound_stream.hpp"
 #include "supertux/globals.hpp"
 #include "util/log.hpp"
 
 StreamSoundSource::StreamSoundSource() :
-  m_file(),
+  m_stream(),
+  m_stream_started(false),
+  m_decode_here(false),
+  m_buffers(),
+  m_free_buffers(),
+  m_free_buffer_count(0),
+  m_playing(false),
   m_fade_state(NoFading),
   m_fade_start_time(),
   m_fade_time(),
@@ -36,6 +47,9 @@ StreamSoundSource::StreamSoundSource() :
   {
     log_warning << e.what() << std::endl;
   }
+  std::copy(m_buffers, m_buffers + STREAMFRAGMENTS, m_free_buffers);
+  m_free_buffer_count = STREAMFRAGMENTS;
+
   //add me to update list
   SoundManager::current()->register_for_update( this );
 }
@@ -44,7 +58,7 @@ StreamSoundSource::~StreamSoundSource()
 {
   //don't update me any longer
   SoundManager::current()->remove_from_update( this );
-  m_file.reset();
+  release_stream();
   stop();
   alDeleteBuffers(STREAMFRAGMENTS, m_buffers);
   try
@@ -61,14 +75,112 @@ StreamSoundSource::~StreamSoundSource()
 void
 StreamSoundSource::set_sound_file(std::unique_ptr<SoundFile> newfile)
 {
-  m_file = std::move(newfile);
+  if (m_stream) {
+    stop();
+    release_stream();
+  }
+
+  // Keep the configured time of samples decoded ahead of the queue.
+  const float bytes_per_second = static_cast<float>(newfile->m_rate * newfile->m_channels *
+                                                    newfile->m_bits_per_sample / 8);
+  const float lookahead = SoundManager::current()->get_stream_lookahead() * bytes_per_second;
+  const size_t fragment_count = std::max(static_cast<size_t>(2),
+    static_cast<size_t>(ceilf(lookahead / static_cast<float>(STREAMFRAGMENTSIZE))));
+
+  m_stream = std::make_shared<SoundStream>(std::move(newfile), STREAMFRAGMENTSIZE, fragment_count);
+  m_stream->set_looping(m_looping);
+}
+
+void
+StreamSoundSource::start_stream()
+{
+  if (!m_stream || m_stream_started)
+    return;
+
+  // Enough to start playing, the thread decodes the rest.
+  m_stream->decode(1);
+  m_decode_here = !SoundManager::current()->m_stream_thread.add(m_stream);
+  m_stream_started = true;
+}
+
+void
+StreamSoundSource::release_stream()
+{
+  if (m_stream_started && !m_decode_here)
+    SoundManager::current()->m_stream_thread.remove(m_stream.get());
+
+  m_stream.reset();
+  m_stream_started = false;
+  m_decode_here = false;
+}
 
-  ALint queued;
-  alGetSourcei(m_source, AL_BUFFERS_QUEUED, &queued);
-  for (size_t i = 0; i < STREAMFRAGMENTS - queued; ++i) {
-    if (fillBufferAndQueue(m_buffers[i]) == false)
+void
+StreamSoundSource::queue_fragments()
+{
+  bool popped = false;
+  while (m_free_buffer_count > 0)
+  {
+    const SoundStream::Fragment* fragment = m_stream->front();
+    // Without the stream thread, only decode what gets queued now.
+    if (!fragment && m_decode_here && m_stream->decode(1))
+      fragment = m_stream->front();
+    if (!fragment)
       break;
+
+    const ALuint buffer = m_free_buffers[m_free_buffer_count - 1];
+    try
+    {
+      const SoundFile& file = m_stream->get_file();
+      alBufferData(buffer, SoundManager::get_sample_format(file), fragment->data.get(),
+                   static_cast<ALsizei>(fragment->size), file.m_rate);
+      SoundManager::check_al_error("Couldn't refill audio buffer: ");
+
+      alSourceQueueBuffers(m_source, 1, &buffer);
+      SoundManager::check_al_error("Couldn't queue audio buffer: ");
+      m_free_buffer_count -= 1;
+    }
+    catch(std::exception& e)
+    {
+      log_warning << e.what() << std::endl;
+    }
+    m_stream->pop();
+    popped = true;
   }
+
+  if (popped && !m_decode_here)
+    SoundManager::current()->m_stream_thread.wake();
+}
+
+void
+StreamSoundSource::play()
+{
+  if (m_stream) {
+    start_stream();
+    queue_fragments();
+  }
+  m_playing = true;
+  OpenALSoundSource::play();
+}
+
+void
+StreamSoundSource::stop(bool unload_buffer)
+{
+  OpenALSoundSource::stop(unload_buffer);
+  m_playing = false;
+
+  // Unloading the buffer takes all of them off the queue.
+  if (unload_buffer) {
+    std::copy(m_buffers, m_buffers + STREAMFRAGMENTS, m_free_buffers);
+    m_free_buffer_count = STREAMFRAGMENTS;
+  }
+}
+
+void
+StreamSoundSource::set_looping(bool looping_)
+{
+  m_looping = looping_;
+  if (m_stream)
+    m_stream->set_looping(looping_);
 }
 
 void
@@ -90,23 +202,34 @@ StreamSoundSource::update()
     try
     {
       SoundManager::check_al_error("Couldn't unqueue audio buffer: ");
+      m_free_buffers[m_free_buffer_count++] = buffer;
     }
     catch(std::exception& e)
     {
       log_warning << e.what() << std::endl;
     }
-
-    if (fillBufferAndQueue(buffer) == false)
-      break;
   }
 
+  if (m_stream_started)
+    queue_fragments();
+
   if (!playing() && !paused()) {
-    if (processed == 0 || !m_looping)
+    if (!m_playing)
       return;
 
-    // we might have to restart the source if we had a buffer underrun
+    ALint queued = 0;
+    alGetSourcei(m_source, AL_BUFFERS_QUEUED, &queued);
+    if (queued == 0) {
+      // Either the stream ended or the decoder has yet to catch up.
+      if (!m_stream || m_stream->is_finished())
+        m_playing = false;
+      return;
+    }
+
+    // we have to restart the source if we had a buffer underrun
     log_info << "Restarting audio source because of buffer underrun" << std::endl;
-    play();
+    SoundManager::current()->m_stream_underruns += 1;
+    OpenALSoundSource::play();
   }
 
   if (m_fade_state == FadingOn || m_fade_state == FadingResume) {
@@ -138,41 +261,3 @@ StreamSoundSource::set_fading(FadeState state, float fade_time_)
   m_fade_time = fade_time_;
   m_fade_start_time = g_real_time;
 }
-
-bool
-StreamSoundSource::fillBufferAndQueue(ALuint buffer)
-{
-  // fill buffer
-  std::unique_ptr<char[]> bufferdata(new char[STREAMFRAGMENTSIZE]);
-  size_t bytesread = 0;
-  do {
-    bytesread += m_file->read(static_cast<char *>(bufferdata.get()) + bytesread,
-      STREAMFRAGMENTSIZE - bytesread);
-    // end of sound file
-    if (bytesread < STREAMFRAGMENTSIZE) {
-      if (m_looping)
-        m_file->reset();
-      else
-        break;
-    }
-  } while(bytesread < STREAMFRAGMENTSIZE);
-
-  if (bytesread > 0) {
-    ALenum format = SoundManager::get_sample_format(*m_file);
-    try
-    {
-      alBufferData(buffer, format, bufferdata.get(), static_cast<ALsizei>(bytesread), m_file->m_rate);
-      SoundManager::check_al_error("Couldn't refill audio buffer: ");
-
-      alSourceQueueBuffers(m_source, 1, &buffer);
-      SoundManager::check_al_error("Couldn't queue audio buffer: ");
-    }
-    catch(std::exception& e)
-    {
-      log_warning << e.what() << std::endl;
-    }
-  }
-
-  // return false if there aren't more buffers to fill
-  return bytesread >= STREAMFRAGMENTSIZE;
-}
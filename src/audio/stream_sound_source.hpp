@@ -16,9 +16,12 @@
 
 #pragma once
 
+#include <memory>
+
 #include "audio/openal_sound_source.hpp"
 
 class SoundFile;
+class SoundStream;
 
 class StreamSoundSource final : public OpenALSoundSource
 {
@@ -34,10 +37,14 @@ public:
   StreamSoundSource();
   ~StreamSoundSource() override;
 
+  virtual void play() override;
+  virtual void stop(bool unload_buffer = true) override;
   virtual void resume() override;
   virtual void update() override;
-  virtual void set_looping(bool looping_) override { m_looping = looping_; }
+  virtual void set_looping(bool looping_) override;
 
+  /** The file is decoded on the SoundManager's stream thread once the
+      source starts playing. */
   void set_sound_file(std::unique_ptr<SoundFile> newfile);
 
   void set_fading(FadeState state, float fadetime);
@@ -45,12 +52,31 @@ public:
   inline bool get_looping() const { return m_looping; }
 
 private:
-  bool fillBufferAndQueue(ALuint buffer);
+  /** Hands the stream to the decoding thread, decoding the first
+      fragments right away */
+  void start_stream();
+  void release_stream();
+
+  /** Queues decoded fragments into the free buffers */
+  void queue_fragments();
 
 private:
-  std::unique_ptr<SoundFile> m_file;
+  std::shared_ptr<SoundStream> m_stream;
+  bool m_stream_started;
+
+  /** Decodes the stream on the main thread when no thread is running */
+  bool m_decode_here;
+
   ALuint m_buffers[STREAMFRAGMENTS];
 
+  /** Buffers that are not queued on the source */
+  ALuint m_free_buffers[STREAMFRAGMENTS];
+  size_t m_free_buffer_count;
+
+  /** The source should be playing, if it stopped nonetheless, it ran out
+      of samples. */
+  bool m_playing;
+
   FadeState m_fade_state;
   float m_fade_start_time;
   float m_fade_time;
@@ -46,6 +46,14 @@ static const float FADEOUT_TIME = 0.2f;
 
 static const float X_OFFSCREEN_DISTANCE = 1280;
 static const float Y_OFFSCREEN_DISTANCE = 800;
+static const SoundManager::SoundId SQUISH_SOUND = SoundManager::get_sound_id("sounds/squish.wav");
+static const SoundManager::SoundId BRICK_SOUND = SoundManager::get_sound_id("sounds/brick.wav");
+static const SoundManager::SoundId FALL_SOUND = SoundManager::get_sound_id("sounds/fall.wav");
+
+const std::vector<std::string> BadGuy::s_preload_sounds = {
+  "sounds/squish.wav", "sounds/fall.wav", "sounds/sizzle.ogg",
+  "sounds/splash.ogg", "sounds/fire.ogg"
+};
 
 BadGuy::BadGuy(const Vector& pos, const std::string& sprite_name, int layer,
                const std::string& light_sprite_name, const std::string& ice_sprite_name,
@@ -86,11 +94,8 @@ BadGuy::BadGuy(const Vector& pos, Direction direction, const std::string& sprite
   m_flame_color(1.f, 0.5f, 0.2f, 1.f),
   m_flame_timer()
 {
-  SoundManager::current()->preload("sounds/squish.wav");
-  SoundManager::current()->preload("sounds/fall.wav");
-  SoundManager::current()->preload("sounds/sizzle.ogg");
-  SoundManager::current()->preload("sounds/splash.ogg");
-  SoundManager::current()->preload("sounds/fire.ogg");
+  for (const auto& sound : s_preload_sounds)
+    SoundManager::current()->preload(sound);
 
   m_dir = (m_start_dir == Direction::AUTO) ? Direction::LEFT : m_start_dir;
   m_lightsprite->set_blend(Blend::ADD);
@@ -145,11 +150,8 @@ BadGuy::BadGuy(const ReaderMapping& reader, const std::string& sprite_name,
 
   reader.get("dead-script", m_dead_script);
 
-  SoundManager::current()->preload("sounds/squish.wav");
-  SoundManager::current()->preload("sounds/fall.wav");
-  SoundManager::current()->preload("sounds/sizzle.ogg");
-  SoundManager::current()->preload("sounds/splash.ogg");
-  SoundManager::current()->preload("sounds/fire.ogg");
+  for (const auto& sound : s_preload_sounds)
+    SoundManager::current()->preload(sound);
 
   m_dir = (m_start_dir == Direction::AUTO) ? Direction::LEFT : m_start_dir;
   m_lightsprite->set_blend(Blend::ADD);
@@ -718,7 +720,7 @@ BadGuy::kill_squished(GameObject& object)
 {
   if (!is_active()) return;
 
-  SoundManager::current()->play("sounds/squish.wav", get_pos());
+  SoundManager::current()->play(SQUISH_SOUND, get_pos());
   m_physic.enable_gravity(true);
   m_physic.set_velocity(0, 0);
   set_state(STATE_SQUISHED);
@@ -738,7 +740,7 @@ BadGuy::kill_fall()
   if (!is_active()) return;
 
   if (m_frozen) {
-    SoundManager::current()->play("sounds/brick.wav", get_pos());
+    SoundManager::current()->play(BRICK_SOUND, get_pos());
     Vector pr_pos(0.0f, 0.0f);
     float cx = m_col.m_bbox.get_width() / 2.f;
     float cy = m_col.m_bbox.get_height() / 2.f;
@@ -759,7 +761,7 @@ BadGuy::kill_fall()
     run_dead_script();
     remove_me();
   } else {
-    SoundManager::current()->play("sounds/fall.wav", get_pos());
+    SoundManager::current()->play(FALL_SOUND, get_pos());
     m_physic.set_velocity_y(0);
     m_physic.set_acceleration_y(0);
     m_physic.enable_gravity(true);
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "editor/object_option.hpp"
 #include "object/moving_sprite.hpp"
 #include "object/portable.hpp"
@@ -73,6 +75,10 @@ public:
       state and calls active_update and inactive_update */
   virtual void update(float dt_sec) override;
 
+  /** The sounds that every badguy preloads, AssetPrefetch starts loading
+      them for levels that contain the object. */
+  static const std::vector<std::string> s_preload_sounds;
+
   static std::string class_name() { return "badguy"; }
   virtual std::string get_class_name() const override { return class_name(); }
   virtual std::string get_exposed_class_name() const override { return "BadGuy"; }
@@ -23,6 +23,7 @@
 
 namespace {
 const float DART_SPEED = 200;
+const SoundManager::SoundId STOMP_SOUND = SoundManager::get_sound_id("sounds/stomp.wav");
 }
 
 static const std::string DART_SOUND = "sounds/flame.wav";
@@ -113,7 +114,7 @@ Dart::collision_badguy(BadGuy& badguy, const CollisionHit& )
   if (&badguy == parent) {
     return FORCE_MOVE;
   }
-  SoundManager::current()->play("sounds/stomp.wav", get_pos());
+  SoundManager::current()->play(STOMP_SOUND, get_pos());
   remove_me();
   badguy.kill_fall();
   return ABORT_MOVE;
@@ -122,7 +123,7 @@ Dart::collision_badguy(BadGuy& badguy, const CollisionHit& )
 HitResponse
 Dart::collision_player(Player& player, const CollisionHit& hit)
 {
-  SoundManager::current()->play("sounds/stomp.wav", get_pos());
+  SoundManager::current()->play(STOMP_SOUND, get_pos());
   remove_me();
   return BadGuy::collision_player(player, hit);
 }
@@ -35,6 +35,21 @@ const float NORMAL_WALK_SPEED = 80.0f;
 const float EXPLODING_WALK_SPEED = 250.0f;
 const float SKID_TIME = 0.3f;
 
+/* Actions that active_update() sets every frame */
+const ActionId JUMP_ACTION("jump");
+const ActionId SKID_ACTION("skid");
+const ActionId SKID_LEFT_ACTION("skid-left");
+const ActionId SKID_RIGHT_ACTION("skid-right");
+const ActionId TICKING_ACTION("ticking");
+const ActionId TICKING_LEFT_ACTION("ticking-left");
+const ActionId TICKING_RIGHT_ACTION("ticking-right");
+const ActionId RUN_ACTION("run");
+const ActionId ACTIVE_ACTION("active");
+const ActionId ACTIVE_LEFT_ACTION("active-left");
+const ActionId ACTIVE_RIGHT_ACTION("active-right");
+const ActionId LEFT_ACTION("left");
+const ActionId RIGHT_ACTION("right");
+
 } // namespace
 
 Haywire::Haywire(const ReaderMapping& reader) :
@@ -171,26 +186,26 @@ Haywire::active_update(float dt_sec)
 	  if (stomped_timer.get_timeleft() < 0.05f) {
       if (m_jumping)
       {
-        set_action("jump", m_dir, /* loops = */ 1);
-        m_exploding_sprite->set_action("jump", /* loops = */ 1);
+        set_action(JUMP_ACTION, m_dir, /* loops = */ 1);
+        m_exploding_sprite->set_action(JUMP_ACTION, /* loops = */ 1);
       }
       else if (!m_skid_timer.check() && m_skid_timer.started())
       {
-        set_action((m_last_player_direction == Direction::LEFT) ? "skid-right" : "skid-left", /* loops = */ 1);
-        m_exploding_sprite->set_action("skid", /* loops = */ 1);
+        set_action((m_last_player_direction == Direction::LEFT) ? SKID_RIGHT_ACTION : SKID_LEFT_ACTION, /* loops = */ 1);
+        m_exploding_sprite->set_action(SKID_ACTION, /* loops = */ 1);
       }
       else
       {
-        set_action("ticking", m_last_player_direction, /* loops = */ -1);
-        m_exploding_sprite->set_action("run", /* loops = */ -1);
+        set_action(TICKING_ACTION, m_last_player_direction, /* loops = */ -1);
+        m_exploding_sprite->set_action(RUN_ACTION, /* loops = */ -1);
       }
-      walk_left_action = "ticking-left";
-      walk_right_action = "ticking-right";
+      walk_left_action = TICKING_LEFT_ACTION;
+      walk_right_action = TICKING_RIGHT_ACTION;
     }
     else {
-      set_action("active", m_dir, /* loops = */ 1);
-      walk_left_action = "active-left";
-      walk_right_action = "active-right";
+      set_action(ACTIVE_ACTION, m_dir, /* loops = */ 1);
+      walk_left_action = ACTIVE_LEFT_ACTION;
+      walk_right_action = ACTIVE_RIGHT_ACTION;
     }
 
     float target_velocity = 0.f;
@@ -303,8 +318,8 @@ Haywire::start_exploding()
 void
 Haywire::stop_exploding()
 {
-  walk_left_action = "left";
-  walk_right_action = "right";
+  walk_left_action = LEFT_ACTION;
+  walk_right_action = RIGHT_ACTION;
   set_walk_speed(NORMAL_WALK_SPEED);
   set_ledge_behavior(LedgeBehavior::SMART);
   time_until_explosion = 0.0f;
@@ -22,6 +22,12 @@
 #include "math/random.hpp"
 #include "sprite/sprite.hpp"
 
+namespace {
+
+const SoundManager::SoundId STOMP_SOUND = SoundManager::get_sound_id("sounds/stomp.wav");
+
+} // namespace
+
 MoleRock::MoleRock(const ReaderMapping& reader) :
   BadGuy(reader, "images/creatures/mole/mole_rock.sprite", LAYER_TILES - 2),
   parent(nullptr),
@@ -89,7 +95,7 @@ MoleRock::collision_badguy(BadGuy& badguy, const CollisionHit& )
   if (&badguy == parent) {
     return FORCE_MOVE;
   }
-  SoundManager::current()->play("sounds/stomp.wav", get_pos());
+  SoundManager::current()->play(STOMP_SOUND, get_pos());
   remove_me();
   badguy.kill_fall();
   return ABORT_MOVE;
@@ -98,7 +104,7 @@ MoleRock::collision_badguy(BadGuy& badguy, const CollisionHit& )
 HitResponse
 MoleRock::collision_player(Player& player, const CollisionHit& hit)
 {
-  SoundManager::current()->play("sounds/stomp.wav", get_pos());
+  SoundManager::current()->play(STOMP_SOUND, get_pos());
   remove_me();
   return BadGuy::collision_player(player, hit);
 }
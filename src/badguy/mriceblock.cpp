@@ -31,6 +31,8 @@ namespace {
   const float KICKSPEED = 500;
   const int MAXSQUISHES = 10;
   const float NOKICK_TIME = 0.1f;
+  const SoundManager::SoundId STOMP_SOUND = SoundManager::get_sound_id("sounds/stomp.wav");
+  const SoundManager::SoundId KICK_SOUND = SoundManager::get_sound_id("sounds/kick.wav");
 }
 
 MrIceBlock::MrIceBlock(const ReaderMapping& reader, const std::string& sprite_name) :
@@ -283,7 +285,7 @@ MrIceBlock::collision_squished(MovingObject& object)
     }
   }
 
-  SoundManager::current()->play("sounds/stomp.wav", get_pos());
+  SoundManager::current()->play(STOMP_SOUND, get_pos());
   m_physic.set_velocity(0, 0);
   set_state(ICESTATE_FLAT);
   nokick_timer.start(NOKICK_TIME);
@@ -327,12 +329,12 @@ MrIceBlock::set_state(IceState state_)
     flat_timer.start(4);
     break;
   case ICESTATE_KICKED:
-    SoundManager::current()->play("sounds/kick.wav", get_pos());
+    SoundManager::current()->play(KICK_SOUND, get_pos());
 
     m_physic.set_velocity_x(m_dir == Direction::LEFT ? -KICKSPEED : KICKSPEED);
     set_action("flat", m_dir, /* loops = */ -1);
     // We should slide above 1 block holes now.
-    m_col.m_bbox.set_size(34, 31.8f);
+    m_col.set_bbox_size(34, 31.8f);
     break;
   case ICESTATE_GRABBED:
     flat_timer.stop();
@@ -379,7 +381,7 @@ MrIceBlock::ungrab(MovingObject& object, Direction dir_)
   {
     // Move the ice cube slightly away to avoid instantly killing Tux.
     float swimangle = player->get_swimming_angle();
-    m_col.m_bbox.move(Vector(std::cos(swimangle) * 48.f, std::sin(swimangle) * 48.f));
+    m_col.move_bbox(Vector(std::cos(swimangle) * 48.f, std::sin(swimangle) * 48.f));
   }
   if (dir_ == Direction::UP) {
     m_physic.set_velocity_y(-KICKSPEED);
@@ -396,7 +398,7 @@ MrIceBlock::ungrab(MovingObject& object, Direction dir_)
     Vector mov(0, 32);
     if (Sector::get().is_free_of_statics(get_bbox().moved(mov), this)) {
       // There is free space, so throw it down.
-      SoundManager::current()->play("sounds/kick.wav", get_pos());
+      SoundManager::current()->play(KICK_SOUND, get_pos());
       m_physic.set_velocity_y(KICKSPEED);
     }
     set_state(ICESTATE_FLAT);
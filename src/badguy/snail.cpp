@@ -35,6 +35,9 @@ const float SNAIL_KICK_SPEED_Y = -500; /**< Y-velocity gained when kicked. */
 const float SNAIL_GUARD_DELAY = 5.f; /**< Time in-between corrupted snail guard states (seconds). */
 const float SNAIL_GUARD_TIME = 3.f; /**< Duration of corrupted snail guard states (seconds). */
 
+const SoundManager::SoundId STOMP_SOUND = SoundManager::get_sound_id("sounds/stomp.wav");
+const SoundManager::SoundId KICK_SOUND = SoundManager::get_sound_id("sounds/kick.wav");
+
 } // namespace
 
 Snail::Snail(const ReaderMapping& reader) :
@@ -327,7 +330,7 @@ Snail::collision_player(Player& player, const CollisionHit& hit)
     } else if (hit.right) {
       m_dir = Direction::LEFT;
     }
-    SoundManager::current()->play("sounds/kick.wav", get_pos());
+    SoundManager::current()->play(KICK_SOUND, get_pos());
     player.kick();
     be_kicked(false);
     return FORCE_MOVE;
@@ -358,13 +361,13 @@ Snail::collision_squished(MovingObject& object)
         kill_fall();
         return true;
       }
-      SoundManager::current()->play("sounds/stomp.wav", get_pos());
+      SoundManager::current()->play(STOMP_SOUND, get_pos());
       be_flat();
       break;
 
     case STATE_FLAT:
     case STATE_WAKING:
-      SoundManager::current()->play("sounds/kick.wav", get_pos());
+      SoundManager::current()->play(KICK_SOUND, get_pos());
       {
         if (object.get_pos().x < get_pos().x) {
           m_dir = Direction::RIGHT;
@@ -411,7 +414,7 @@ Snail::ungrab(MovingObject& object, Direction dir_)
 
     if (player)
     {
-      SoundManager::current()->play("sounds/kick.wav", get_pos());
+      SoundManager::current()->play(KICK_SOUND, get_pos());
       if (!player->is_swimming() && !player->is_water_jumping())
       {
         switch (dir_)
@@ -442,7 +445,7 @@ Snail::ungrab(MovingObject& object, Direction dir_)
       else
       {
         float swimangle = player->get_swimming_angle();
-        m_col.m_bbox.move(Vector(std::cos(swimangle) * 48.f, std::sin(swimangle) * 48.f));
+        m_col.move_bbox(Vector(std::cos(swimangle) * 48.f, std::sin(swimangle) * 48.f));
         be_kicked(false);
         m_physic.set_velocity(SNAIL_KICK_SPEED * 1.5f * Vector(std::cos(swimangle), std::sin(swimangle)));
         m_dir = m_physic.get_velocity_x() > 0.f ? Direction::RIGHT : Direction::LEFT;
@@ -57,7 +57,7 @@ Stumpy::initialize()
   switch (mystate) {
     case STATE_INVINCIBLE:
       set_action("dizzy", m_dir);
-      m_col.m_bbox.set_size(m_sprite->get_current_hitbox_width(), m_sprite->get_current_hitbox_height());
+      m_col.set_bbox_size(m_sprite->get_current_hitbox_width(), m_sprite->get_current_hitbox_height());
       m_physic.set_velocity_x(0);
       break;
     case STATE_NORMAL:
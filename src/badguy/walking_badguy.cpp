@@ -78,7 +78,7 @@ WalkingBadguy::initialize()
   if (m_frozen)
     return;
   set_action(m_dir == Direction::LEFT ? walk_left_action : walk_right_action);
-  m_col.m_bbox.set_size(m_sprite->get_current_hitbox_width(), m_sprite->get_current_hitbox_height());
+  m_col.set_bbox_size(m_sprite->get_current_hitbox_width(), m_sprite->get_current_hitbox_height());
   m_physic.set_velocity_x(m_dir == Direction::LEFT ? -walk_speed : walk_speed);
   m_physic.set_acceleration_x (0.0);
 }
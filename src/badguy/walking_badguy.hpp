@@ -84,8 +84,8 @@ protected:
   void turn_around();
 
 protected:
-  std::string walk_left_action;
-  std::string walk_right_action;
+  ActionId walk_left_action;
+  ActionId walk_right_action;
   float walk_speed;
   int max_drop_height; /**< Maximum height of drop before we will turn around, or -1 to just drop from any ledge */
   Timer turn_around_timer;
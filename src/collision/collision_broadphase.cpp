@@ -0,0 +1,208 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "collision/collision_broadphase.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "math/rectf.hpp"
+
+namespace {
+
+const uint32_t NO_ENTRY = UINT32_MAX;
+
+// Cell coordinates are clamped, so that objects far outside of any
+// sensible sector can't overflow the integer conversion.
+const float MAX_CELL_COORD = 1 << 20;
+
+int to_cell(float v, float cell_size)
+{
+  return static_cast<int>(std::floor(std::clamp(v / cell_size, -MAX_CELL_COORD, MAX_CELL_COORD)));
+}
+
+} // namespace
+
+CollisionBroadphase::CollisionBroadphase(float cell_size) :
+  m_cell_size(cell_size),
+  m_buckets(),
+  m_entries(),
+  m_ranges(),
+  m_versions(),
+  m_inserted(),
+  m_large(),
+  m_is_large(),
+  m_query_marks(),
+  m_query_mark(0),
+  m_revision(0)
+{
+}
+
+void
+CollisionBroadphase::reset(size_t count)
+{
+  size_t bucket_count = 64;
+  while (bucket_count < count * 2)
+    bucket_count *= 2;
+
+  m_buckets.assign(bucket_count, NO_ENTRY);
+  m_entries.clear();
+  m_ranges.assign(count, CellRange{0, 0, -1, -1});
+  m_versions.assign(count, 0);
+  m_inserted.assign(count, false);
+  m_large.clear();
+  m_is_large.assign(count, false);
+  m_query_marks.assign(count, 0);
+  m_query_mark = 0;
+  ++m_revision;
+}
+
+CollisionBroadphase::CellRange
+CollisionBroadphase::get_cell_range(const Rectf& rect) const
+{
+  // Rectangles with a negative size can still overlap others, so cover
+  // the whole span between both edges.
+  const float left = std::min(rect.get_left(), rect.get_right());
+  const float right = std::max(rect.get_left(), rect.get_right());
+  const float top = std::min(rect.get_top(), rect.get_bottom());
+  const float bottom = std::max(rect.get_top(), rect.get_bottom());
+
+  return CellRange{to_cell(left, m_cell_size), to_cell(top, m_cell_size),
+                   to_cell(right, m_cell_size), to_cell(bottom, m_cell_size)};
+}
+
+uint32_t
+CollisionBroadphase::get_bucket(int x, int y) const
+{
+  const uint32_t hash = (static_cast<uint32_t>(x) * 73856093u) ^ (static_cast<uint32_t>(y) * 19349663u);
+  return hash & static_cast<uint32_t>(m_buckets.size() - 1);
+}
+
+bool
+CollisionBroadphase::is_large(const CellRange& range) const
+{
+  const int64_t width = static_cast<int64_t>(range.right) - range.left + 1;
+  const int64_t height = static_cast<int64_t>(range.bottom) - range.top + 1;
+  return width * height > MAX_CELLS_PER_ENTRY;
+}
+
+void
+CollisionBroadphase::set(size_t index, const Rectf& rect)
+{
+  const bool finite = std::isfinite(rect.get_left()) && std::isfinite(rect.get_top()) &&
+                      std::isfinite(rect.get_right()) && std::isfinite(rect.get_bottom());
+  const CellRange range = finite ? get_cell_range(rect) : CellRange{0, 0, -1, -1};
+
+  if (m_inserted[index] && finite && !m_is_large[index] && range == m_ranges[index])
+    return;
+
+  ++m_revision;
+
+  // Entries of the previous position stay in their buckets and get
+  // skipped by queries once the version doesn't match anymore.
+  ++m_versions[index];
+  m_inserted[index] = true;
+  m_ranges[index] = range;
+
+  if (!finite || is_large(range))
+  {
+    if (!m_is_large[index])
+    {
+      m_is_large[index] = true;
+      m_large.push_back(index);
+    }
+    return;
+  }
+
+  if (m_is_large[index])
+  {
+    m_is_large[index] = false;
+    m_large.erase(std::find(m_large.begin(), m_large.end(), index));
+  }
+
+  for (int y = range.top; y <= range.bottom; ++y)
+  {
+    for (int x = range.left; x <= range.right; ++x)
+    {
+      const uint32_t bucket = get_bucket(x, y);
+      m_entries.push_back(Entry{index, m_versions[index], m_buckets[bucket]});
+      m_buckets[bucket] = static_cast<uint32_t>(m_entries.size() - 1);
+    }
+  }
+}
+
+void
+CollisionBroadphase::add_index(size_t index, std::vector<size_t>& result)
+{
+  if (m_query_marks[index] == m_query_mark)
+    return;
+
+  m_query_marks[index] = m_query_mark;
+  result.push_back(index);
+}
+
+void
+CollisionBroadphase::query(const Rectf& rect, std::vector<size_t>& result)
+{
+  result.clear();
+
+  if (++m_query_mark == 0)
+  {
+    std::fill(m_query_marks.begin(), m_query_marks.end(), 0);
+    m_query_mark = 1;
+  }
+
+  for (const size_t index : m_large)
+    add_index(index, result);
+
+  const bool finite = std::isfinite(rect.get_left()) && std::isfinite(rect.get_top()) &&
+                      std::isfinite(rect.get_right()) && std::isfinite(rect.get_bottom());
+  const CellRange range = finite ? get_cell_range(rect) : CellRange{0, 0, -1, -1};
+
+  if (!finite || is_large(range))
+  {
+    // Walking all the cells would be slower than just returning everything.
+    for (size_t index = 0; index < m_ranges.size(); ++index)
+      if (m_inserted[index])
+        add_index(index, result);
+  }
+  else
+  {
+    for (int y = range.top; y <= range.bottom; ++y)
+    {
+      for (int x = range.left; x <= range.right; ++x)
+      {
+        for (uint32_t e = m_buckets[get_bucket(x, y)]; e != NO_ENTRY; e = m_entries[e].next)
+        {
+          const Entry& entry = m_entries[e];
+          if (entry.version != m_versions[entry.index])
+            continue;
+
+          // Buckets are shared between cells, only report entries that
+          // really cover the cell.
+          const CellRange& entry_range = m_ranges[entry.index];
+          if (x < entry_range.left || x > entry_range.right ||
+              y < entry_range.top || y > entry_range.bottom)
+            continue;
+
+          add_index(entry.index, result);
+        }
+      }
+    }
+  }
+
+  std::sort(result.begin(), result.end());
+}
@@ -0,0 +1,111 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+class Rectf;
+
+/**
+ * Uniform-grid spatial hash used as a broadphase by the CollisionSystem.
+ *
+ * Entries are identified by their index, queries return the indices of
+ * all entries whose rectangle may overlap the query rectangle, in
+ * ascending order. The result is a superset of the overlapping entries,
+ * callers still have to do the exact overlap test.
+ */
+class CollisionBroadphase final
+{
+private:
+  struct CellRange
+  {
+    int left;
+    int top;
+    int right;
+    int bottom;
+
+    bool operator==(const CellRange& other) const
+    {
+      return left == other.left && top == other.top &&
+             right == other.right && bottom == other.bottom;
+    }
+  };
+
+  struct Entry
+  {
+    size_t index;
+    uint32_t version;
+    uint32_t next;
+  };
+
+public:
+  /** Entries covering more cells than this are always returned by queries. */
+  static const int MAX_CELLS_PER_ENTRY = 64;
+
+public:
+  CollisionBroadphase(float cell_size = 128.0f);
+
+  /** Drops all entries and prepares the grid for @c count indices. */
+  void reset(size_t count);
+
+  /** Inserts the entry at @c index, or moves it if it was already inserted. */
+  void set(size_t index, const Rectf& rect);
+
+  /** Fills @c result with the sorted indices of all entries that may
+      overlap @c rect. */
+  void query(const Rectf& rect, std::vector<size_t>& result);
+
+  /** Increases whenever an entry was inserted or moved to other cells,
+      used to detect changes to the grid while iterating over query results. */
+  inline uint32_t get_revision() const { return m_revision; }
+
+  inline size_t get_size() const { return m_ranges.size(); }
+
+private:
+  CellRange get_cell_range(const Rectf& rect) const;
+  uint32_t get_bucket(int x, int y) const;
+  bool is_large(const CellRange& range) const;
+  void add_index(size_t index, std::vector<size_t>& result);
+
+private:
+  float m_cell_size;
+
+  /** First entry of each bucket, the bucket count is a power of two. */
+  std::vector<uint32_t> m_buckets;
+  std::vector<Entry> m_entries;
+
+  /** Per-index state, entries whose version doesn't match are stale. */
+  std::vector<CellRange> m_ranges;
+  std::vector<uint32_t> m_versions;
+  std::vector<bool> m_inserted;
+
+  /** Indices that are too large (or not finite) to be put into cells. */
+  std::vector<size_t> m_large;
+  std::vector<bool> m_is_large;
+
+  /** Used to filter out duplicates while collecting query results. */
+  std::vector<uint32_t> m_query_marks;
+  uint32_t m_query_mark;
+
+  uint32_t m_revision;
+
+private:
+  CollisionBroadphase(const CollisionBroadphase&) = delete;
+  CollisionBroadphase& operator=(const CollisionBroadphase&) = delete;
+};
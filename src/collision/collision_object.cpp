@@ -17,7 +17,10 @@
 
 #include "collision/collision_object.hpp"
 
+#include <algorithm>
+
 #include "collision/collision_movement_manager.hpp"
+#include "collision/collision_system.hpp"
 #include "supertux/moving_object.hpp"
 
 CollisionObject::CollisionObject(CollisionGroup group, MovingObject& parent) :
@@ -29,7 +32,11 @@ CollisionObject::CollisionObject(CollisionGroup group, MovingObject& parent) :
   m_unisolid(false),
   m_pressure(),
   m_objects_hit_bottom(),
-  m_ground_movement_manager(nullptr)
+  m_removal_listeners(),
+  m_tilemap_removal_listeners(),
+  m_ground_movement_manager(nullptr),
+  m_collision_system(nullptr),
+  m_index(0)
 {
 }
 
@@ -63,7 +70,8 @@ CollisionObject::collision_moving_object_bottom(CollisionObject& other)
   if (m_group == COLGROUP_STATIC
     || m_group == COLGROUP_MOVING_STATIC)
   {
-    m_objects_hit_bottom.insert(&other);
+    if (m_objects_hit_bottom.insert(&other).second)
+      other.m_removal_listeners.push_back(this);
   }
 }
 
@@ -73,9 +81,29 @@ CollisionObject::notify_object_removal(CollisionObject* other)
   m_objects_hit_bottom.erase(other);
 }
 
+void
+CollisionObject::add_tilemap_removal_listener(TileMap* tilemap)
+{
+  m_tilemap_removal_listeners.push_back(tilemap);
+}
+
+void
+CollisionObject::del_tilemap_removal_listener(TileMap* tilemap)
+{
+  m_tilemap_removal_listeners.erase(std::remove(m_tilemap_removal_listeners.begin(),
+                                                m_tilemap_removal_listeners.end(),
+                                                tilemap),
+                                    m_tilemap_removal_listeners.end());
+}
+
 void
 CollisionObject::clear_bottom_collision_list()
 {
+  for (CollisionObject* other_object : m_objects_hit_bottom) {
+    auto& listeners = other_object->m_removal_listeners;
+    listeners.erase(std::remove(listeners.begin(), listeners.end(), this),
+                    listeners.end());
+  }
   m_objects_hit_bottom.clear();
 }
 
@@ -89,6 +117,13 @@ CollisionObject::propagate_movement(const Vector& movement)
   }
 }
 
+void
+CollisionObject::rect_changed()
+{
+  if (m_collision_system)
+    m_collision_system->object_moved(*this);
+}
+
 bool
 CollisionObject::is_valid() const
 {
@@ -20,13 +20,16 @@
 #include <stdint.h>
 #include <memory>
 #include <unordered_set>
+#include <vector>
 
 #include "collision/collision_group.hpp"
 #include "collision/collision_hit.hpp"
 #include "math/rectf.hpp"
 
 class CollisionGroundMovementManager;
+class CollisionSystem;
 class MovingObject;
+class TileMap;
 
 class CollisionObject
 {
@@ -54,6 +57,11 @@ public:
 
   void notify_object_removal(CollisionObject* other);
 
+  /** Registers a tilemap that has this object in its list of objects
+      touching its top, so it gets notified when this object is removed */
+  void add_tilemap_removal_listener(TileMap* tilemap);
+  void del_tilemap_removal_listener(TileMap* tilemap);
+
   inline void set_ground_movement_manager(const std::shared_ptr<CollisionGroundMovementManager>& movement_manager)
   {
     m_ground_movement_manager = movement_manager;
@@ -89,6 +97,7 @@ public:
   {
     m_dest.move(pos - get_pos());
     m_bbox.set_pos(pos);
+    rect_changed();
   }
 
   inline Vector get_pos() const
@@ -116,6 +125,7 @@ public:
   {
     m_dest.set_width(w);
     m_bbox.set_width(w);
+    rect_changed();
   }
 
   /** sets the moving object's bbox to a specific size. Be careful
@@ -125,6 +135,40 @@ public:
   {
     m_dest.set_size(w, h);
     m_bbox.set_size(w, h);
+    rect_changed();
+  }
+
+  /** The following functions only change the bounding box, not the
+      anticipated destination. Use them instead of modifying m_bbox
+      directly, so the spatial index of the CollisionSystem stays valid. */
+  void move_bbox(const Vector& dist)
+  {
+    m_bbox.move(dist);
+    rect_changed();
+  }
+
+  void set_bbox_pos(const Vector& pos)
+  {
+    m_bbox.set_pos(pos);
+    rect_changed();
+  }
+
+  void set_bbox_width(float w)
+  {
+    m_bbox.set_width(w);
+    rect_changed();
+  }
+
+  void set_bbox_height(float h)
+  {
+    m_bbox.set_height(h);
+    rect_changed();
+  }
+
+  void set_bbox_size(float w, float h)
+  {
+    m_bbox.set_size(w, h);
+    rect_changed();
   }
 
   inline CollisionGroup get_group() const
@@ -136,12 +180,18 @@ public:
 
   inline MovingObject& get_parent() { return m_parent; }
 
+private:
+  /** Keeps the spatial indices of the CollisionSystem in sync after
+      m_bbox or m_dest have been changed. */
+  void rect_changed();
+
 private:
   MovingObject& m_parent;
 
 public:
   /** The bounding box of the object (as used for collision detection,
-      this isn't necessarily the bounding box for graphics) */
+      this isn't necessarily the bounding box for graphics).
+      Only modify it through the setters above. */
   Rectf m_bbox;
 
   /** The collision group */
@@ -173,8 +223,20 @@ private:
       if this object was static or moving static. */
   std::unordered_set<CollisionObject*> m_objects_hit_bottom;
 
+  /** Objects and tilemaps that have this object in their list of
+      objects touching their top. Only those need to be notified when
+      this object gets removed. */
+  std::vector<CollisionObject*> m_removal_listeners;
+  std::vector<TileMap*> m_tilemap_removal_listeners;
+
   std::shared_ptr<CollisionGroundMovementManager> m_ground_movement_manager;
 
+  /** The CollisionSystem this object has been added to */
+  CollisionSystem* m_collision_system;
+
+  /** Position of this object in the CollisionSystem */
+  size_t m_index;
+
 private:
   CollisionObject(const CollisionObject&) = delete;
   CollisionObject& operator=(const CollisionObject&) = delete;
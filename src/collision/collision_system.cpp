@@ -17,6 +17,11 @@
 
 #include "collision/collision_system.hpp"
 
+#include <algorithm>
+#include <assert.h>
+#include <cmath>
+#include <ostream>
+
 #include "collision/collision.hpp"
 #include "collision/collision_movement_manager.hpp"
 #include "editor/editor.hpp"
@@ -33,36 +38,143 @@
 namespace
 {
   const float MAX_SPEED = 16.0f;
+
+  // Margin added to broadphase queries, large enough to cover the
+  // EPSILON growing done by the narrow phase and any rounding.
+  const float BROADPHASE_MARGIN = 1.0f;
+
+  Rectf get_search_rect(const Rectf& rect)
+  {
+    // The broadphase returns all objects for rectangles that aren't
+    // finite, so there is nothing to grow.
+    if (!std::isfinite(rect.get_left()) || !std::isfinite(rect.get_right()) ||
+        !std::isfinite(rect.get_top()) || !std::isfinite(rect.get_bottom()))
+      return rect;
+
+    return Rectf(std::min(rect.get_left(), rect.get_right()) - BROADPHASE_MARGIN,
+                 std::min(rect.get_top(), rect.get_bottom()) - BROADPHASE_MARGIN,
+                 std::max(rect.get_left(), rect.get_right()) + BROADPHASE_MARGIN,
+                 std::max(rect.get_top(), rect.get_bottom()) + BROADPHASE_MARGIN);
+  }
 } // namespace
 
 CollisionSystem::CollisionSystem(Sector& sector) :
   m_sector(sector),
   m_objects(),
+  m_broadphase(),
+  m_broadphase_active(false),
+  m_candidates(),
+  m_query_index(),
+  m_query_index_valid(false),
+  m_query_candidates(),
+  m_query_stats(),
   m_ground_movement_manager(new CollisionGroundMovementManager)
 {
 }
 
+CollisionSystem::~CollisionSystem()
+{
+  for (auto* object : m_objects) {
+    object->m_collision_system = nullptr;
+  }
+}
+
 void
 CollisionSystem::add(CollisionObject* object)
 {
   object->set_ground_movement_manager(m_ground_movement_manager);
+  object->m_collision_system = this;
+  object->m_index = m_objects.size();
   m_objects.push_back(object);
+  m_query_index_valid = false;
 }
 
 void
 CollisionSystem::remove(CollisionObject* object)
 {
-  m_objects.erase(
-    std::find(m_objects.begin(), m_objects.end(),
-      object));
+  assert(object->m_index < m_objects.size() && m_objects[object->m_index] == object);
+
+  // Move the last object into the free slot, so that nothing has to be shifted.
+  const size_t index = object->m_index;
+  m_objects[index] = m_objects.back();
+  m_objects[index]->m_index = index;
+  m_objects.pop_back();
 
-  // FIXME: This is a patch. A better way of fixing this is coming.
-  for (auto* collision_object : m_objects) {
+  object->m_collision_system = nullptr;
+  m_query_index_valid = false;
+
+  // Only the objects and tilemaps the removed object has been standing
+  // on hold a reference to it.
+  for (auto* collision_object : object->m_removal_listeners) {
     collision_object->notify_object_removal(object);
   }
-  for (auto* tilemap : m_sector.get_solid_tilemaps()) {
+  object->m_removal_listeners.clear();
+
+  for (auto* tilemap : object->m_tilemap_removal_listeners) {
     tilemap->notify_object_removal(object);
   }
+  object->m_tilemap_removal_listeners.clear();
+
+  // Unsubscribe from the objects standing on top of the removed one.
+  object->clear_bottom_collision_list();
+}
+
+void
+CollisionSystem::object_moved(CollisionObject& object)
+{
+  if (m_broadphase_active)
+    m_broadphase.set(object.m_index, object.m_dest);
+
+  if (m_query_index_valid)
+    m_query_index.set(object.m_index, object.m_bbox);
+}
+
+const std::vector<size_t>&
+CollisionSystem::query_objects(QueryType type, const Rectf& rect) const
+{
+  // The editor changes bounding boxes without going through
+  // CollisionObject, so the index can't be trusted there.
+  if (!m_query_index_valid || Editor::is_active())
+  {
+    m_query_index.reset(m_objects.size());
+    for (const auto* object : m_objects) {
+      m_query_index.set(object->m_index, object->m_bbox);
+    }
+    m_query_index_valid = true;
+  }
+
+  m_query_index.query(get_search_rect(rect), m_query_candidates);
+
+  QueryStats& stats = m_query_stats[type];
+  stats.calls += 1;
+  stats.candidates += m_query_candidates.size();
+
+  return m_query_candidates;
+}
+
+void
+CollisionSystem::debug_print(std::ostream& out) const
+{
+  static const char* names[QUERY_COUNT] = {
+    "is_free_of_statics",
+    "is_free_of_movingstatics",
+    "is_free_of_specifically_movingstatics",
+    "get_first_line_intersection",
+    "get_nearby_objects"
+  };
+
+  out << "collision queries:begin" << std::endl;
+  for (int i = 0; i < QUERY_COUNT; ++i)
+  {
+    const QueryStats& stats = m_query_stats[i];
+    out << "  " << names[i]
+        << " calls:" << stats.calls
+        << " candidates:" << stats.candidates
+        << " candidates_per_call:" << (stats.calls ? stats.candidates / stats.calls : 0)
+        << std::endl;
+  }
+  out << "collision queries:end" << std::endl;
+  out << "objects: " << m_objects.size() << std::endl;
 }
 
 void
@@ -222,6 +334,36 @@ namespace {
 
 } // namespace
 
+template<typename RectFunc, typename Func>
+void
+CollisionSystem::for_each_candidate(std::vector<size_t>& candidates, size_t first,
+                                    const RectFunc& get_rect, const Func& func)
+{
+  Rectf rect = get_rect();
+  uint32_t revision = m_broadphase.get_revision();
+  m_broadphase.query(rect, candidates);
+
+  auto it = std::lower_bound(candidates.begin(), candidates.end(), first);
+  while (it != candidates.end())
+  {
+    const size_t index = *it;
+    func(*m_objects[index]);
+
+    const Rectf new_rect = get_rect();
+    if (revision != m_broadphase.get_revision() || !(new_rect == rect))
+    {
+      rect = new_rect;
+      revision = m_broadphase.get_revision();
+      m_broadphase.query(rect, candidates);
+      it = std::upper_bound(candidates.begin(), candidates.end(), index);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
 void
 CollisionSystem::collision_tilemap(collision::Constraints* constraints,
   const Vector& movement, const Rectf& dest,
@@ -236,7 +378,15 @@ CollisionSystem::collision_tilemap(collision::Constraints* constraints,
   for (auto* solids : m_sector.get_solid_tilemaps())
   {
     // Test with all tiles in this rectangle.
-    const Rect test_tiles = solids->get_tiles_overlapping(Rectf(x1, y1, x2, y2));
+    Rect test_tiles = solids->get_tiles_overlapping(Rectf(x1, y1, x2, y2));
+
+    // Skip rows without any solid tiles at the top and bottom.
+    while (test_tiles.top < test_tiles.bottom &&
+           !solids->has_solid_cells(test_tiles.top, test_tiles.left, test_tiles.right))
+      ++test_tiles.top;
+    while (test_tiles.top < test_tiles.bottom &&
+           !solids->has_solid_cells(test_tiles.bottom - 1, test_tiles.left, test_tiles.right))
+      --test_tiles.bottom;
 
     bool hits_bottom = false;
 
@@ -244,11 +394,10 @@ CollisionSystem::collision_tilemap(collision::Constraints* constraints,
     {
       for (int y = test_tiles.top; y < test_tiles.bottom; ++y)
       {
-        const Tile& tile = solids->get_tile(x, y);
-
         // Skip non-solid tiles.
-        if (tile.is_solid())
+        if (solids->get_cell_attributes(x, y) & TileMap::CELL_SOLID)
         {
+          const Tile& tile = solids->get_tile(x, y);
           Rectf tile_bbox = solids->get_tile_bbox(x, y);
           bool is_relatively_solid = true;
 
@@ -310,16 +459,27 @@ CollisionSystem::collision_tile_attributes(const Rectf& dest, const Vector& mov)
     // For ice (only), add a little fudge to recognize tiles Tux is standing on.
     const Rect test_tiles_ice = solids->get_tiles_overlapping(Rectf(x1, y1, x2, y2 + SHIFT_DELTA));
 
+    // Skip rows without any tile attributes at the top.
+    int top = test_tiles.top;
+    while (top < test_tiles_ice.bottom &&
+           !solids->has_attribute_cells(top, test_tiles.left, test_tiles.right))
+      ++top;
+
     for (int x = test_tiles.left; x < test_tiles.right; ++x) {
       int y;
-      for (y = test_tiles.top; y < test_tiles.bottom; ++y) {
-        const Tile& tile = solids->get_tile(x, y);
+      for (y = top; y < test_tiles.bottom; ++y) {
+        if (!solids->get_cell_attributes(x, y))
+          continue;
 
+        const Tile& tile = solids->get_tile(x, y);
         if (tile.is_collisionful(solids->get_tile_bbox(x, y), dest, mov)) {
           result |= tile.get_attributes();
         }
       }
       for (; y < test_tiles_ice.bottom; ++y) {
+        if (!(solids->get_cell_attributes(x, y) & TileMap::CELL_ICE))
+          continue;
+
         const Tile& tile = solids->get_tile(x, y);
         if (tile.is_collisionful(solids->get_tile_bbox(x, y), dest, mov)) {
           result |= (tile.get_attributes() & Tile::ICE);
@@ -434,27 +594,29 @@ CollisionSystem::collision_static(collision::Constraints* constraints,
   collision_tilemap(constraints, movement, dest, object);
 
   // Collision with other (static) objects.
-  for (auto* static_object : m_objects)
-  {
-    if ((
-      static_object->get_group() == COLGROUP_STATIC ||
-      static_object->get_group() == COLGROUP_MOVING_STATIC
-      ) &&
-      static_object->is_valid() &&
-      static_object != &object)
+  for_each_candidate(m_candidates, 0,
+    [&dest]() { return get_search_rect(dest); },
+    [&](CollisionObject& static_object)
     {
+      if ((
+        static_object.get_group() == COLGROUP_STATIC ||
+        static_object.get_group() == COLGROUP_MOVING_STATIC
+        ) &&
+        static_object.is_valid() &&
+        &static_object != &object)
+      {
 
-      collision::Constraints new_constraints = check_collisions(
-        movement, dest, static_object->m_dest, &object, static_object);
+        collision::Constraints new_constraints = check_collisions(
+          movement, dest, static_object.m_dest, &object, &static_object);
 
-      if (new_constraints.hit.bottom)
-        static_object->collision_moving_object_bottom(object);
-      else if (new_constraints.hit.top)
-        object.collision_moving_object_bottom(*static_object);
+        if (new_constraints.hit.bottom)
+          static_object.collision_moving_object_bottom(object);
+        else if (new_constraints.hit.top)
+          object.collision_moving_object_bottom(static_object);
 
-      constraints->merge_constraints(new_constraints);
-    }
-  }
+        constraints->merge_constraints(new_constraints);
+      }
+    });
 }
 
 void
@@ -607,6 +769,12 @@ CollisionSystem::update()
     object->clear_bottom_collision_list();
   }
 
+  m_broadphase.reset(m_objects.size());
+  for (const auto* object : m_objects) {
+    m_broadphase.set(object->m_index, object->m_dest);
+  }
+  m_broadphase_active = true;
+
   // Part 1: COLGROUP_MOVING vs COLGROUP_STATIC and tilemap.
   for (const auto& object : m_objects) {
     if ((object->get_group() != COLGROUP_MOVING
@@ -616,6 +784,7 @@ CollisionSystem::update()
       continue;
 
     collision_static_constrains(*object);
+    m_broadphase.set(object->m_index, object->m_dest);
   }
 
   // Part 2: COLGROUP_MOVING vs tile attributes.
@@ -640,24 +809,27 @@ CollisionSystem::update()
       || !object->is_valid())
       continue;
 
-    for (auto& object_2 : m_objects) {
-      if (object_2->get_group() != COLGROUP_TOUCHABLE
-        || !object_2->is_valid())
-        continue;
-
-      if (object->m_dest.overlaps(object_2->m_dest)) {
-        Vector normal(0.0f, 0.0f);
-        CollisionHit hit;
-        get_hit_normal(object, object_2, hit, normal);
-        if (!object->collides(*object_2, hit))
-          continue;
-        if (!object_2->collides(*object, hit))
-          continue;
-
-        object->collision(*object_2, hit);
-        object_2->collision(*object, hit);
-      }
-    }
+    for_each_candidate(m_candidates, 0,
+      [object]() { return get_search_rect(object->m_dest); },
+      [this, object](CollisionObject& object_2)
+      {
+        if (object_2.get_group() != COLGROUP_TOUCHABLE
+          || !object_2.is_valid())
+          return;
+
+        if (object->m_dest.overlaps(object_2.m_dest)) {
+          Vector normal(0.0f, 0.0f);
+          CollisionHit hit;
+          get_hit_normal(object, &object_2, hit, normal);
+          if (!object->collides(object_2, hit))
+            return;
+          if (!object_2.collides(*object, hit))
+            return;
+
+          object->collision(object_2, hit);
+          object_2.collision(*object, hit);
+        }
+      });
   }
 
   // Part 3: COLGROUP_MOVING vs COLGROUP_MOVING.
@@ -670,22 +842,29 @@ CollisionSystem::update()
         object->get_group() != COLGROUP_MOVING_STATIC))
       continue;
 
-    for (auto i2 = i + 1; i2 != m_objects.end(); ++i2) {
-      auto object_2 = *i2;
-      if ((object_2->get_group() != COLGROUP_MOVING
-        && object_2->get_group() != COLGROUP_MOVING_STATIC)
-        || !object_2->is_valid())
-        continue;
-
-      collision_object(object, object_2);
-    }
+    for_each_candidate(m_candidates, object->m_index + 1,
+      [object]() { return get_search_rect(object->m_dest); },
+      [this, object](CollisionObject& object_2)
+      {
+        if ((object_2.get_group() != COLGROUP_MOVING
+          && object_2.get_group() != COLGROUP_MOVING_STATIC)
+          || !object_2.is_valid())
+          return;
+
+        collision_object(object, &object_2);
+        m_broadphase.set(object->m_index, object->m_dest);
+        m_broadphase.set(object_2.m_index, object_2.m_dest);
+      });
   }
 
+  m_broadphase_active = false;
+
   // Apply object movement.
   for (auto* object : m_objects) {
     object->m_bbox = object->m_dest;
     object->m_movement = Vector(0, 0);
   }
+  m_query_index_valid = false;
 }
 
 bool
@@ -697,8 +876,14 @@ CollisionSystem::is_free_of_tiles(const Rectf& rect, const bool ignoreUnisolid,
     // Test with all tiles in this rectangle.
     const Rect test_tiles = solids->get_tiles_overlapping(rect);
 
-    for (int x = test_tiles.left; x < test_tiles.right; ++x) {
-      for (int y = test_tiles.top; y < test_tiles.bottom; ++y) {
+    for (int y = test_tiles.top; y < test_tiles.bottom; ++y) {
+      if (!solids->has_attribute_cells(y, test_tiles.left, test_tiles.right))
+        continue;
+
+      for (int x = test_tiles.left; x < test_tiles.right; ++x) {
+        if (!solids->get_cell_attributes(x, y))
+          continue;
+
         const Tile& tile = solids->get_tile(x, y);
 
         if (!(tile.get_attributes() & tiletype))
@@ -729,7 +914,8 @@ CollisionSystem::is_free_of_statics(const Rectf& rect, const CollisionObject* ig
 
   if (!is_free_of_tiles(rect, ignoreUnisolid, tiletype)) return false;
 
-  for (const auto& object : m_objects) {
+  for (const size_t index : query_objects(QUERY_FREE_OF_STATICS, rect)) {
+    const auto* object = m_objects[index];
     if (object == ignore_object) continue;
     if (!object->is_valid()) continue;
     if (object->get_group() == COLGROUP_STATIC) {
@@ -747,7 +933,8 @@ CollisionSystem::is_free_of_movingstatics(const Rectf& rect, const CollisionObje
 
   if (!is_free_of_tiles(rect, ignore_unisolid)) return false;
 
-  for (const auto& object : m_objects) {
+  for (const size_t index : query_objects(QUERY_FREE_OF_MOVINGSTATICS, rect)) {
+    const auto* object = m_objects[index];
     if (object == ignore_object) continue;
     if (!object->is_valid()) continue;
     if (object->is_unisolid() && ignore_unisolid) continue;
@@ -766,7 +953,8 @@ CollisionSystem::is_free_of_specifically_movingstatics(const Rectf& rect, const
 {
   using namespace collision;
 
-  for (const auto& object : m_objects) {
+  for (const size_t index : query_objects(QUERY_FREE_OF_SPECIFICALLY_MOVINGSTATICS, rect)) {
+    const auto* object = m_objects[index];
     if (object == ignore_object) continue;
     if (!object->is_valid()) continue;
     if ((object->get_group() == COLGROUP_MOVING_STATIC)
@@ -825,7 +1013,9 @@ finish_tiles:
   RaycastResult objresult;
 
   // Check if no object is in the way.
-  for (const auto& object : m_objects) {
+  const Rectf line_rect(line_start, Sizef(line_end.x - line_start.x, line_end.y - line_start.y));
+  for (const size_t index : query_objects(QUERY_LINE_INTERSECTION, line_rect)) {
+    auto* object = m_objects[index];
     if (object == ignore_object) continue;
     if (!object->is_valid()) continue;
     if ((object->get_group() == COLGROUP_MOVING)
@@ -873,7 +1063,12 @@ CollisionSystem::get_nearby_objects(const Vector& center, float max_distance) co
 {
   std::vector<CollisionObject*> ret;
 
-  for (const auto& object : m_objects) {
+  // Objects are near when the middle of their bounding box is, which
+  // always lies inside of the bounding box.
+  const Rectf search_rect(center - Vector(max_distance, max_distance),
+                          Sizef(max_distance * 2.0f, max_distance * 2.0f));
+  for (const size_t index : query_objects(QUERY_NEARBY_OBJECTS, search_rect)) {
+    auto* object = m_objects[index];
     float distance = object->get_bbox().distance(center);
     if (distance <= max_distance)
       ret.push_back(object);
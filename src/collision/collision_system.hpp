@@ -17,12 +17,15 @@
 
 #pragma once
 
+#include <array>
+#include <iosfwd>
 #include <vector>
 #include <memory>
 #include <variant>
 #include <stdint.h>
 
 #include "collision/collision.hpp"
+#include "collision/collision_broadphase.hpp"
 #include "supertux/tile.hpp"
 #include "math/fwd.hpp"
 
@@ -34,6 +37,8 @@ class Sector;
 
 class CollisionSystem final
 {
+  friend class CollisionObject;
+
 public:
   struct RaycastResult
   {
@@ -42,8 +47,25 @@ public:
     Rectf box = {}; /**< hitbox of tile/object */
   };
 
+private:
+  enum QueryType {
+    QUERY_FREE_OF_STATICS,
+    QUERY_FREE_OF_MOVINGSTATICS,
+    QUERY_FREE_OF_SPECIFICALLY_MOVINGSTATICS,
+    QUERY_LINE_INTERSECTION,
+    QUERY_NEARBY_OBJECTS,
+    QUERY_COUNT
+  };
+
+  struct QueryStats
+  {
+    uint64_t calls = 0; /**< number of times the query was run */
+    uint64_t candidates = 0; /**< objects returned by the spatial index */
+  };
+
 public:
   CollisionSystem(Sector& sector);
+  ~CollisionSystem();
 
   void add(CollisionObject* object);
   void remove(CollisionObject* object);
@@ -80,6 +102,10 @@ public:
 
   std::vector<CollisionObject*> get_nearby_objects(const Vector& center, float max_distance) const;
 
+  /** Print how often the spatial queries above have been used and how
+      many objects they had to look at */
+  void debug_print(std::ostream& out) const;
+
 private:
   /** Does collision detection of an object against all other static
       objects (and the tilemap) in the level. Collision response is
@@ -106,11 +132,42 @@ private:
   void get_hit_normal(const CollisionObject* object1, const CollisionObject* object2,
                       CollisionHit& hit, Vector& normal) const;
 
+  /** Calls @c func for every object after index @c first whose
+      destination may overlap the rectangle returned by @c get_rect, in
+      the same order as they appear in m_objects. If a callback moves
+      objects to other cells of the broadphase, the candidates get
+      queried again, so the result is the same as for a full scan. */
+  template<typename RectFunc, typename Func>
+  void for_each_candidate(std::vector<size_t>& candidates, size_t first,
+                          const RectFunc& get_rect, const Func& func);
+
+  /** Called by CollisionObject when its bounding box or destination changed */
+  void object_moved(CollisionObject& object);
+
+  /** Returns the indices of all objects whose bounding box may overlap
+      @c rect, in m_objects order */
+  const std::vector<size_t>& query_objects(QueryType type, const Rectf& rect) const;
+
 private:
   Sector& m_sector;
 
   std::vector<CollisionObject*>  m_objects;
 
+  /** Spatial index over the destination rectangles of m_objects,
+      rebuilt at the start of update(). */
+  CollisionBroadphase m_broadphase;
+  bool m_broadphase_active;
+
+  std::vector<size_t> m_candidates;
+
+  /** Spatial index over the bounding boxes of m_objects, used by the
+      queries. Rebuilt on the next query after objects have been added,
+      removed or moved by update(). */
+  mutable CollisionBroadphase m_query_index;
+  mutable bool m_query_index_valid;
+  mutable std::vector<size_t> m_query_candidates;
+  mutable std::array<QueryStats, QUERY_COUNT> m_query_stats;
+
   std::shared_ptr<CollisionGroundMovementManager> m_ground_movement_manager;
 
 private:
@@ -46,7 +46,7 @@ AmbientSound::AmbientSound(const ReaderMapping& mapping) :
   mapping.get("y", m_col.m_bbox.get_top(), 0.0f);
   mapping.get("width" , w, 32.0f);
   mapping.get("height", h, 32.0f);
-  m_col.m_bbox.set_size(w, h);
+  m_col.set_bbox_size(w, h);
 
   mapping.get("radius", m_radius, 1.0f);
   mapping.get("sample", m_sample, "");
@@ -67,8 +67,8 @@ AmbientSound::AmbientSound(const Vector& pos, float radius, float vol, const std
 {
   m_col.m_group = COLGROUP_DISABLED;
 
-  m_col.m_bbox.set_pos(pos);
-  m_col.m_bbox.set_size(32, 32);
+  m_col.set_bbox_pos(pos);
+  m_col.set_bbox_size(32, 32);
 
   prepare_sound_source();
 }
@@ -36,6 +36,10 @@ static const float BOUNCY_BRICK_MAX_OFFSET = 8;
 static const float BOUNCY_BRICK_SPEED = 90;
 static const float BUMP_ROTATION_ANGLE = 10;
 
+const std::vector<std::string> Block::s_preload_sounds = {
+  "sounds/upgrade.wav", "sounds/brick.wav"
+};
+
 Block::Block(const Vector& pos, const std::string& sprite_file) :
   MovingSprite(pos, sprite_file, LAYER_OBJECTS + 1),
   m_bouncing(false),
@@ -44,10 +48,10 @@ Block::Block(const Vector& pos, const std::string& sprite_file) :
   m_bounce_offset(0),
   m_original_y(-1)
 {
-  m_col.m_bbox.set_size(32, 32.1f);
+  m_col.set_bbox_size(32, 32.1f);
   set_group(COLGROUP_STATIC);
-  SoundManager::current()->preload("sounds/upgrade.wav");
-  SoundManager::current()->preload("sounds/brick.wav");
+  for (const auto& sound : s_preload_sounds)
+    SoundManager::current()->preload(sound);
 }
 
 Block::Block(const ReaderMapping& mapping, const std::string& sprite_file) :
@@ -58,10 +62,10 @@ Block::Block(const ReaderMapping& mapping, const std::string& sprite_file) :
   m_bounce_offset(0),
   m_original_y(-1)
 {
-  m_col.m_bbox.set_size(32, 32.1f);
+  m_col.set_bbox_size(32, 32.1f);
   set_group(COLGROUP_STATIC);
-  SoundManager::current()->preload("sounds/upgrade.wav");
-  SoundManager::current()->preload("sounds/brick.wav");
+  for (const auto& sound : s_preload_sounds)
+    SoundManager::current()->preload(sound);
 }
 
 HitResponse
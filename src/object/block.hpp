@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "object/moving_sprite.hpp"
 
 class Player;
@@ -29,6 +31,10 @@ public:
   Block(const Vector& pos, const std::string& sprite_file);
   Block(const ReaderMapping& mapping, const std::string& sprite_file);
 
+  /** The sounds that the constructor preloads, AssetPrefetch starts loading
+      them for levels that contain the object. */
+  static const std::vector<std::string> s_preload_sounds;
+
   virtual GameObjectClasses get_class_types() const override { return MovingSprite::get_class_types().add(typeid(Block)); }
 
   virtual HitResponse collision(MovingObject& other, const CollisionHit& hit) override;
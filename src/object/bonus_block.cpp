@@ -57,10 +57,17 @@ std::unique_ptr<MovingObject> to_moving_object(std::unique_ptr<GameObject> objec
   }
 }
 
+const SoundManager::SoundId COIN_SOUND = SoundManager::get_sound_id("sounds/coin.wav");
+const SoundManager::SoundId BRICK_SOUND = SoundManager::get_sound_id("sounds/brick.wav");
+
 const float UPGRADE_SOUND_GAIN = 0.3f;
 
 } // namespace
 
+const std::vector<std::string> BonusBlock::s_light_sounds = {
+  "sounds/switch.ogg"
+};
+
 BonusBlock::BonusBlock(const Vector& pos, int tile_data) :
   Block(pos, "images/objects/bonus_block/bonusblock.sprite"),
   m_contents(),
@@ -138,7 +145,8 @@ BonusBlock::BonusBlock(const ReaderMapping& mapping) :
 
   if (m_contents == Content::LIGHT || m_contents == Content::LIGHT_ON)
   {
-    SoundManager::current()->preload("sounds/switch.ogg");
+    for (const auto& sound : s_light_sounds)
+      SoundManager::current()->preload(sound);
     m_lightsprite = Surface::from_file("/images/objects/lightmap_light/bonusblock_light.png");
     if (m_contents == Content::LIGHT_ON)
       set_action("on");
@@ -337,7 +345,7 @@ BonusBlock::collision(MovingObject& other, const CollisionHit& hit_)
 void
 BonusBlock::try_open(Player* player)
 {
-  SoundManager::current()->play("sounds/brick.wav", get_pos());
+  SoundManager::current()->play(BRICK_SOUND, get_pos());
   if (m_sprite->get_action() == "empty")
     return;
 
@@ -354,7 +362,7 @@ BonusBlock::try_open(Player* player)
     case Content::COIN:
     {
       Sector::get().add<BouncyCoin>(get_pos(), true, m_coin_sprite);
-      SoundManager::current()->play("sounds/coin.wav", get_pos());
+      SoundManager::current()->play(COIN_SOUND, get_pos());
       player->get_status().add_coins(1, false);
       if (m_hit_counter != 0 && !m_parent_dispenser)
         Sector::get().get_level().m_stats.increment_coins();
@@ -491,7 +499,7 @@ BonusBlock::try_open(Player* player)
 void
 BonusBlock::try_drop(Player *player)
 {
-  SoundManager::current()->play("sounds/brick.wav", get_pos());
+  SoundManager::current()->play(BRICK_SOUND, get_pos());
   if (m_sprite->get_action() == "empty")
     return;
 
@@ -754,7 +762,8 @@ BonusBlock::preload_contents(int d)
   {
     case 6: // Light.
     case 15: // Light (On).
-      SoundManager::current()->preload("sounds/switch.ogg");
+      for (const auto& sound : s_light_sounds)
+        SoundManager::current()->preload(sound);
       m_lightsprite=Surface::from_file("/images/objects/lightmap_light/bonusblock_light.png");
       break;
 
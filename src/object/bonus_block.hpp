@@ -56,6 +56,10 @@ public:
   virtual HitResponse collision(MovingObject& other, const CollisionHit& hit) override;
   virtual void draw(DrawingContext& context) override;
 
+  /** The sounds that light contents preload, AssetPrefetch starts
+      loading them for levels that contain bonus blocks. */
+  static const std::vector<std::string> s_light_sounds;
+
   static std::string class_name() { return "bonusblock"; }
   virtual std::string get_class_name() const override { return class_name(); }
   static std::string display_name() { return _("Bonus Block"); }
@@ -53,8 +53,8 @@ Bullet::Bullet(const Vector& pos, const Vector& xm, Direction dir, BonusType typ
       break;
   }
 
-  m_col.m_bbox.set_pos(pos);
-  m_col.m_bbox.set_size(sprite->get_current_hitbox_width(), sprite->get_current_hitbox_height());
+  m_col.set_bbox_pos(pos);
+  m_col.set_bbox_size(sprite->get_current_hitbox_width(), sprite->get_current_hitbox_height());
 }
 
 void
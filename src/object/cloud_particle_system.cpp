@@ -17,6 +17,9 @@
 
 #include "object/cloud_particle_system.hpp"
 
+#include <algorithm>
+#include <utility>
+
 #include <simplesquirrel/class.hpp>
 #include <simplesquirrel/vm.hpp>
 
@@ -35,6 +38,9 @@
 CloudParticleSystem::CloudParticleSystem() :
   ParticleSystem(128),
   cloud_image(Surface::from_file("images/particles/cloud.png")),
+  m_cloud_texture(),
+  m_target_alpha(),
+  m_target_time_remaining(),
   m_current_speed_x(1.f),
   m_target_speed_x(1.f),
   m_speed_fade_time_remaining_x(0.f),
@@ -51,6 +57,9 @@ CloudParticleSystem::CloudParticleSystem() :
 CloudParticleSystem::CloudParticleSystem(const ReaderMapping& reader) :
   ParticleSystem(reader, 128),
   cloud_image(Surface::from_file("images/particles/cloud.png")),
+  m_cloud_texture(),
+  m_target_alpha(),
+  m_target_time_remaining(),
   m_current_speed_x(1.f),
   m_target_speed_x(1.f),
   m_speed_fade_time_remaining_x(0.f),
@@ -74,6 +83,7 @@ void
 CloudParticleSystem::init()
 {
   virtual_width = 2000.f;
+  m_cloud_texture = add_texture(cloud_image);
 
   // Create some random clouds.
   add_clouds(m_current_amount, 0.f);
@@ -143,60 +153,80 @@ CloudParticleSystem::update(float dt_sec)
   auto screen_width = static_cast<float>(SCREEN_WIDTH) / scale;
   auto screen_height = static_cast<float>(SCREEN_HEIGHT) / scale;
 
-  for (auto& particle : particles)
-  {
-    auto cloud_particle = dynamic_cast<CloudParticle*>(particle.get());
-
-    if (!cloud_particle)
-      continue;
+  const size_t count = particles.size();
+  float* x = particles.x.data();
+  float* y = particles.y.data();
+  const float* speed = particles.vx.data();
+  float* alpha = particles.alpha.data();
+  float* target_alpha = m_target_alpha.data();
+  float* target_time_remaining = m_target_time_remaining.data();
 
-    cloud_particle->pos.x += cloud_particle->speed * dt_sec * m_current_speed_x;
-    cloud_particle->pos.y += cloud_particle->speed * dt_sec * m_current_speed_y;
+  for (size_t i = 0; i < count; ++i)
+  {
+    x[i] += speed[i] * dt_sec * m_current_speed_x;
+    y[i] += speed[i] * dt_sec * m_current_speed_y;
+  }
 
-    float texture_height = static_cast<float>(cloud_particle->texture->get_height());
-    float texture_width = static_cast<float>(cloud_particle->texture->get_width());
+  // All clouds share one texture.
+  const float texture_height = static_cast<float>(cloud_image->get_height());
+  const float texture_width = static_cast<float>(cloud_image->get_width());
+  const Vector cam_translation = cam.get_translation();
 
-    while (cloud_particle->pos.x < cam.get_translation().x - texture_width)
-      cloud_particle->pos.x += screen_width + texture_width * 2.f;
+  for (size_t i = 0; i < count; ++i)
+  {
+    while (x[i] < cam_translation.x - texture_width)
+      x[i] += screen_width + texture_width * 2.f;
 
-    while (cloud_particle->pos.x > cam.get_translation().x + screen_width)
-      cloud_particle->pos.x -= screen_width + texture_width * 2.f;
+    while (x[i] > cam_translation.x + screen_width)
+      x[i] -= screen_width + texture_width * 2.f;
 
-    while (cloud_particle->pos.y < cam.get_translation().y - texture_height)
-      cloud_particle->pos.y += screen_height + texture_height * 2.f;
+    while (y[i] < cam_translation.y - texture_height)
+      y[i] += screen_height + texture_height * 2.f;
 
-    while (cloud_particle->pos.y > cam.get_translation().y + screen_height)
-      cloud_particle->pos.y -= screen_height + texture_height * 2.f;
+    while (y[i] > cam_translation.y + screen_height)
+      y[i] -= screen_height + texture_height * 2.f;
+  }
 
-    // Update alpha.
-    if (cloud_particle->target_time_remaining > 0.f)
+  // Update alpha.
+  for (size_t i = 0; i < count; ++i)
+  {
+    if (target_time_remaining[i] > 0.f)
     {
-      if (dt_sec >= cloud_particle->target_time_remaining)
+      if (dt_sec >= target_time_remaining[i])
       {
-        cloud_particle->alpha = cloud_particle->target_alpha;
-        cloud_particle->target_time_remaining = 0.f;
+        alpha[i] = target_alpha[i];
+        target_time_remaining[i] = 0.f;
       }
       else
       {
-        float amount = dt_sec / cloud_particle->target_time_remaining;
-        cloud_particle->alpha += (cloud_particle->target_alpha - cloud_particle->alpha) * amount;
-        cloud_particle->target_time_remaining -= dt_sec;
+        float amount = dt_sec / target_time_remaining[i];
+        alpha[i] += (target_alpha[i] - alpha[i]) * amount;
+        target_time_remaining[i] -= dt_sec;
       }
     }
   }
 
   // Clear dead clouds.
-  // Iterate through the vector backwards to avoid affecting the index of elements
-  // after removal, preventing buggy behavior.
-  for (int i = static_cast<int>(particles.size()) - 1; i >= 0; --i)
+  // Iterate backwards, so that the clouds moved into the place of
+  // removed ones have been looked at already.
+  for (size_t i = particles.size(); i-- > 0;)
   {
-    auto particle = dynamic_cast<CloudParticle*>(particles.at(i).get());
-
-    if (particle->target_alpha == 0.f && particle->target_time_remaining == 0.f)
-      particles.erase(particles.begin() + i);
+    if (m_target_alpha[i] == 0.f && m_target_time_remaining[i] == 0.f)
+      remove_cloud(i);
   }
 }
 
+void
+CloudParticleSystem::remove_cloud(size_t index)
+{
+  particles.remove(index);
+
+  m_target_alpha[index] = m_target_alpha.back();
+  m_target_alpha.pop_back();
+  m_target_time_remaining[index] = m_target_time_remaining.back();
+  m_target_time_remaining.pop_back();
+}
+
 void
 CloudParticleSystem::apply_fog_effect(DrawingContext& context)
 {
@@ -216,20 +246,22 @@ CloudParticleSystem::add_clouds(int amount, float fade_time)
   int target_amount = std::clamp(m_current_real_amount + amount, min_amount, max_amount);
   int amount_to_add = target_amount - m_current_real_amount;
 
-  for (int i = 0; i < amount_to_add; ++i)
+  const size_t old_size = particles.size();
+  const size_t new_size = old_size + std::max(amount_to_add, 0);
+  particles.resize(new_size);
+  m_target_alpha.resize(new_size);
+  m_target_time_remaining.resize(new_size);
+  for (size_t i = old_size; i < new_size; ++i)
   {
-    auto particle = std::make_unique<CloudParticle>();
     // Don't consider the camera, because the Sector might not exist yet
     // Instead, rely on update() to correct this when it will be called.
-    particle->pos.x = graphicsRandom.randf(virtual_width);
-    particle->pos.y = graphicsRandom.randf(virtual_height);
-    particle->texture = cloud_image;
-    particle->speed = -graphicsRandom.randf(25.0, 54.0);
-    particle->alpha = (fade_time == 0.f) ? 1.f : 0.f;
-    particle->target_alpha = 1.f;
-    particle->target_time_remaining = fade_time;
-
-    particles.push_back(std::move(particle));
+    particles.x[i] = graphicsRandom.randf(virtual_width);
+    particles.y[i] = graphicsRandom.randf(virtual_height);
+    particles.texture[i] = m_cloud_texture;
+    particles.vx[i] = -graphicsRandom.randf(25.0, 54.0);
+    particles.alpha[i] = (fade_time == 0.f) ? 1.f : 0.f;
+    m_target_alpha[i] = 1.f;
+    m_target_time_remaining[i] = fade_time;
   }
 
   m_current_real_amount = target_amount;
@@ -243,19 +275,14 @@ CloudParticleSystem::remove_clouds(int amount, float fade_time)
   int amount_to_remove = m_current_real_amount - target_amount;
 
   int i = 0;
-  for (; i < amount_to_remove && i < static_cast<int>(particles.size()); ++i)
+  for (size_t index = 0; i < amount_to_remove && index < particles.size(); ++index)
   {
+    if (m_target_alpha[index] != 1.f || m_target_time_remaining[index] != 0.f) // Invalid particle.
+      continue;
 
-    auto particle = dynamic_cast<CloudParticle*>(particles.at(i).get());
-    if (particle->target_alpha != 1.f || particle->target_time_remaining != 0.f) // Invalid particle.
-    {
-      --i;
-    }
-    else
-    {
-      particle->target_alpha = 0.f;
-      particle->target_time_remaining = fade_time;
-    }
+    m_target_alpha[index] = 0.f;
+    m_target_time_remaining[index] = fade_time;
+    ++i;
   }
 
   return i;
@@ -305,43 +332,38 @@ CloudParticleSystem::draw(DrawingContext& context)
 
   context.push_transform();
 
-  std::unordered_map<SurfacePtr, SurfaceBatch> batches;
-  for (const auto& particle : particles)
+  // Clouds that are fading need a batch of their own for their alpha.
+  SurfaceBatch batch(cloud_image);
+  std::vector<std::pair<SurfacePtr, SurfaceBatch>> fading_batches;
+  for (size_t i = 0; i < particles.size(); ++i)
   {
-
-    if (!region.contains(particle->pos))
+    const Vector pos(particles.x[i], particles.y[i]);
+    if (!region.contains(pos))
       continue;
 
-    if (particle->alpha != 1.f)
+    if (particles.alpha[i] != 1.f)
     {
-      const auto& batch_it = batches.emplace(
-        particle->texture->clone(),
-        SurfaceBatch(
-          particle->texture,
-          Color(1.f, 1.f, 1.f, particle->alpha)
-        ));
-      batch_it.first->second.draw(particle->pos, particle->angle);
+      fading_batches.emplace_back(cloud_image->clone(),
+                                  SurfaceBatch(cloud_image, Color(1.f, 1.f, 1.f, particles.alpha[i])));
+      fading_batches.back().second.draw(pos, particles.angle[i]);
     }
     else
     {
-      auto it = batches.find(particle->texture);
-      if (it == batches.end()) {
-        const auto& batch_it = batches.emplace(particle->texture,
-          SurfaceBatch(particle->texture));
-        batch_it.first->second.draw(particle->pos, particle->angle);
-      }
-      else
-      {
-        it->second.draw(particle->pos, particle->angle);
-      }
+      batch.draw(pos, particles.angle[i]);
     }
   }
 
-  for (auto& it : batches)
+  for (auto& it : fading_batches)
   {
     auto& surface = it.first;
-    auto& batch = it.second;
-    context.color().draw_surface_batch(surface, batch.move_srcrects(),
+    auto& fading_batch = it.second;
+    context.color().draw_surface_batch(surface, fading_batch.move_srcrects(),
+      fading_batch.move_dstrects(), fading_batch.move_angles(), fading_batch.get_color(), z_pos);
+  }
+
+  if (!batch.empty())
+  {
+    context.color().draw_surface_batch(cloud_image, batch.move_srcrects(),
       batch.move_dstrects(), batch.move_angles(), batch.get_color(), z_pos);
   }
 
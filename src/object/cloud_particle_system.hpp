@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "object/particlesystem.hpp"
 
 #include "video/surface_ptr.hpp"
@@ -131,22 +133,17 @@ private:
   /** Applies the fog effect based on the intensity */
   void apply_fog_effect(DrawingContext& context);
 
-private:
-  class CloudParticle : public Particle
-  {
-  public:
-    float speed;
-    float target_alpha;
-    float target_time_remaining;
-
-    CloudParticle() :
-      speed(),
-      target_alpha(),
-      target_time_remaining()
-    {}
-  };
+  /** Removes cloud @c index, moving the last one into its place */
+  void remove_cloud(size_t index);
 
+private:
   SurfacePtr cloud_image;
+  uint8_t m_cloud_texture;
+
+  // Alpha every cloud fades to and the time left to get there, the
+  // ParticleStore holds the speed of the clouds in vx.
+  std::vector<float> m_target_alpha;
+  std::vector<float> m_target_time_remaining;
 
   float m_current_speed_x;
   float m_target_speed_x;
@@ -28,6 +28,16 @@
 #include "util/reader_mapping.hpp"
 #include "util/writer.hpp"
 
+namespace {
+
+const SoundManager::SoundId CLINK_SOUND = SoundManager::get_sound_id("sounds/coin2.ogg");
+
+} // namespace
+
+const std::vector<std::string> Coin::s_preload_sounds = {
+  "sounds/coin.wav"
+};
+
 Coin::Coin(const Vector& pos, bool count_stats, const std::string& sprite_path) :
   MovingSprite(pos, sprite_path, LAYER_OBJECTS - 1, COLGROUP_TOUCHABLE),
   PathObject(),
@@ -39,7 +49,8 @@ Coin::Coin(const Vector& pos, bool count_stats, const std::string& sprite_path)
   m_starting_node(0),
   m_count_stats(count_stats)
 {
-  SoundManager::current()->preload("sounds/coin.wav");
+  for (const auto& sound : s_preload_sounds)
+    SoundManager::current()->preload(sound);
 }
 
 Coin::Coin(const ReaderMapping& reader, bool count_stats) :
@@ -59,7 +70,8 @@ Coin::Coin(const ReaderMapping& reader, bool count_stats) :
   parse_type(reader);
   init_path(reader, true);
 
-  SoundManager::current()->preload("sounds/coin.wav");
+  for (const auto& sound : s_preload_sounds)
+    SoundManager::current()->preload(sound);
 }
 
 GameObjectTypes
@@ -247,6 +259,10 @@ Coin::collision(MovingObject& other, const CollisionHit& )
   return ABORT_MOVE;
 }
 
+const std::vector<std::string> HeavyCoin::s_preload_sounds = {
+  "sounds/coin2.ogg"
+};
+
 /* The following defines a coin subject to gravity. */
 HeavyCoin::HeavyCoin(const Vector& pos, const Vector& init_velocity, bool count_stats, const std::string& sprite_path) :
   Coin(pos, count_stats, sprite_path),
@@ -254,7 +270,8 @@ HeavyCoin::HeavyCoin(const Vector& pos, const Vector& init_velocity, bool count_
   m_last_hit()
 {
   m_physic.enable_gravity(true);
-  SoundManager::current()->preload("sounds/coin2.ogg");
+  for (const auto& sound : s_preload_sounds)
+    SoundManager::current()->preload(sound);
   set_group(COLGROUP_MOVING);
   m_physic.set_velocity(init_velocity);
 }
@@ -265,7 +282,8 @@ HeavyCoin::HeavyCoin(const ReaderMapping& reader, bool count_stats) :
   m_last_hit()
 {
   m_physic.enable_gravity(true);
-  SoundManager::current()->preload("sounds/coin2.ogg");
+  for (const auto& sound : s_preload_sounds)
+    SoundManager::current()->preload(sound);
   set_group(COLGROUP_MOVING);
 }
 
@@ -284,7 +302,7 @@ HeavyCoin::collision_solid(const CollisionHit& hit)
 
   if (hit.bottom) {
     if (m_physic.get_velocity_y() > clink_threshold && !m_last_hit.bottom)
-        SoundManager::current()->play("sounds/coin2.ogg", get_pos());
+        SoundManager::current()->play(CLINK_SOUND, get_pos());
     if (m_physic.get_velocity_y() > 200) {// lets some coins bounce
       m_physic.set_velocity_y(-99);
     } else {
@@ -295,12 +313,12 @@ HeavyCoin::collision_solid(const CollisionHit& hit)
     if ((m_physic.get_velocity_x() > clink_threshold ||
          m_physic.get_velocity_x()< -clink_threshold) &&
          hit.right != m_last_hit.right && hit.left != m_last_hit.left)
-      SoundManager::current()->play("sounds/coin2.ogg", get_pos());
+      SoundManager::current()->play(CLINK_SOUND, get_pos());
     m_physic.set_velocity_x(-m_physic.get_velocity_x());
   }
   if (hit.top) {
     if (m_physic.get_velocity_y() < -clink_threshold && !m_last_hit.top)
-      SoundManager::current()->play("sounds/coin2.ogg", get_pos());
+      SoundManager::current()->play(CLINK_SOUND, get_pos());
     m_physic.set_velocity_y(-m_physic.get_velocity_y());
   }
 
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "object/path_object.hpp"
 #include "object/moving_sprite.hpp"
 #include "supertux/physic.hpp"
@@ -38,6 +40,10 @@ public:
   virtual HitResponse collision(MovingObject& other, const CollisionHit& hit) override;
 
   virtual void update(float dt_sec) override;
+  /** The sounds that the constructor preloads, AssetPrefetch starts loading
+      them for levels that contain the object. */
+  static const std::vector<std::string> s_preload_sounds;
+
   static std::string class_name() { return "coin"; }
   virtual std::string get_class_name() const override { return class_name(); }
   static std::string display_name() { return _("Coin"); }
@@ -94,6 +100,10 @@ public:
   virtual void update(float dt_sec) override;
   virtual void collision_solid(const CollisionHit& hit) override;
 
+  /** The sounds that the constructor preloads, AssetPrefetch starts loading
+      them for levels that contain the object. */
+  static const std::vector<std::string> s_preload_sounds;
+
   static std::string class_name() { return "heavycoin"; }
   virtual std::string get_class_name() const override { return class_name(); }
   static std::string display_name() { return _("Heavy Coin"); }
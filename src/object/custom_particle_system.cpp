@@ -16,23 +16,22 @@
 
 #include "object/custom_particle_system.hpp"
 
+#include <algorithm>
 #include <assert.h>
+#include <limits>
 #include <math.h>
 
 #include "collision/collision.hpp"
 #include "editor/particle_editor.hpp"
 #include "gui/menu_manager.hpp"
-#include "math/aatriangle.hpp"
 #include "math/easing.hpp"
 #include "math/random.hpp"
 #include "math/util.hpp"
 #include "object/camera.hpp"
-#include "object/tilemap.hpp"
 #include "supertux/fadetoblack.hpp"
 #include "supertux/game_session.hpp"
 #include "supertux/screen_manager.hpp"
 #include "supertux/sector.hpp"
-#include "supertux/tile.hpp"
 #include "util/reader.hpp"
 #include "util/reader_document.hpp"
 #include "util/reader_mapping.hpp"
@@ -42,12 +41,22 @@
 #include "video/video_system.hpp"
 #include "video/viewport.hpp"
 
+namespace {
+
+/** How many sprite copies beyond the current textures may pile up
+    before the unused ones are dropped */
+const size_t MAX_UNUSED_SPRITES = 32;
+
+} // namespace
+
 CustomParticleSystem::CustomParticleSystem() :
   texture_sum_odds(0.f),
   time_last_remaining(0.f),
   script_easings(),
   m_textures(),
-  custom_particles(),
+  m_sprites(),
+  m_blocks(),
+  m_feather_noise(),
   m_particle_main_texture("/images/engine/editor/particle.png"),
   m_max_amount(25),
   m_delay(0.1f),
@@ -90,7 +99,9 @@ CustomParticleSystem::CustomParticleSystem(const ReaderMapping& reader) :
   time_last_remaining(0.f),
   script_easings(),
   m_textures(),
-  custom_particles(),
+  m_sprites(),
+  m_blocks(),
+  m_feather_noise(),
   m_particle_main_texture("/images/engine/editor/particle.png"),
   m_max_amount(25),
   m_delay(0.1f),
@@ -374,6 +385,103 @@ CustomParticleSystem::~CustomParticleSystem()
 {
 }
 
+CustomParticleSystem::ParticleBlock::ParticleBlock(const ParticleModes& modes_) :
+  modes(modes_),
+  x(),
+  y(),
+  speed_x(),
+  speed_y(),
+  acc_x(),
+  acc_y(),
+  friction_x(),
+  friction_y(),
+  feather(),
+  angle(),
+  angle_speed(),
+  angle_acc(),
+  angle_decc(),
+  lifetime(),
+  birth_time(),
+  death_time(),
+  total_birth(),
+  total_death(),
+  scale(),
+  alpha(),
+  sprite(),
+  dead(),
+  on_screen(),
+  in_life_zone(),
+  life_zone_instakill(),
+  stuck()
+{
+}
+
+/** Calls @c func with every field except the dead flags */
+template<typename F>
+void
+CustomParticleSystem::ParticleBlock::for_each_field(F func)
+{
+  func(x);
+  func(y);
+  func(speed_x);
+  func(speed_y);
+  func(acc_x);
+  func(acc_y);
+  func(friction_x);
+  func(friction_y);
+  func(feather);
+  func(angle);
+  func(angle_speed);
+  func(angle_acc);
+  func(angle_decc);
+  func(lifetime);
+  func(birth_time);
+  func(death_time);
+  func(total_birth);
+  func(total_death);
+  func(scale);
+  func(alpha);
+  func(sprite);
+  func(on_screen);
+  func(in_life_zone);
+  func(life_zone_instakill);
+  func(stuck);
+}
+
+size_t
+CustomParticleSystem::ParticleBlock::add()
+{
+  for_each_field([](auto& field) { field.emplace_back(); });
+  dead.push_back(0);
+  return dead.size() - 1;
+}
+
+void
+CustomParticleSystem::ParticleBlock::remove_dead()
+{
+  if (std::find(dead.begin(), dead.end(), 1) == dead.end())
+    return;
+
+  const size_t count = size();
+  for_each_field([this, count](auto& field) {
+    size_t kept = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+      if (!dead[i])
+        field[kept++] = field[i];
+    }
+    field.resize(kept);
+  });
+  dead.assign(size(), 0);
+}
+
+CustomParticleSystem::ZoneLookup::ZoneLookup() :
+  zones(),
+  spawn_zones(),
+  bounds()
+{
+}
+
 void
 CustomParticleSystem::reinit_textures()
 {
@@ -556,141 +664,187 @@ CustomParticleSystem::update(float dt_sec)
     }
   }
 
-  // Update existing particles.
-  for (auto& it : custom_particles) {
-    auto particle = dynamic_cast<CustomParticle*>(it.get());
-    assert(particle);
+  // Update existing particles. The zones and the camera are the same for
+  // every particle, so they are only looked up once per frame.
+  const ZoneLookup lookup = get_zone_lookup();
+  const float abs_x = get_abs_x();
+  const float abs_y = get_abs_y();
+
+  for (auto& block : m_blocks)
+  {
+    update_lifetimes(block, dt_sec);
+    update_offscreen(block, abs_x, abs_y);
+    update_zones(block, lookup);
+    update_movement(block, dt_sec);
+    update_rotation(block, dt_sec);
+
+    // Clear dead particles.
+    block.remove_dead();
+  }
+
+  m_blocks.erase(std::remove_if(m_blocks.begin(), m_blocks.end(),
+                                [](const ParticleBlock& block) { return block.size() == 0; }),
+                 m_blocks.end());
+  compact_sprites();
+
+  // Add necessary particles.
+  float remaining = dt_sec + time_last_remaining;
+
+  if (enabled) {
+    int real_max = m_max_amount;
+    if (!m_cover_screen) {
+      real_max *= static_cast<int>(lookup.spawn_zones.size());
+    }
+    while (remaining > m_delay && static_cast<int>(get_particle_count()) < real_max)
+    {
+      spawn_particles(remaining, lookup);
+      remaining -= m_delay;
+    }
+  }
+
+  // Maxes to m_delay, so that if there's already the max amount of particles,
+  // it won't store all the time waiting for some particles to go and then
+  // spawn a bazillion particles instantly. (Bacisally it means : This will
+  // help guarantee there will be at least m_delay between each particle
+  // spawn as long as m_delay >= dt_sec).
+  time_last_remaining = (remaining > m_delay) ? m_delay : remaining;
+
+}
+
+void
+CustomParticleSystem::update_lifetimes(ParticleBlock& block, float dt_sec)
+{
+  const ParticleModes& modes = block.modes;
+  const easing birth_easing = getEasingByName(modes.birth_easing);
+  const easing death_easing = getEasingByName(modes.death_easing);
 
-    if (particle->birth_time > dt_sec) {
-      switch(particle->birth_mode) {
+  for (size_t i = 0; i < block.size(); ++i)
+  {
+    if (block.birth_time[i] > dt_sec) {
+      const float progress = 1.f - (block.birth_time[i] / block.total_birth[i]);
+      switch(modes.birth_mode) {
       case FadeMode::Shrink:
-        particle->scale = static_cast<float>(
-                          getEasingByName(particle->birth_easing)(
-                            static_cast<double>(
-                              1.f - (particle->birth_time / particle->total_birth)
-                            )
-                          ));
+        block.scale[i] = static_cast<float>(birth_easing(static_cast<double>(progress)));
         break;
       case FadeMode::Fade:
-        particle->props = SpriteProperties(particle->original_props,
-                                           1.f - (particle->birth_time /
-                                                  particle->total_birth));
+        block.alpha[i] = progress;
         break;
       default:
         break;
       }
-      particle->birth_time -= dt_sec;
-    } else if (particle->birth_time > 0.f) {
-      particle->birth_time = 0.f;
-      switch(particle->birth_mode) {
+      block.birth_time[i] -= dt_sec;
+    } else if (block.birth_time[i] > 0.f) {
+      block.birth_time[i] = 0.f;
+      switch(modes.birth_mode) {
       case FadeMode::Shrink:
-        particle->scale = 1.f;
+        block.scale[i] = 1.f;
         break;
       case FadeMode::Fade:
-        particle->props = particle->original_props;
+        block.alpha[i] = 1.f;
         break;
       default:
         break;
       }
     }
 
-    particle->lifetime -= dt_sec;
-    if (particle->lifetime < 0.f) {
-      particle->lifetime = 0.f;
+    block.lifetime[i] -= dt_sec;
+    if (block.lifetime[i] < 0.f) {
+      block.lifetime[i] = 0.f;
     }
 
-    if (particle->birth_time <= 0.f && particle->lifetime <= 0.f) {
-      if (particle->death_time > dt_sec) {
-        switch(particle->death_mode) {
+    if (block.birth_time[i] <= 0.f && block.lifetime[i] <= 0.f) {
+      if (block.death_time[i] > dt_sec) {
+        const float remaining = block.death_time[i] / block.total_death[i];
+        switch(modes.death_mode) {
         case FadeMode::Shrink:
-          particle->scale = 1.f - static_cast<float>(
-                            getEasingByName(particle->death_easing)(
-                              static_cast<double>(
-                                1.f - (particle->death_time / particle->total_death)
-                              )
-                            ));
+          block.scale[i] = 1.f - static_cast<float>(death_easing(static_cast<double>(1.f - remaining)));
           break;
         case FadeMode::Fade:
-          particle->props = SpriteProperties(particle->original_props,
-                                                   (particle->death_time /
-                                                    particle->total_death));
+          block.alpha[i] = remaining;
           break;
         default:
           break;
         }
-        particle->death_time -= dt_sec;
+        block.death_time[i] -= dt_sec;
       } else {
-        particle->death_time = 0.f;
-        switch(particle->death_mode) {
+        block.death_time[i] = 0.f;
+        switch(modes.death_mode) {
         case FadeMode::Shrink:
-          particle->scale = 0.f;
+          block.scale[i] = 0.f;
           break;
         case FadeMode::Fade:
-          particle->props = SpriteProperties(particle->original_props, 0.f);
+          block.alpha[i] = 0.f;
           break;
         default:
           break;
         }
-        particle->ready_for_deletion = true;
+        block.dead[i] = 1;
       }
     }
+  }
+}
 
-    float abs_x = get_abs_x();
-    float abs_y = get_abs_y();
+void
+CustomParticleSystem::update_offscreen(ParticleBlock& block, float abs_x, float abs_y)
+{
+  const OffscreenMode mode = block.modes.offscreen_mode;
+  const float left = abs_x;
+  const float top = abs_y;
+  const float right = static_cast<float>(SCREEN_WIDTH) + abs_x;
+  const float bottom = static_cast<float>(SCREEN_HEIGHT) + abs_y;
 
-    if (!particle->has_been_on_screen) {
-      if (particle->pos.y <= static_cast<float>(SCREEN_HEIGHT) + abs_y
-          && particle->pos.y >= abs_y
-          && particle->pos.x <= static_cast<float>(SCREEN_WIDTH) + abs_x
-          && particle->pos.x >= abs_x) {
-        particle->has_been_on_screen = true;
-      }
-    }
+  const size_t count = block.size();
+  const float* x = block.x.data();
+  const float* y = block.y.data();
+  uint8_t* on_screen = block.on_screen.data();
+  uint8_t* dead = block.dead.data();
 
-    switch(particle->offscreen_mode) {
-    case OffscreenMode::Always:
-      if (particle->pos.y > static_cast<float>(SCREEN_HEIGHT) + abs_y
-          || particle->pos.y < abs_y
-          || particle->pos.x > static_cast<float>(SCREEN_WIDTH) + abs_x
-          || particle->pos.x < abs_x) {
-        particle->ready_for_deletion = true;
-      }
-      break;
-    case OffscreenMode::OnlyOnExit:
-      if ((particle->pos.y > static_cast<float>(SCREEN_HEIGHT) + abs_y
-          || particle->pos.y < abs_y
-          || particle->pos.x > static_cast<float>(SCREEN_WIDTH) + abs_x
-          || particle->pos.x < abs_x)
-          && particle->has_been_on_screen) {
-        particle->ready_for_deletion = true;
-      }
-      break;
-    case OffscreenMode::Never:
-      break;
+  for (size_t i = 0; i < count; ++i)
+  {
+    const bool inside = y[i] <= bottom && y[i] >= top && x[i] <= right && x[i] >= left;
+    on_screen[i] |= inside;
+
+    if (!inside && (mode == OffscreenMode::Always ||
+                    (mode == OffscreenMode::OnlyOnExit && on_screen[i]))) {
+      dead[i] = 1;
     }
+  }
+}
+
+void
+CustomParticleSystem::update_zones(ParticleBlock& block, const ZoneLookup& lookup)
+{
+  const bool has_zones = !lookup.zones.empty();
+
+  for (size_t i = 0; i < block.size(); ++i)
+  {
+    const Vector pos(block.x[i], block.y[i]);
 
     bool is_in_life_zone = false;
-    for (auto& zone : get_zones()) {
-      if (zone.get_rect().contains(particle->pos) && zone.get_particle_name() == m_name) {
+    if (has_zones && lookup.bounds.contains(pos)) {
+      for (const auto& zone : lookup.zones) {
+        if (!zone.get_rect().contains(pos))
+          continue;
+
         switch(zone.get_type()) {
         case ParticleZone::ParticleZoneType::Killer:
-          particle->lifetime = 0.f;
-          particle->birth_time = 0.f;
+          block.lifetime[i] = 0.f;
+          block.birth_time[i] = 0.f;
           break;
 
         case ParticleZone::ParticleZoneType::Destroyer:
-          particle->ready_for_deletion = true;
+          block.dead[i] = 1;
           break;
 
         case ParticleZone::ParticleZoneType::LifeClear:
-          particle->last_life_zone_required_instakill = true;
-          particle->has_been_in_life_zone = true;
+          block.life_zone_instakill[i] = 1;
+          block.in_life_zone[i] = 1;
           is_in_life_zone = true;
           break;
 
         case ParticleZone::ParticleZoneType::Life:
-          particle->last_life_zone_required_instakill = false;
-          particle->has_been_in_life_zone = true;
+          block.life_zone_instakill[i] = 0;
+          block.in_life_zone[i] = 1;
           is_in_life_zone = true;
           break;
 
@@ -699,153 +853,165 @@ CustomParticleSystem::update(float dt_sec)
           break;
         }
       }
-    } // For each ParticleZone object.
-
-    if (!is_in_life_zone && particle->has_been_in_life_zone) {
-      if (particle->last_life_zone_required_instakill) {
-        particle->ready_for_deletion = true;
-      } else {
-        particle->lifetime = 0.f;
-        particle->birth_time = 0.f;
-      }
     }
 
-    if (!particle->stuck) {
-      particle->speedX += graphicsRandom.randf(-particle->feather_factor,
-                                      particle->feather_factor) * dt_sec * 1000.f;
-      particle->speedY += graphicsRandom.randf(-particle->feather_factor,
-                                      particle->feather_factor) * dt_sec * 1000.f;
-      particle->speedX += particle->accX * dt_sec;
-      particle->speedY += particle->accY * dt_sec;
-      particle->speedX *= 1.f - particle->frictionX * dt_sec;
-      particle->speedY *= 1.f - particle->frictionY * dt_sec;
-
-      if (Sector::current() && collision(particle,
-                    Vector(particle->speedX,particle->speedY) * dt_sec) > 0) {
-        switch(particle->collision_mode) {
-        case CollisionMode::Ignore:
-          particle->pos.x += particle->speedX * dt_sec;
-          particle->pos.y += particle->speedY * dt_sec;
-          break;
-        case CollisionMode::Stick:
-          // Just don't move
-          break;
-        case CollisionMode::StickForever:
-          particle->stuck = true;
-          break;
-        case CollisionMode::BounceHeavy:
-        case CollisionMode::BounceLight:
-          {
-            auto c = get_collision(particle, Vector(particle->speedX, particle->speedY) * dt_sec);
-
-            float speed_angle = atanf(-particle->speedY / particle->speedX);
-            if (c.slope_normal.x == 0.f && c.slope_normal.y == 0.f) {
-              auto cX = get_collision(particle, Vector(particle->speedX, 0) * dt_sec);
-              if (cX.left != cX.right)
-                particle->speedX *= -1;
-              auto cY = get_collision(particle, Vector(0, particle->speedY) * dt_sec);
-              if (cY.top != cY.bottom)
-                particle->speedY *= -1;
-            } else {
-              float face_angle = atanf(c.slope_normal.y / c.slope_normal.x);
-              float dest_angle = face_angle * 2.f - speed_angle; // Reflect the angle around face_angle.
-              float dX = cosf(dest_angle),
-                    dY = sinf(dest_angle);
-
-              float true_speed = static_cast<float>(sqrt(pow(particle->speedY, 2)
-                                                      + pow(particle->speedX, 2)));
-
-              particle->speedX = dX * true_speed;
-              particle->speedY = dY * true_speed;
-            }
-
-            switch(particle->collision_mode) {
-              case CollisionMode::BounceHeavy:
-                particle->speedX *= .2f;
-                particle->speedY *= .2f;
-                break;
-              case CollisionMode::BounceLight:
-                particle->speedX *= .7f;
-                particle->speedY *= .7f;
-                break;
-              default:
-                assert(false);
-            }
-
-            particle->pos.x += particle->speedX * dt_sec;
-            particle->pos.y += particle->speedY * dt_sec;
-          }
-          break;
-        case CollisionMode::Destroy:
-          particle->ready_for_deletion = true;
-          break;
-        case CollisionMode::FadeOut:
-          particle->lifetime = 0.f;
-          break;
-        }
+    if (!is_in_life_zone && block.in_life_zone[i]) {
+      if (block.life_zone_instakill[i]) {
+        block.dead[i] = 1;
       } else {
-        particle->pos.x += particle->speedX * dt_sec;
-        particle->pos.y += particle->speedY * dt_sec;
-      }
-
-      switch(particle->angle_mode) {
-      case RotationMode::Facing:
-        particle->angle = atanf(particle->speedY / particle->speedX) * 180.f / math::PI;
-        break;
-      case RotationMode::Wiggling:
-        particle->angle += graphicsRandom.randf(-particle->angle_speed / 2.f,
-                                            particle->angle_speed / 2.f) * dt_sec;
-        break;
-      case RotationMode::Fixed:
-      default:
-        particle->angle_speed += particle->angle_acc * dt_sec;
-        particle->angle_speed *= 1.f - particle->angle_decc * dt_sec;
-        particle->angle += particle->angle_speed * dt_sec;
+        block.lifetime[i] = 0.f;
+        block.birth_time[i] = 0.f;
       }
     }
+  }
+}
 
-  } // For each particle.
+void
+CustomParticleSystem::update_movement(ParticleBlock& block, float dt_sec)
+{
+  const size_t count = block.size();
 
+  // Draw the feathering noise up front, so that the integration below
+  // is a plain loop over the arrays.
+  m_feather_noise.resize(count * 2);
+  float* noise_x = m_feather_noise.data();
+  float* noise_y = noise_x + count;
+  for (size_t i = 0; i < count; ++i)
+  {
+    noise_x[i] = graphicsRandom.randf(-block.feather[i], block.feather[i]);
+    noise_y[i] = graphicsRandom.randf(-block.feather[i], block.feather[i]);
+  }
 
-  // Clear dead particles
-  // We iterate through the vector backwards because removing an element affects
-  // the index of all elements after it, which can lead to buggy behavior.
-  for (int i = static_cast<int>(custom_particles.size()) - 1; i >= 0; --i) {
-    auto particle = dynamic_cast<CustomParticle*>(custom_particles.at(i).get());
+  float* x = block.x.data();
+  float* y = block.y.data();
+  float* speed_x = block.speed_x.data();
+  float* speed_y = block.speed_y.data();
+  const float* acc_x = block.acc_x.data();
+  const float* acc_y = block.acc_y.data();
+  const float* friction_x = block.friction_x.data();
+  const float* friction_y = block.friction_y.data();
+  const uint8_t* stuck = block.stuck.data();
+  const float feather_scale = dt_sec * 1000.f;
+
+  // The speed of stuck particles is never used again, so it is updated
+  // along with the others.
+  for (size_t i = 0; i < count; ++i)
+  {
+    speed_x[i] = (speed_x[i] + noise_x[i] * feather_scale + acc_x[i] * dt_sec) * (1.f - friction_x[i] * dt_sec);
+    speed_y[i] = (speed_y[i] + noise_y[i] * feather_scale + acc_y[i] * dt_sec) * (1.f - friction_y[i] * dt_sec);
+  }
 
-    if (particle->ready_for_deletion) {
-      custom_particles.erase(custom_particles.begin()+i);
+  if (!Sector::current() || block.modes.collision_mode == CollisionMode::Ignore)
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      const float step = stuck[i] ? 0.f : dt_sec;
+      x[i] += speed_x[i] * step;
+      y[i] += speed_y[i] * step;
     }
+    return;
   }
 
-  // Add necessary particles.
-  float remaining = dt_sec + time_last_remaining;
+  for (size_t i = 0; i < count; ++i)
+  {
+    if (stuck[i])
+      continue;
+
+    const SpriteProperties& props = m_sprites[block.sprite[i]];
+    if (collision(x[i], y[i], props, Vector(speed_x[i], speed_y[i]) * dt_sec) <= 0) {
+      x[i] += speed_x[i] * dt_sec;
+      y[i] += speed_y[i] * dt_sec;
+      continue;
+    }
 
-  if (enabled) {
-    int real_max = m_max_amount;
-    if (!m_cover_screen) {
-      int i = 0;
-      for (auto& zone : get_zones()) {
-        if (zone.get_type() == ParticleZone::ParticleZoneType::Spawn && zone.get_particle_name() == m_name) {
-          i++;
+    switch(block.modes.collision_mode) {
+    case CollisionMode::Ignore:
+      x[i] += speed_x[i] * dt_sec;
+      y[i] += speed_y[i] * dt_sec;
+      break;
+    case CollisionMode::Stick:
+      // Just don't move
+      break;
+    case CollisionMode::StickForever:
+      block.stuck[i] = 1;
+      break;
+    case CollisionMode::BounceHeavy:
+    case CollisionMode::BounceLight:
+      {
+        auto c = get_collision(x[i], y[i], props, Vector(speed_x[i], speed_y[i]) * dt_sec);
+
+        float speed_angle = atanf(-speed_y[i] / speed_x[i]);
+        if (c.slope_normal.x == 0.f && c.slope_normal.y == 0.f) {
+          auto cX = get_collision(x[i], y[i], props, Vector(speed_x[i], 0) * dt_sec);
+          if (cX.left != cX.right)
+            speed_x[i] *= -1;
+          auto cY = get_collision(x[i], y[i], props, Vector(0, speed_y[i]) * dt_sec);
+          if (cY.top != cY.bottom)
+            speed_y[i] *= -1;
+        } else {
+          float face_angle = atanf(c.slope_normal.y / c.slope_normal.x);
+          float dest_angle = face_angle * 2.f - speed_angle; // Reflect the angle around face_angle.
+          float dX = cosf(dest_angle),
+                dY = sinf(dest_angle);
+
+          float true_speed = sqrtf(speed_x[i] * speed_x[i] + speed_y[i] * speed_y[i]);
+
+          speed_x[i] = dX * true_speed;
+          speed_y[i] = dY * true_speed;
         }
+
+        const float damping = (block.modes.collision_mode == CollisionMode::BounceHeavy) ? .2f : .7f;
+        speed_x[i] *= damping;
+        speed_y[i] *= damping;
+
+        x[i] += speed_x[i] * dt_sec;
+        y[i] += speed_y[i] * dt_sec;
       }
-      real_max *= i;
+      break;
+    case CollisionMode::Destroy:
+      block.dead[i] = 1;
+      break;
+    case CollisionMode::FadeOut:
+      block.lifetime[i] = 0.f;
+      break;
     }
-    while (remaining > m_delay && int(custom_particles.size()) < real_max)
+  }
+}
+
+void
+CustomParticleSystem::update_rotation(ParticleBlock& block, float dt_sec)
+{
+  const size_t count = block.size();
+  float* angle = block.angle.data();
+  float* angle_speed = block.angle_speed.data();
+  const float* angle_acc = block.angle_acc.data();
+  const float* angle_decc = block.angle_decc.data();
+  const float* speed_x = block.speed_x.data();
+  const float* speed_y = block.speed_y.data();
+  const uint8_t* stuck = block.stuck.data();
+
+  switch(block.modes.angle_mode) {
+  case RotationMode::Facing:
+    for (size_t i = 0; i < count; ++i)
+      if (!stuck[i])
+        angle[i] = atanf(speed_y[i] / speed_x[i]) * 180.f / math::PI;
+    break;
+  case RotationMode::Wiggling:
+    for (size_t i = 0; i < count; ++i)
+      if (!stuck[i])
+        angle[i] += graphicsRandom.randf(-angle_speed[i] / 2.f, angle_speed[i] / 2.f) * dt_sec;
+    break;
+  case RotationMode::Fixed:
+  default:
+    for (size_t i = 0; i < count; ++i)
     {
-      spawn_particles(remaining);
-      remaining -= m_delay;
+      const float step = stuck[i] ? 0.f : dt_sec;
+      angle_speed[i] += angle_acc[i] * step;
+      angle_speed[i] *= 1.f - angle_decc[i] * step;
+      angle[i] += angle_speed[i] * step;
     }
+    break;
   }
-
-  // Maxes to m_delay, so that if there's already the max amount of particles,
-  // it won't store all the time waiting for some particles to go and then
-  // spawn a bazillion particles instantly. (Bacisally it means : This will
-  // help guarantee there will be at least m_delay between each particle
-  // spawn as long as m_delay >= dt_sec).
-  time_last_remaining = (remaining > m_delay) ? m_delay : remaining;
-
 }
 
 void
@@ -856,54 +1022,60 @@ CustomParticleSystem::draw(DrawingContext& context)
 
   context.push_transform();
 
-  std::unordered_map<SpriteProperties*, SurfaceBatch> batches;
-  for (const auto& particle : custom_particles) {
-    auto it = batches.find(&(particle->props));
-    if (it == batches.end()) {
-      const auto& batch_it = batches.emplace(&(particle->props),
-        SurfaceBatch(particle->props.texture, particle->props.color));
-      batch_it.first->second.draw(Rectf(Vector(
-                                               particle->pos.x - particle->scale
-                                                 * static_cast<float>(
-                                                 particle->props.texture->get_width()
-                                               ) * particle->props.scale.x / 2,
-                                               particle->pos.y - particle->scale
-                                                 * static_cast<float>(
-                                                 particle->props.texture->get_height()
-                                               ) * particle->props.scale.y / 2
-                                        ),
-                                        Vector(
-                                               particle->pos.x + particle->scale
-                                                 * static_cast<float>(
-                                                 particle->props.texture->get_width()
-                                               ) * particle->props.scale.x / 2,
-                                               particle->pos.y + particle->scale
-                                                 * static_cast<float>(
-                                                 particle->props.texture->get_height()
-                                               ) * particle->props.scale.y / 2
-                                        )
-                                 ), particle->angle);
-    } else {
-      it->second.draw(Rectf(particle->pos,
-                                        Vector(
-                                               particle->pos.x + particle->scale
-                                                 * static_cast<float>(
-                                                 particle->texture->get_width()
-                                               ) * particle->props.scale.x,
-                                               particle->pos.y + particle->scale
-                                                 * static_cast<float>(
-                                                 particle->texture->get_height()
-                                               ) * particle->props.scale.y
-                                        )
-                                 ), particle->angle);
+  // Opaque particles share one batch per sprite, fading particles each
+  // need their own color.
+  std::vector<SurfaceBatch> batches;
+  std::vector<Vector> half_sizes;
+  for (const auto& sprite : m_sprites)
+  {
+    batches.emplace_back(sprite.texture, sprite.color);
+    half_sizes.emplace_back(static_cast<float>(sprite.texture->get_width()) * sprite.scale.x / 2,
+                            static_cast<float>(sprite.texture->get_height()) * sprite.scale.y / 2);
+  }
+
+  std::vector<SurfaceBatch> fading_batches;
+  std::vector<uint32_t> fading_sprites;
+
+  for (const auto& block : m_blocks)
+  {
+    for (size_t i = 0; i < block.size(); ++i)
+    {
+      if (block.alpha[i] <= 0.f)
+        continue;
+
+      const uint32_t sprite = block.sprite[i];
+      const Vector half_size = half_sizes[sprite] * block.scale[i];
+      const Rectf rect(block.x[i] - half_size.x, block.y[i] - half_size.y,
+                       block.x[i] + half_size.x, block.y[i] + half_size.y);
+
+      if (block.alpha[i] >= 1.f) {
+        batches[sprite].draw(rect, block.angle[i]);
+      } else {
+        const Color& color = m_sprites[sprite].color;
+        fading_batches.emplace_back(m_sprites[sprite].texture,
+                                    Color(color.red, color.green, color.blue,
+                                          color.alpha * block.alpha[i]));
+        fading_batches.back().draw(rect, block.angle[i]);
+        fading_sprites.push_back(sprite);
+      }
     }
   }
 
-  for(auto& it : batches) {
-    auto& surface = it.first->texture;
-    auto& batch = it.second;
-    context.color().draw_surface_batch(surface, batch.move_srcrects(),
-      batch.move_dstrects(), batch.move_angles(), it.first->color, z_pos);
+  for (size_t i = 0; i < batches.size(); ++i)
+  {
+    auto& batch = batches[i];
+    if (batch.empty())
+      continue;
+
+    context.color().draw_surface_batch(m_sprites[i].texture, batch.move_srcrects(),
+      batch.move_dstrects(), batch.move_angles(), batch.get_color(), z_pos);
+  }
+
+  for (size_t i = 0; i < fading_batches.size(); ++i)
+  {
+    auto& batch = fading_batches[i];
+    context.color().draw_surface_batch(m_sprites[fading_sprites[i]].texture, batch.move_srcrects(),
+      batch.move_dstrects(), batch.move_angles(), batch.get_color(), z_pos);
   }
 
   context.pop_transform();
@@ -912,75 +1084,37 @@ CustomParticleSystem::draw(DrawingContext& context)
 // Duplicated from ParticleSystem_Interactive because I intend to bring edits
 // sometime in the future, for even more flexibility with particles. (Semphris).
 int
-CustomParticleSystem::collision(Particle* object, const Vector& movement)
+CustomParticleSystem::collision(float pos_x, float pos_y, const SpriteProperties& props,
+                                const Vector& movement) const
 {
   using namespace collision;
 
-  CustomParticle* particle = dynamic_cast<CustomParticle*>(object);
-  assert(particle);
-
   // Calculate rectangle where the object will move.
   float x1, x2;
   float y1, y2;
 
-  x1 = object->pos.x - particle->props.hb_scale.x * static_cast<float>(particle->props.texture->get_width()) / 2
-          + particle->props.hb_offset.x * static_cast<float>(particle->props.texture->get_width());
-  x2 = x1 + particle->props.hb_scale.x * static_cast<float>(particle->props.texture->get_width()) + movement.x;
+  x1 = pos_x - props.hb_scale.x * static_cast<float>(props.texture->get_width()) / 2
+          + props.hb_offset.x * static_cast<float>(props.texture->get_width());
+  x2 = x1 + props.hb_scale.x * static_cast<float>(props.texture->get_width()) + movement.x;
   if (x2 < x1) {
     float temp_x = x1;
     x1 = x2;
     x2 = temp_x;
   }
 
-  y1 = object->pos.y - particle->props.hb_scale.y * static_cast<float>(particle->props.texture->get_height()) / 2
-          + particle->props.hb_offset.y * static_cast<float>(particle->props.texture->get_height());
-  y2 = y1 + particle->props.hb_scale.y * static_cast<float>(particle->props.texture->get_height()) + movement.y;
+  y1 = pos_y - props.hb_scale.y * static_cast<float>(props.texture->get_height()) / 2
+          + props.hb_offset.y * static_cast<float>(props.texture->get_height());
+  y2 = y1 + props.hb_scale.y * static_cast<float>(props.texture->get_height()) + movement.y;
   if (y2 < y1) {
     float temp_y = y1;
     y1 = y2;
     y2 = temp_y;
   }
-  bool water = false;
-
-  // Test with all tiles in this rectangle.
-  int starttilex = int(x1-1) / 32;
-  int starttiley = int(y1-1) / 32;
-  int max_x = int(x2+1);
-  int max_y = int(y2+1);
 
   Rectf dest(x1, y1, x2, y2);
   dest.move(movement);
   Constraints constraints;
-
-  for (const auto& solids : Sector::get().get_solid_tilemaps()) {
-    // FIXME: Handle a nonzero tilemap offset.
-    // Check if it gets fixed in particlesystem_interactive.cpp.
-    for (int x = starttilex; x*32 < max_x; ++x) {
-      for (int y = starttiley; y*32 < max_y; ++y) {
-        const Tile& tile = solids->get_tile(x, y);
-
-        // Skip non-solid tiles, except water.
-        if (! (tile.get_attributes() & (Tile::WATER | Tile::SOLID)))
-          continue;
-
-        Rectf rect = solids->get_tile_bbox(x, y);
-        if (tile.is_slope ()) { // Slope tile.
-          AATriangle triangle = AATriangle(rect, tile.get_data());
-
-          if (rectangle_aatriangle(&constraints, dest, triangle)) {
-            if (tile.get_attributes() & Tile::WATER)
-              water = true;
-          }
-        } else { // Normal rectangular tile.
-          if (dest.overlaps(rect)) {
-            if (tile.get_attributes() & Tile::WATER)
-              water = true;
-            set_rectangle_rectangle_constraints(&constraints, dest, rect);
-          }
-        }
-      }
-    }
-  }
+  const bool water = collect_tile_constraints(dest, true, constraints);
 
   // TODO: Avoid using magic numbers in this section.
 
@@ -1001,66 +1135,35 @@ CustomParticleSystem::collision(Particle* object, const Vector& movement)
 }
 
 CollisionHit
-CustomParticleSystem::get_collision(Particle* object, const Vector& movement)
+CustomParticleSystem::get_collision(float pos_x, float pos_y, const SpriteProperties& props,
+                                    const Vector& movement) const
 {
   using namespace collision;
 
-  CustomParticle* particle = dynamic_cast<CustomParticle*>(object);
-  assert(particle);
-
   // Calculate rectangle where the object will move.
   float x1, x2;
   float y1, y2;
 
-  x1 = object->pos.x - particle->props.scale.x * static_cast<float>(particle->props.texture->get_width()) / 2;
-  x2 = x1 + particle->props.scale.x * static_cast<float>(particle->props.texture->get_width()) + movement.x;
+  x1 = pos_x - props.scale.x * static_cast<float>(props.texture->get_width()) / 2;
+  x2 = x1 + props.scale.x * static_cast<float>(props.texture->get_width()) + movement.x;
   if (x2 < x1) {
     float temp_x = x1;
     x1 = x2;
     x2 = temp_x;
   }
 
-  y1 = object->pos.y - particle->props.scale.y * static_cast<float>(particle->props.texture->get_height()) / 2;
-  y2 = y1 + particle->props.scale.y * static_cast<float>(particle->props.texture->get_height()) + movement.y;
+  y1 = pos_y - props.scale.y * static_cast<float>(props.texture->get_height()) / 2;
+  y2 = y1 + props.scale.y * static_cast<float>(props.texture->get_height()) + movement.y;
   if (y2 < y1) {
     float temp_y = y1;
     y1 = y2;
     y2 = temp_y;
   }
 
-  // Test with all tiles in this rectangle.
-  int starttilex = int(x1-1) / 32;
-  int starttiley = int(y1-1) / 32;
-  int max_x = int(x2+1);
-  int max_y = int(y2+1);
-
   Rectf dest(x1, y1, x2, y2);
   dest.move(movement);
   Constraints constraints;
-
-  for (const auto& solids : Sector::get().get_solid_tilemaps()) {
-    // FIXME: Handle a nonzero tilemap offset.
-    // Check if it gets fixed in particlesystem_interactive.cpp.
-    for (int x = starttilex; x*32 < max_x; ++x) {
-      for (int y = starttiley; y*32 < max_y; ++y) {
-        const Tile& tile = solids->get_tile(x, y);
-
-        // Skip non-solid tiles.
-        if (! (tile.get_attributes() & (/*Tile::WATER |*/ Tile::SOLID)))
-          continue;
-
-        Rectf rect = solids->get_tile_bbox(x, y);
-        if (tile.is_slope ()) { // Slope tile.
-          AATriangle triangle = AATriangle(rect, tile.get_data());
-          rectangle_aatriangle(&constraints, dest, triangle);
-        } else { // Normal rectangular tile.
-          if (dest.overlaps(rect)) {
-            set_rectangle_rectangle_constraints(&constraints, dest, rect);
-          }
-        }
-      }
-    }
-  }
+  collect_tile_constraints(dest, false, constraints);
 
   return constraints.hit;
 }
@@ -1069,7 +1172,7 @@ CustomParticleSystem::get_collision(Particle* object, const Vector& movement)
 // =============================================================================
 // LOCAL
 
-CustomParticleSystem::SpriteProperties
+const CustomParticleSystem::SpriteProperties&
 CustomParticleSystem::get_random_texture() const
 {
   float val = graphicsRandom.randf(texture_sum_odds);
@@ -1093,8 +1196,10 @@ CustomParticleSystem::get_zones() const
   if (!ParticleEditor::current()) {
 
     // In game or in level editor.
-    for (auto& zone : GameSession::current()->get_current_sector().get_objects_by_type<ParticleZone>()) {
-      list.push_back(zone.get_details());
+    if (GameSession::current()) {
+      for (auto& zone : GameSession::current()->get_current_sector().get_objects_by_type<ParticleZone>()) {
+        list.push_back(zone.get_details());
+      }
     }
 
   } else {
@@ -1113,6 +1218,35 @@ CustomParticleSystem::get_zones() const
   return list;
 }
 
+CustomParticleSystem::ZoneLookup
+CustomParticleSystem::get_zone_lookup() const
+{
+  ZoneLookup lookup;
+
+  for (const auto& zone : get_zones()) {
+    if (zone.get_particle_name() != m_name)
+      continue;
+
+    const Rectf rect = zone.get_rect();
+    if (zone.get_type() == ParticleZone::ParticleZoneType::Spawn) {
+      lookup.spawn_zones.push_back(rect);
+      continue;
+    }
+
+    if (lookup.zones.empty()) {
+      lookup.bounds = rect;
+    } else {
+      lookup.bounds = Rectf(std::min(lookup.bounds.get_left(), rect.get_left()),
+                            std::min(lookup.bounds.get_top(), rect.get_top()),
+                            std::max(lookup.bounds.get_right(), rect.get_right()),
+                            std::max(lookup.bounds.get_bottom(), rect.get_bottom()));
+    }
+    lookup.zones.push_back(zone);
+  }
+
+  return lookup;
+}
+
 float
 CustomParticleSystem::get_abs_x() const
 {
@@ -1125,6 +1259,58 @@ CustomParticleSystem::get_abs_y() const
   return (Sector::current()) ? Sector::get().get_camera().get_translation().y : 0.f;
 }
 
+uint32_t
+CustomParticleSystem::get_sprite_index(const SpriteProperties& props)
+{
+  for (size_t i = 0; i < m_sprites.size(); ++i)
+  {
+    if (m_sprites[i] == props)
+      return static_cast<uint32_t>(i);
+  }
+
+  m_sprites.push_back(props);
+  return static_cast<uint32_t>(m_sprites.size() - 1);
+}
+
+/** Drops the sprite copies that no live particle refers to anymore.
+    They pile up while the textures are edited in the particle editor. */
+void
+CustomParticleSystem::compact_sprites()
+{
+  if (m_blocks.empty()) {
+    m_sprites.clear();
+    return;
+  }
+
+  if (m_sprites.size() < m_textures.size() + MAX_UNUSED_SPRITES)
+    return;
+
+  const uint32_t unused = std::numeric_limits<uint32_t>::max();
+  std::vector<uint32_t> remap(m_sprites.size(), unused);
+  std::vector<SpriteProperties> sprites;
+
+  for (auto& block : m_blocks) {
+    for (auto& sprite : block.sprite) {
+      if (remap[sprite] == unused) {
+        remap[sprite] = static_cast<uint32_t>(sprites.size());
+        sprites.push_back(m_sprites[sprite]);
+      }
+      sprite = remap[sprite];
+    }
+  }
+
+  m_sprites = std::move(sprites);
+}
+
+size_t
+CustomParticleSystem::get_particle_count() const
+{
+  size_t count = 0;
+  for (const auto& block : m_blocks)
+    count += block.size();
+  return count;
+}
+
 /** Initializes and adds a single particle to the stack. Performs
  *    no check regarding the maximum amount of total particles.
  * @param lifetime The time elapsed since the moment the particle should have been born.
@@ -1132,86 +1318,80 @@ CustomParticleSystem::get_abs_y() const
 void
 CustomParticleSystem::add_particle(float lifetime, float x, float y)
 {
-  auto particle = std::make_unique<CustomParticle>();
-  particle->original_props = get_random_texture();
-  particle->props = particle->original_props;
+  ParticleModes modes;
+  modes.birth_mode = m_particle_birth_mode;
+  modes.death_mode = m_particle_death_mode;
+  modes.birth_easing = m_particle_birth_easing;
+  modes.death_easing = m_particle_death_easing;
+  modes.angle_mode = m_particle_rotation_mode;
+  modes.collision_mode = m_particle_collision_mode;
+  modes.offscreen_mode = m_particle_offscreen_mode;
+
+  auto block = std::find_if(m_blocks.begin(), m_blocks.end(),
+                            [&modes](const ParticleBlock& b) { return b.modes == modes; });
+  if (block == m_blocks.end()) {
+    m_blocks.emplace_back(modes);
+    block = m_blocks.end() - 1;
+  }
 
-  particle->pos.x = x;
-  particle->pos.y = y;
+  const size_t i = block->add();
+  block->sprite[i] = get_sprite_index(get_random_texture());
+
+  block->x[i] = x;
+  block->y[i] = y;
 
   float life_elapsed = lifetime;
   float birth_delta = m_particle_birth_time_variation / 2;
-  particle->total_birth = m_particle_birth_time + graphicsRandom.randf(-birth_delta, birth_delta);
-  particle->birth_time = particle->total_birth - life_elapsed;
-  if (particle->birth_time < 0.f) {
-    life_elapsed = -particle->birth_time;
-    particle->birth_time = 0.f;
+  block->total_birth[i] = m_particle_birth_time + graphicsRandom.randf(-birth_delta, birth_delta);
+  block->birth_time[i] = block->total_birth[i] - life_elapsed;
+  if (block->birth_time[i] < 0.f) {
+    life_elapsed = -block->birth_time[i];
+    block->birth_time[i] = 0.f;
   } else {
     life_elapsed = 0.f;
   }
   float life_delta = m_particle_lifetime_variation / 2;
-  particle->lifetime = m_particle_lifetime - life_elapsed + graphicsRandom.randf(-life_delta, life_delta);
-  if (particle->lifetime < 0.f) {
-    life_elapsed = -particle->lifetime;
-    particle->lifetime = 0.f;
+  block->lifetime[i] = m_particle_lifetime - life_elapsed + graphicsRandom.randf(-life_delta, life_delta);
+  if (block->lifetime[i] < 0.f) {
+    life_elapsed = -block->lifetime[i];
+    block->lifetime[i] = 0.f;
   } else {
     life_elapsed = 0.f;
   }
   float death_delta = m_particle_death_time_variation / 2;
-  particle->total_death = m_particle_death_time + graphicsRandom.randf(-death_delta, death_delta);
-  particle->death_time = particle->total_death - life_elapsed;
-
-  particle->birth_mode = m_particle_birth_mode;
-  particle->death_mode = m_particle_death_mode;
+  block->total_death[i] = m_particle_death_time + graphicsRandom.randf(-death_delta, death_delta);
+  block->death_time[i] = block->total_death[i] - life_elapsed;
 
-  particle->birth_easing = m_particle_birth_easing;
-  particle->death_easing = m_particle_death_easing;
-
-  switch(particle->birth_mode) {
-  case FadeMode::Shrink:
-    particle->scale = 0.f;
-    break;
-  default:
-    break;
-  }
+  block->scale[i] = (modes.birth_mode == FadeMode::Shrink) ? 0.f : 1.f;
+  block->alpha[i] = 1.f;
 
   float speedx_delta = m_particle_speed_variation_x / 2;
-  particle->speedX = m_particle_speed_x + graphicsRandom.randf(-speedx_delta, speedx_delta);
+  block->speed_x[i] = m_particle_speed_x + graphicsRandom.randf(-speedx_delta, speedx_delta);
   float speedy_delta = m_particle_speed_variation_y / 2;
-  particle->speedY = m_particle_speed_y + graphicsRandom.randf(-speedy_delta, speedy_delta);
-  particle->accX = m_particle_acceleration_x;
-  particle->accY = m_particle_acceleration_y;
-  particle->frictionX = m_particle_friction_x;
-  particle->frictionY = m_particle_friction_y;
+  block->speed_y[i] = m_particle_speed_y + graphicsRandom.randf(-speedy_delta, speedy_delta);
+  block->acc_x[i] = m_particle_acceleration_x;
+  block->acc_y[i] = m_particle_acceleration_y;
+  block->friction_x[i] = m_particle_friction_x;
+  block->friction_y[i] = m_particle_friction_y;
 
-  particle->feather_factor = m_particle_feather_factor;
+  block->feather[i] = m_particle_feather_factor;
 
   float angle_delta = m_particle_rotation_variation / 2;
-  particle->angle = m_particle_rotation + graphicsRandom.randf(-angle_delta, angle_delta);
+  block->angle[i] = m_particle_rotation + graphicsRandom.randf(-angle_delta, angle_delta);
   float angle_speed_delta = m_particle_rotation_speed_variation / 2;
-  particle->angle_speed = m_particle_rotation_speed + graphicsRandom.randf(-angle_speed_delta, angle_speed_delta);
-  particle->angle_acc = m_particle_rotation_acceleration;
-  particle->angle_decc = m_particle_rotation_decceleration;
-  particle->angle_mode = m_particle_rotation_mode;
-
-  particle->collision_mode = m_particle_collision_mode;
-
-  particle->offscreen_mode = m_particle_offscreen_mode;
-
-  custom_particles.push_back(std::move(particle));
+  block->angle_speed[i] = m_particle_rotation_speed + graphicsRandom.randf(-angle_speed_delta, angle_speed_delta);
+  block->angle_acc[i] = m_particle_rotation_acceleration;
+  block->angle_decc[i] = m_particle_rotation_decceleration;
 }
 
 void
-CustomParticleSystem::spawn_particles(float lifetime)
+CustomParticleSystem::spawn_particles(float lifetime, const ZoneLookup& lookup)
 {
   if (!m_cover_screen) {
-    for (auto& zone : get_zones()) {
-      if (zone.get_type() == ParticleZone::ParticleZoneType::Spawn && zone.get_particle_name() == m_name) {
-        Rectf rect = zone.get_rect();
-        add_particle(lifetime,
-                     graphicsRandom.randf(rect.get_width()) + rect.get_left(),
-                     graphicsRandom.randf(rect.get_height()) + rect.get_top());
-      }
+    for (const auto& rect : lookup.spawn_zones) {
+      add_particle(lifetime,
+                   graphicsRandom.randf(rect.get_width()) + rect.get_left(),
+                   graphicsRandom.randf(rect.get_height()) + rect.get_top());
     }
   } else {
     float abs_x = get_abs_x();
@@ -1250,8 +1430,9 @@ CustomParticleSystem::spawn_particles(int amount, bool instantly)
     return;
   }
 
+  const ZoneLookup lookup = get_zone_lookup();
   for (int i = 0; i < amount; i++)
-    spawn_particles(0.f);
+    spawn_particles(0.f, lookup);
 }
 
 // =============================================================================
@@ -18,6 +18,9 @@
 
 #include "object/particlesystem_interactive.hpp"
 
+#include <stdint.h>
+#include <vector>
+
 #include "math/easing.hpp"
 #include "math/vector.hpp"
 #include "object/particle_zone.hpp"
@@ -43,6 +46,8 @@ public:
   ~CustomParticleSystem() override;
 
   virtual void draw(DrawingContext& context) override;
+  /** Only reads its own blocks and textures, never the sector. */
+  virtual bool is_draw_threadsafe() const override { return true; }
 
   void reinit_textures();
   virtual void update(float dt_sec) override;
@@ -62,10 +67,6 @@ public:
 
   //void fade_amount(int new_amount, float fade_time);
 
-protected:
-  virtual int collision(Particle* particle, const Vector& movement) override;
-  CollisionHit get_collision(Particle* particle, const Vector& movement);
-
 private:
   struct ease_request
   {
@@ -79,7 +80,6 @@ private:
 
   // Local
   void add_particle(float lifetime, float x, float y);
-  void spawn_particles(float lifetime);
 
   std::vector<ParticleZone::ZoneDetails> get_zones() const;
 
@@ -97,7 +97,7 @@ public:
    * @scripting
    * @description Instantly removes all particles of that type on the screen.
    */
-  inline void clear() { custom_particles.clear(); }
+  inline void clear() { m_blocks.clear(); }
 
   /**
    * @scripting
@@ -774,66 +774,108 @@ private:
     }
   };
 
-  SpriteProperties get_random_texture() const;
+  const SpriteProperties& get_random_texture() const;
 
-  class CustomParticle : public Particle
+  /** The modes a particle is born with. Particles with the same modes
+      share a ParticleBlock. */
+  class ParticleModes final
   {
   public:
-    SpriteProperties original_props, props;
-    float lifetime, birth_time, death_time,
-          total_birth, total_death;
     FadeMode birth_mode, death_mode;
     EasingMode birth_easing, death_easing;
-    bool ready_for_deletion;
-    float speedX, speedY,
-          accX, accY,
-          frictionX, frictionY;
-    float feather_factor;
-    float angle_speed, angle_acc,
-          angle_decc;
     RotationMode angle_mode;
     CollisionMode collision_mode;
     OffscreenMode offscreen_mode;
-    bool has_been_on_screen;
-    bool has_been_in_life_zone;
-    bool last_life_zone_required_instakill;
-    bool stuck;
-
-    CustomParticle() :
-      original_props(),
-      props(),
-      lifetime(),
-      birth_time(),
-      death_time(),
-      total_birth(),
-      total_death(),
-      birth_mode(),
-      death_mode(),
-      birth_easing(),
-      death_easing(),
-      ready_for_deletion(false),
-      speedX(),
-      speedY(),
-      accX(),
-      accY(),
-      frictionX(),
-      frictionY(),
-      feather_factor(),
-      angle_speed(),
-      angle_acc(),
-      angle_decc(),
-      angle_mode(),
-      collision_mode(),
-      offscreen_mode(),
-      has_been_on_screen(),
-      has_been_in_life_zone(false),
-      last_life_zone_required_instakill(false),
-      stuck(false)
-    {}
+
+    inline bool operator==(const ParticleModes& other) const
+    {
+      return birth_mode == other.birth_mode
+          && death_mode == other.death_mode
+          && birth_easing == other.birth_easing
+          && death_easing == other.death_easing
+          && angle_mode == other.angle_mode
+          && collision_mode == other.collision_mode
+          && offscreen_mode == other.offscreen_mode;
+    }
   };
 
+  /** Particles that share their modes, stored as structure of arrays so
+      that every step of update() is a loop over plain floats. Sprites
+      are indices into m_sprites, alpha and scale are the fade and shrink
+      factors applied on top of the sprite. */
+  class ParticleBlock final
+  {
+  public:
+    ParticleBlock(const ParticleModes& modes_);
+
+    inline size_t size() const { return x.size(); }
+
+    /** Appends a particle with all values zero and returns its index */
+    size_t add();
+
+    /** Removes the particles marked as dead, keeping the order of the
+        others */
+    void remove_dead();
+
+    ParticleModes modes;
+    std::vector<float> x, y,
+                       speed_x, speed_y,
+                       acc_x, acc_y,
+                       friction_x, friction_y,
+                       feather,
+                       angle, angle_speed, angle_acc, angle_decc,
+                       lifetime, birth_time, death_time,
+                       total_birth, total_death,
+                       scale, alpha;
+    std::vector<uint32_t> sprite;
+    std::vector<uint8_t> dead, on_screen, in_life_zone,
+                         life_zone_instakill, stuck;
+
+  private:
+    template<typename F>
+    void for_each_field(F func);
+  };
+
+  /** The particle zones of this system, gathered once per frame */
+  class ZoneLookup final
+  {
+  public:
+    ZoneLookup();
+
+    /** Killer, destroyer and life zones */
+    std::vector<ParticleZone::ZoneDetails> zones;
+    std::vector<Rectf> spawn_zones;
+
+    /** Bounding box of all zones, to skip the zone tests for particles
+        far away from them */
+    Rectf bounds;
+  };
+
+  ZoneLookup get_zone_lookup() const;
+  void spawn_particles(float lifetime, const ZoneLookup& lookup);
+
+  uint32_t get_sprite_index(const SpriteProperties& props);
+  void compact_sprites();
+  size_t get_particle_count() const;
+
+  void update_lifetimes(ParticleBlock& block, float dt_sec);
+  void update_offscreen(ParticleBlock& block, float abs_x, float abs_y);
+  void update_zones(ParticleBlock& block, const ZoneLookup& lookup);
+  void update_movement(ParticleBlock& block, float dt_sec);
+  void update_rotation(ParticleBlock& block, float dt_sec);
+
+  int collision(float x, float y, const SpriteProperties& props, const Vector& movement) const;
+  CollisionHit get_collision(float x, float y, const SpriteProperties& props, const Vector& movement) const;
+
   std::vector<SpriteProperties> m_textures;
-  std::vector<std::unique_ptr<CustomParticle> > custom_particles;
+
+  /** Copies of the sprite properties that live particles were born
+      with, so that editing m_textures doesn't affect them */
+  std::vector<SpriteProperties> m_sprites;
+  std::vector<ParticleBlock> m_blocks;
+
+  /** Per-frame scratch space for the feathering noise */
+  std::vector<float> m_feather_noise;
 
   std::string m_particle_main_texture;
 
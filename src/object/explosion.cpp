@@ -31,6 +31,13 @@
 #include "sprite/sprite_manager.hpp"
 #include "supertux/sector.hpp"
 
+namespace {
+
+const SoundManager::SoundId EXPLOSION_SOUND = SoundManager::get_sound_id("sounds/explosion.wav");
+const SoundManager::SoundId FIRECRACKER_SOUND = SoundManager::get_sound_id("sounds/firecracker.ogg");
+
+} // namespace
+
 Explosion::Explosion(const Vector& pos, float p_push_strength,
     int p_num_particles, bool p_short_fuse) :
   MovingSprite(pos, "images/objects/explosion/explosion.sprite", LAYER_OBJECTS + 40, COLGROUP_MOVING),
@@ -86,9 +93,9 @@ Explosion::explode()
   m_sprite->set_animation_loops(1); //TODO: This is necessary because set_action will not set "loops" when "action" is the default action.
   m_sprite->set_angle(graphicsRandom.randf(0, 360)); // A random rotation on the sprite to make explosions appear more random.
   if (hurt)
-    SoundManager::current()->play("sounds/explosion.wav", get_pos(), 0.98f);
+    SoundManager::current()->play(EXPLOSION_SOUND, get_pos(), 0.98f);
   else
-    SoundManager::current()->play("sounds/firecracker.ogg", get_pos(), 0.7f);
+    SoundManager::current()->play(FIRECRACKER_SOUND, get_pos(), 0.7f);
   bool does_push = push_strength > 0;
 
   // Spawn some particles.
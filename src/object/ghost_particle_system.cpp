@@ -50,17 +50,24 @@ GhostParticleSystem::init()
 
   virtual_width = static_cast<float>(SCREEN_WIDTH) * 2.0f;
 
+  const uint8_t ghost_textures[2] = {
+    add_texture(ghosts[0]),
+    add_texture(ghosts[1])
+  };
+
   // Create two ghosts.
   size_t ghostcount = 2;
+  particles.resize(ghostcount);
   for (size_t i=0; i<ghostcount; ++i) {
-    auto particle = std::make_unique<GhostParticle>();
-    particle->pos.x = graphicsRandom.randf(virtual_width);
-    particle->pos.y = graphicsRandom.randf(static_cast<float>(SCREEN_HEIGHT));
+    particles.x[i] = graphicsRandom.randf(virtual_width);
+    particles.y[i] = graphicsRandom.randf(static_cast<float>(SCREEN_HEIGHT));
     int size = graphicsRandom.rand(2);
-    particle->texture = ghosts[size];
-    particle->speed = graphicsRandom.randf(std::max(50.0f, static_cast<float>(size) * 10.0f),
-                                           180.0f + static_cast<float>(size) * 10.0f);
-    particles.push_back(std::move(particle));
+    particles.texture[i] = ghost_textures[size];
+    // Ghosts fly up and to the left.
+    const float speed = graphicsRandom.randf(std::max(50.0f, static_cast<float>(size) * 10.0f),
+                                             180.0f + static_cast<float>(size) * 10.0f);
+    particles.vx[i] = -speed;
+    particles.vy[i] = -speed;
   }
 }
 
@@ -70,13 +77,12 @@ GhostParticleSystem::update(float dt_sec)
   if (!enabled)
     return;
 
-  for (const auto& part : particles) {
-    const auto& particle = dynamic_cast<GhostParticle*>(part.get());
-    particle->pos.y -= particle->speed * dt_sec;
-    particle->pos.x -= particle->speed * dt_sec;
-    if (particle->pos.y > static_cast<float>(SCREEN_HEIGHT)) {
-      particle->pos.y = fmodf(particle->pos.y , virtual_height);
-      particle->pos.x = graphicsRandom.randf(virtual_width);
+  for (size_t i = 0; i < particles.size(); ++i) {
+    particles.x[i] += particles.vx[i] * dt_sec;
+    particles.y[i] += particles.vy[i] * dt_sec;
+    if (particles.y[i] > static_cast<float>(SCREEN_HEIGHT)) {
+      particles.y[i] = fmodf(particles.y[i] , virtual_height);
+      particles.x[i] = graphicsRandom.randf(virtual_width);
     }
   }
 }
@@ -40,7 +40,7 @@ MovingSprite::MovingSprite(const Vector& pos, const std::string& sprite_name_,
   m_sprite_found(false),
   m_custom_layer(false)
 {
-  m_col.m_bbox.set_pos(pos);
+  m_col.set_bbox_pos(pos);
   update_hitbox();
   set_group(collision_group);
 }
@@ -48,7 +48,7 @@ MovingSprite::MovingSprite(const Vector& pos, const std::string& sprite_name_,
 MovingSprite::MovingSprite(const ReaderMapping& reader, const Vector& pos, int layer_, CollisionGroup collision_group) :
   MovingSprite(reader, layer_, collision_group)
 {
-  m_col.m_bbox.set_pos(pos);
+  m_col.set_bbox_pos(pos);
 }
 
 MovingSprite::MovingSprite(const ReaderMapping& reader, const std::string& sprite_name_, int layer_, CollisionGroup collision_group) :
@@ -164,6 +164,20 @@ MovingSprite::set_action(const Direction& dir, int loops)
   update_hitbox();
 }
 
+void
+MovingSprite::set_action(const ActionId& id, int loops)
+{
+  m_sprite->set_action(id, loops);
+  update_hitbox();
+}
+
+void
+MovingSprite::set_action(const ActionId& id, const Direction& dir, int loops)
+{
+  m_sprite->set_action(id, dir, loops);
+  update_hitbox();
+}
+
 void
 MovingSprite::set_action_centered(const std::string& action, int loops)
 {
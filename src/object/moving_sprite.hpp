@@ -132,6 +132,13 @@ public:
    */
   void set_action(const Direction& dir, int loops = -1);
 
+  /** Sets the action by its handle, for objects that set their action
+      every frame. */
+  void set_action(const ActionId& id, int loops = -1);
+
+  /** Sets the action "name-direction" by handles, eg. "walk-left". */
+  void set_action(const ActionId& id, const Direction& dir, int loops = -1);
+
   /** Set new action for sprite and re-center bounding box.  use with
       care as you can easily get stuck when resizing the bounding
       box. */
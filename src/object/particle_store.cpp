@@ -0,0 +1,64 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "object/particle_store.hpp"
+
+#include <assert.h>
+
+ParticleStore::ParticleStore() :
+  x(),
+  y(),
+  vx(),
+  vy(),
+  angle(),
+  alpha(),
+  texture()
+{
+}
+
+void
+ParticleStore::resize(size_t size)
+{
+  x.resize(size, 0.0f);
+  y.resize(size, 0.0f);
+  vx.resize(size, 0.0f);
+  vy.resize(size, 0.0f);
+  angle.resize(size, 0.0f);
+  alpha.resize(size, 0.0f);
+  texture.resize(size, 0);
+}
+
+void
+ParticleStore::remove(size_t index)
+{
+  assert(index < size());
+
+  const size_t last = size() - 1;
+  x[index] = x[last];
+  y[index] = y[last];
+  vx[index] = vx[last];
+  vy[index] = vy[last];
+  angle[index] = angle[last];
+  alpha[index] = alpha[last];
+  texture[index] = texture[last];
+  resize(last);
+}
+
+void
+ParticleStore::clear()
+{
+  resize(0);
+}
@@ -0,0 +1,57 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/** Particles of the built-in particle systems, kept as one array per
+    property, so that updates are plain loops over floats which the
+    compiler can vectorize. The texture of a particle is an index into
+    the texture table of its particle system. */
+class ParticleStore final
+{
+public:
+  ParticleStore();
+
+  inline size_t size() const { return x.size(); }
+  inline bool empty() const { return x.empty(); }
+
+  /** Adds or removes particles at the end, new particles start with
+      all properties at zero. */
+  void resize(size_t size);
+
+  /** Removes particle @c index by moving the last particle into its
+      place, so the order of particles is not kept. */
+  void remove(size_t index);
+
+  void clear();
+
+public:
+  std::vector<float> x;
+  std::vector<float> y;
+  std::vector<float> vx;
+  std::vector<float> vy;
+  std::vector<float> angle;
+  std::vector<float> alpha;
+  std::vector<uint8_t> texture;
+
+private:
+  ParticleStore(const ParticleStore&) = delete;
+  ParticleStore& operator=(const ParticleStore&) = delete;
+};
@@ -16,6 +16,7 @@
 
 #include "object/particlesystem.hpp"
 
+#include <assert.h>
 #include <math.h>
 
 #include <simplesquirrel/class.hpp>
@@ -38,6 +39,7 @@ ParticleSystem::ParticleSystem(const ReaderMapping& reader, float max_particle_s
   max_particle_size(max_particle_size_),
   z_pos(LAYER_BACKGROUND1),
   particles(),
+  textures(),
   virtual_width(static_cast<float>(SCREEN_WIDTH) + max_particle_size * 2.0f),
   virtual_height(static_cast<float>(SCREEN_HEIGHT) + max_particle_size * 2.0f),
   enabled(true)
@@ -50,6 +52,7 @@ ParticleSystem::ParticleSystem(float max_particle_size_) :
   max_particle_size(max_particle_size_),
   z_pos(LAYER_BACKGROUND1),
   particles(),
+  textures(),
   virtual_width(static_cast<float>(SCREEN_WIDTH) + max_particle_size * 2.0f),
   virtual_height(static_cast<float>(SCREEN_HEIGHT) + max_particle_size * 2.0f),
   enabled(true)
@@ -75,6 +78,14 @@ ParticleSystem::~ParticleSystem()
 {
 }
 
+uint8_t
+ParticleSystem::add_texture(const SurfacePtr& texture)
+{
+  assert(textures.size() < 256);
+  textures.push_back(texture);
+  return static_cast<uint8_t>(textures.size() - 1);
+}
+
 void
 ParticleSystem::draw(DrawingContext& context)
 {
@@ -84,43 +95,46 @@ ParticleSystem::draw(DrawingContext& context)
   float scrollx = context.get_translation().x;
   float scrolly = context.get_translation().y;
   const auto& region = Sector::current()->get_active_region();
+  const Vector camera_translation = Sector::get().get_camera().get_translation();
 
   context.push_transform();
   context.set_translation(Vector(max_particle_size,max_particle_size));
 
-  std::unordered_map<SurfacePtr, SurfaceBatch> batches;
-  for (const auto& particle : particles)
+  std::vector<SurfaceBatch> batches;
+  std::vector<float> widths;
+  for (const auto& texture : textures)
+  {
+    batches.emplace_back(texture);
+    widths.push_back(static_cast<float>(texture->get_width()));
+  }
+
+  for (size_t i = 0; i < particles.size(); ++i)
   {
+    const uint8_t texture = particles.texture[i];
+
     // remap x,y coordinates onto screencoordinates
     Vector pos(0.0f, 0.0f);
 
     // horizontal wrap when particle goes off screen to the left
-    const int particle_width = particle->texture->get_width();
-    pos.x = fmodf(particle->pos.x - scrollx, virtual_width);
-    if ((pos.x + static_cast<float>(particle_width)) < 0) pos.x += virtual_width;
+    pos.x = fmodf(particles.x[i] - scrollx, virtual_width);
+    if ((pos.x + widths[texture]) < 0) pos.x += virtual_width;
 
-    pos.y = fmodf(particle->pos.y - scrolly, virtual_height);
+    pos.y = fmodf(particles.y[i] - scrolly, virtual_height);
     if (pos.y < 0) pos.y += virtual_height;
 
-    if(!region.contains(pos + Sector::get().get_camera().get_translation()))
+    if(!region.contains(pos + camera_translation))
       continue;
 
-    //if(pos.x > virtual_width) pos.x -= virtual_width;
-    //if(pos.y > virtual_height) pos.y -= virtual_height;
-
-    auto it = batches.find(particle->texture);
-    if (it == batches.end()) {
-      const auto& batch_it = batches.emplace(particle->texture, SurfaceBatch(particle->texture));
-      batch_it.first->second.draw(pos, particle->angle);
-    } else {
-      it->second.draw(pos, particle->angle);
-    }
+    batches[texture].draw(pos, particles.angle[i]);
   }
 
-  for(auto& it : batches) {
-    auto& surface = it.first;
-    auto& batch = it.second;
-    context.color().draw_surface_batch(surface,
+  for (size_t i = 0; i < batches.size(); ++i)
+  {
+    auto& batch = batches[i];
+    if (batch.empty())
+      continue;
+
+    context.color().draw_surface_batch(textures[i],
                                        batch.move_srcrects(),
                                        batch.move_dstrects(),
                                        batch.move_angles(),
@@ -131,7 +145,6 @@ ParticleSystem::draw(DrawingContext& context)
   context.pop_transform();
 }
 
-
 void
 ParticleSystem::register_class(ssq::VM& vm)
 {
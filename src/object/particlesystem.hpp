@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "math/vector.hpp"
+#include "object/particle_store.hpp"
 #include "video/surface_ptr.hpp"
 
 class ReaderMapping;
@@ -39,7 +40,8 @@ class ReaderMapping;
 
     Classes that implement a particle system should subclass from this
     class, initialize particles in the constructor and move them in the
-    simulate function.
+    simulate function. The built-in systems keep their particles in the
+    ParticleStore, with textures registered through add_texture().
 
  * @scripting
  * @summary A ""ParticleSystem"" that was given a name can be controlled by scripts.
@@ -81,36 +83,15 @@ public:
   int get_layer() const override { return z_pos; }
 
 protected:
-  class Particle
-  {
-  public:
-    Particle() :
-      pos(0.0f, 0.0f),
-      angle(),
-      texture(),
-      alpha(),
-      scale(1.f) // This currently only works in the custom particle system
-    {}
-
-    virtual ~Particle()
-    {}
-
-    Vector pos;
-    // angle at which to draw particle
-    float angle;
-    SurfacePtr texture;
-    float alpha;
-    float scale; // see initializer
-
-  private:
-    Particle(const Particle&) = delete;
-    Particle& operator=(const Particle&) = delete;
-  };
+  /** Adds @c texture to the textures that particles can refer to and
+      returns its index */
+  uint8_t add_texture(const SurfacePtr& texture);
 
 protected:
   float max_particle_size;
   int z_pos;
-  std::vector<std::unique_ptr<Particle> > particles;
+  ParticleStore particles;
+  std::vector<SurfacePtr> textures;
   float virtual_width;
   float virtual_height;
 
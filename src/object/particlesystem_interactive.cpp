@@ -56,26 +56,26 @@ ParticleSystem_Interactive::draw(DrawingContext& context)
 
   context.push_transform();
   const auto& region = Sector::current()->get_active_region();
-  std::unordered_map<SurfacePtr, SurfaceBatch> batches;
-  for (const auto& particle : particles) {
-    if(!region.contains(particle->pos))
+
+  std::vector<SurfaceBatch> batches;
+  for (const auto& texture : textures)
+    batches.emplace_back(texture);
+
+  for (size_t i = 0; i < particles.size(); ++i) {
+    const Vector pos(particles.x[i], particles.y[i]);
+    if(!region.contains(pos))
       continue;
 
-    auto it = batches.find(particle->texture);
-    if (it == batches.end()) {
-      const auto& batch_it = batches.emplace(particle->texture,
-        SurfaceBatch(particle->texture));
-      batch_it.first->second.draw(particle->pos, particle->angle);
-    } else {
-      it->second.draw(particle->pos, particle->angle);
-    }
+    batches[particles.texture[i]].draw(pos, particles.angle[i]);
   }
 
-  for(auto& it : batches) {
-    auto& surface = it.first;
-    auto& batch = it.second;
+  for (size_t i = 0; i < batches.size(); ++i) {
+    auto& batch = batches[i];
+    if (batch.empty())
+      continue;
+
     // FIXME: What is the colour used for?
-    context.color().draw_surface_batch(surface, batch.move_srcrects(),
+    context.color().draw_surface_batch(textures[i], batch.move_srcrects(),
       batch.move_dstrects(), batch.move_angles(), Color::WHITE, z_pos);
   }
 
@@ -83,7 +83,7 @@ ParticleSystem_Interactive::draw(DrawingContext& context)
 }
 
 int
-ParticleSystem_Interactive::collision(Particle* object, const Vector& movement)
+ParticleSystem_Interactive::tile_collision(const Vector& pos, const Vector& movement) const
 {
   using namespace collision;
 
@@ -91,52 +91,80 @@ ParticleSystem_Interactive::collision(Particle* object, const Vector& movement)
   float x1, x2;
   float y1, y2;
 
-  x1 = object->pos.x;
+  x1 = pos.x;
   x2 = x1 + 32 + movement.x;
   if (x2 < x1) {
     x1 = x2;
-    x2 = object->pos.x;
+    x2 = pos.x;
   }
 
-  y1 = object->pos.y;
+  y1 = pos.y;
   y2 = y1 + 32 + movement.y;
   if (y2 < y1) {
     y1 = y2;
-    y2 = object->pos.y;
+    y2 = pos.y;
   }
-  bool water = false;
-
-  // test with all tiles in this rectangle
-  int starttilex = int(x1-1) / 32;
-  int starttiley = int(y1-1) / 32;
-  int max_x = int(x2+1);
-  int max_y = int(y2+1);
 
   Rectf dest(x1, y1, x2, y2);
   dest.move(movement);
   Constraints constraints;
+  const bool water = collect_tile_constraints(dest, true, constraints);
+
+  // TODO don't use magic numbers here...
+
+  // did we collide at all?
+  if (!constraints.has_constraints())
+    return -1;
+
+  const CollisionHit& hit = constraints.hit;
+  if (water) {
+    return 0; //collision with water tile - don't draw splash
+  } else {
+    if (hit.right || hit.left) {
+      return 2; //collision from right
+    } else {
+      return 1; //collision from above
+    }
+  }
+}
+
+bool
+ParticleSystem_Interactive::collect_tile_constraints(const Rectf& dest, bool with_water,
+                                                     collision::Constraints& constraints) const
+{
+  using namespace collision;
+
+  const uint8_t mask = static_cast<uint8_t>(with_water ? TileMap::CELL_SOLID | TileMap::CELL_WATER
+                                                       : TileMap::CELL_SOLID);
+  bool water = false;
 
   for (const auto& solids : Sector::get().get_solid_tilemaps()) {
-    // FIXME Handle a nonzero tilemap offset
-    for (int x = starttilex; x*32 < max_x; ++x) {
-      for (int y = starttiley; y*32 < max_y; ++y) {
-        const Tile& tile = solids->get_tile(x, y);
+    // Tiles that only touch the rectangle still count.
+    const Rect tiles = solids->get_tiles_overlapping(dest.grown(1.f));
+
+    for (int y = tiles.top; y < tiles.bottom; ++y) {
+      if (with_water ? !solids->has_attribute_cells(y, tiles.left, tiles.right)
+                     : !solids->has_solid_cells(y, tiles.left, tiles.right))
+        continue;
 
-        // skip non-solid tiles, except water
-        if (! (tile.get_attributes() & (Tile::WATER | Tile::SOLID)))
+      for (int x = tiles.left; x < tiles.right; ++x) {
+        const uint8_t attributes = solids->get_cell_attributes(x, y);
+        if (!(attributes & mask))
           continue;
 
-        Rectf rect = solids->get_tile_bbox(x, y);
-        if (tile.is_slope ()) { // slope tile
-          AATriangle triangle = AATriangle(rect, tile.get_data());
+        const Rectf rect = solids->get_tile_bbox(x, y);
+        if (attributes & TileMap::CELL_SLOPE) { // slope tile
+          int slope_data = solids->get_tile(x, y).get_data();
+          if (solids->get_flip() & VERTICAL_FLIP)
+            slope_data = AATriangle::vertical_flip(slope_data);
 
-          if (rectangle_aatriangle(&constraints, dest, triangle)) {
-            if (tile.get_attributes() & Tile::WATER)
+          if (rectangle_aatriangle(&constraints, dest, AATriangle(rect, slope_data))) {
+            if (attributes & TileMap::CELL_WATER)
               water = true;
           }
         } else { // normal rectangular tile
           if (dest.overlaps(rect)) {
-            if (tile.get_attributes() & Tile::WATER)
+            if (attributes & TileMap::CELL_WATER)
               water = true;
             set_rectangle_rectangle_constraints(&constraints, dest, rect);
           }
@@ -145,20 +173,5 @@ ParticleSystem_Interactive::collision(Particle* object, const Vector& movement)
     }
   }
 
-  // TODO don't use magic numbers here...
-
-  // did we collide at all?
-  if (!constraints.has_constraints())
-    return -1;
-
-  const CollisionHit& hit = constraints.hit;
-  if (water) {
-    return 0; //collision with water tile - don't draw splash
-  } else {
-    if (hit.right || hit.left) {
-      return 2; //collision from right
-    } else {
-      return 1; //collision from above
-    }
-  }
+  return water;
 }
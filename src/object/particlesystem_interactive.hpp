@@ -20,6 +20,12 @@
 
 #include "math/fwd.hpp"
 
+namespace collision {
+class Constraints;
+}
+
+class Rectf;
+
 /**
    This is an alternative class for particle systems. It is
    responsible for storing a set of particles with each having an x-
@@ -49,7 +55,18 @@ public:
   virtual GameObjectClasses get_class_types() const override { return ParticleSystem::get_class_types().add(typeid(ParticleSystem_Interactive)); }
 
 protected:
-  virtual int collision(Particle* particle, const Vector& movement);
+  /** Checks a particle at @c pos moving by @c movement against the
+      solid tilemaps. Returns -1 without collision, 0 for water, 1 for
+      hits from above and 2 for hits from the side. */
+  int tile_collision(const Vector& pos, const Vector& movement) const;
+
+  /** Adds the constraints of the solid tiles that @c dest touches to
+      @c constraints, and those of water tiles too if @c with_water is
+      set. Returns true if any water tile was hit. Looks at the attribute
+      planes of the tilemaps, so rows without such tiles are skipped
+      without looking at any Tile. */
+  bool collect_tile_constraints(const Rectf& dest, bool with_water,
+                                collision::Constraints& constraints) const;
 
 private:
   ParticleSystem_Interactive(const ParticleSystem_Interactive&) = delete;
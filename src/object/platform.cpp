@@ -65,7 +65,7 @@ Platform::finish_construction()
 
   get_walker()->jump_to_node(m_starting_node);
 
-  m_col.m_bbox.set_pos(m_path_handle.get_pos(m_col.m_bbox.get_size(), get_path()->get_nodes()[m_starting_node].position));
+  m_col.set_bbox_pos(m_path_handle.get_pos(m_col.m_bbox.get_size(), get_path()->get_nodes()[m_starting_node].position));
 }
 
 ObjectSettings
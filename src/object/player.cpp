@@ -154,6 +154,50 @@ const float BUTTJUMP_SPEED = 800.f;
 const int MAX_FIRE_BULLETS = 2;
 const int MAX_ICE_BULLETS  = 2;
 
+/* Sprite actions, draw() sets one of the form "bonus-pose-direction"
+   every frame */
+const ActionId BIG_ACTION("big");
+const ActionId FIRE_ACTION("fire");
+const ActionId ICE_ACTION("ice");
+const ActionId AIR_ACTION("air");
+const ActionId EARTH_ACTION("earth");
+const ActionId SMALL_ACTION("small");
+
+const ActionId GAMEOVER_ACTION("gameover");
+const ActionId EARTH_STONE_ACTION("earth-stone");
+const ActionId GROW_ACTION("grow");
+const ActionId SWIMGROW_ACTION("swimgrow");
+const ActionId SLIDEGROW_ACTION("slidegrow");
+const ActionId CLIMBGROW_ACTION("climbgrow");
+
+const ActionId CLIMB_ACTION("climb");
+const ActionId BACKFLIP_ACTION("backflip");
+const ActionId SLIDEJUMP_ACTION("slidejump");
+const ActionId SLIDE_ACTION("slide");
+const ActionId DUCK_ACTION("duck");
+const ActionId CRAWL_ACTION("crawl");
+const ActionId SKID_ACTION("skid");
+const ActionId KICK_ACTION("kick");
+const ActionId STOMP_ACTION("stomp");
+const ActionId BUTTJUMP_ACTION("buttjump");
+const ActionId WALLJUMP_ACTION("walljump");
+const ActionId FLOAT_ACTION("float");
+const ActionId SWIMJUMP_ACTION("swimjump");
+const ActionId BOOST_ACTION("boost");
+const ActionId SWIM_ACTION("swim");
+const ActionId FALL_ACTION("fall");
+const ActionId JUMP_ACTION("jump");
+const ActionId RUN_ACTION("run");
+const ActionId WALK_ACTION("walk");
+
+/** The actions of IDLE_STAGES */
+const std::vector<ActionId> IDLE_STAGE_ACTIONS
+({
+  ActionId(IDLE_STAGES[0]),
+  ActionId(IDLE_STAGES[1]),
+  ActionId(IDLE_STAGES[2])
+});
+
 } // namespace
 
 Player::Player(PlayerStatus& player_status, const std::string& name_, int player_id) :
@@ -2051,74 +2095,79 @@ Player::draw(DrawingContext& context)
     context.color().draw_surface(m_airarrow, Vector(px, py), LAYER_HUD - 1);
   }
 
-  std::string sa_prefix = "";
-  std::string sa_postfix = "";
+  ActionId sa_prefix;
+  Direction sa_dir;
 
   if (get_bonus() == BONUS_GROWUP)
-    sa_prefix = "big";
+    sa_prefix = BIG_ACTION;
   else if (get_bonus() == BONUS_FIRE)
-    sa_prefix = "fire";
+    sa_prefix = FIRE_ACTION;
   else if (get_bonus() == BONUS_ICE)
-    sa_prefix = "ice";
+    sa_prefix = ICE_ACTION;
   else if (get_bonus() == BONUS_AIR)
-    sa_prefix = "air";
+    sa_prefix = AIR_ACTION;
   else if (get_bonus() == BONUS_EARTH)
-    sa_prefix = "earth";
+    sa_prefix = EARTH_ACTION;
   else
-    sa_prefix = "small";
+    sa_prefix = SMALL_ACTION;
   if (!m_swimming && !m_water_jump)
   {
-    sa_postfix = (m_dir == Direction::RIGHT) ? "-right" : "-left";
+    sa_dir = (m_dir == Direction::RIGHT) ? Direction::RIGHT : Direction::LEFT;
   }
   else
   {
-    sa_postfix = ((std::abs(m_swimming_angle) <= math::PI_2)
+    sa_dir = ((std::abs(m_swimming_angle) <= math::PI_2)
       || (m_water_jump && std::abs(m_physic.get_velocity_x()) < 10.f))
-      ? "-right" : "-left";
+      ? Direction::RIGHT : Direction::LEFT;
   }
 
+  // "bonus-pose-direction", e.g. "big-walk-left"
+  const auto tux_action = [&sa_prefix, &sa_dir](const ActionId& pose) {
+    return ActionId::join(sa_prefix, pose).with_direction(sa_dir);
+  };
+
   /* Set Tux sprite action */
   if (m_dying) {
     m_sprite->set_angle(0.0f);
-    m_sprite->set_action("gameover");
+    m_sprite->set_action(GAMEOVER_ACTION);
   }
   else if (m_growing)
   {
     // while growing, do not change action
     // do_duck() will take care of cancelling growing manually
     // update() will take care of cancelling when growing completed
-    std::string action = "grow";
+    ActionId action = GROW_ACTION;
     if (m_swimming || m_water_jump) {
-      action = "swimgrow";
+      action = SWIMGROW_ACTION;
     }
     else if (m_sliding) {
-      action = "slidegrow";
+      action = SLIDEGROW_ACTION;
     }
     else if (m_climbing) {
-      action = "climbgrow";
+      action = CLIMBGROW_ACTION;
     }
-    m_sprite->set_action(action + sa_postfix, Sprite::LOOPS_CONTINUED);
+    m_sprite->set_action(action, sa_dir, Sprite::LOOPS_CONTINUED);
   }
   else if (m_stone) {
-    m_sprite->set_action("earth-stone");
+    m_sprite->set_action(EARTH_STONE_ACTION);
   }
   else if (m_climbing) {
-    m_sprite->set_action(sa_prefix+"-climb"+sa_postfix);
+    m_sprite->set_action(tux_action(CLIMB_ACTION));
 
     // Avoid flickering briefly after growing on ladder
     if ((m_physic.get_velocity_x()==0)&&(m_physic.get_velocity_y()==0))
       m_sprite->pause_animation();
   }
   else if (m_backflipping) {
-    m_sprite->set_action(sa_prefix+"-backflip"+sa_postfix);
+    m_sprite->set_action(tux_action(BACKFLIP_ACTION));
   }
   else if (m_sliding) {
     if (m_jumping || m_is_slidejump_falling) {
-      m_sprite->set_action(sa_prefix +"-slidejump"+ sa_postfix);
+      m_sprite->set_action(tux_action(SLIDEJUMP_ACTION));
     }
     else {
       const bool was_growing_before = (m_sprite->get_action().substr(0, 9) == "slidegrow");
-      m_sprite->set_action(sa_prefix + "-slide" + sa_postfix);
+      m_sprite->set_action(tux_action(SLIDE_ACTION));
       if (m_was_crawling_before_slide || was_growing_before)
       {
         m_sprite->set_frame(m_sprite->get_frames()); // Skip the "duck" animation when coming from crawling or slidegrowing
@@ -2127,13 +2176,13 @@ Player::draw(DrawingContext& context)
     }
   }
   else if (m_duck && is_big() && !m_swimming && !m_crawl && !m_stone) {
-    m_sprite->set_action(sa_prefix+"-duck"+sa_postfix);
+    m_sprite->set_action(tux_action(DUCK_ACTION));
   }
   else if (m_crawl)
   {
     if (on_ground())
     {
-      m_sprite->set_action(sa_prefix + "-crawl" + sa_postfix);
+      m_sprite->set_action(tux_action(CRAWL_ACTION));
       if (m_physic.get_velocity_x() != 0.f) {
         m_sprite->resume_animation();
       }
@@ -2142,26 +2191,27 @@ Player::draw(DrawingContext& context)
       }
     }
     else {
-      m_sprite->set_action(sa_prefix + "-slidejump" + sa_postfix);
+      m_sprite->set_action(tux_action(SLIDEJUMP_ACTION));
     }
   }
   else if (m_skidding_timer.started() && !m_skidding_timer.check() && !m_swimming) {
-    m_sprite->set_action(sa_prefix + "-skid" + sa_postfix);
+    m_sprite->set_action(tux_action(SKID_ACTION));
   }
   else if (m_kick_timer.started() && !m_kick_timer.check() && !m_swimming && !m_water_jump) {
-    m_sprite->set_action(sa_prefix+"-kick"+sa_postfix);
+    m_sprite->set_action(tux_action(KICK_ACTION));
   }
   else if ((m_wants_buttjump || m_does_buttjump) && is_big() && !m_water_jump) {
     if (m_buttjump_stomp) {
-      m_sprite->set_action(sa_prefix + "-stomp" + sa_postfix, 1);
+      m_sprite->set_action(tux_action(STOMP_ACTION), 1);
     }
     else {
-      m_sprite->set_action(sa_prefix + "-buttjump" + sa_postfix, 1);
+      m_sprite->set_action(tux_action(BUTTJUMP_ACTION), 1);
     }
   }
   else if ((m_controller->hold(Control::LEFT) || m_controller->hold(Control::RIGHT)) && m_can_walljump)
   {
-    m_sprite->set_action(sa_prefix+"-walljump"+(m_on_left_wall ? "-left" : "-right"), 1);
+    m_sprite->set_action(ActionId::join(sa_prefix, WALLJUMP_ACTION),
+                         m_on_left_wall ? Direction::LEFT : Direction::RIGHT, 1);
   }
   else if (!on_ground() || m_fall_mode != ON_GROUND)
   {
@@ -2172,20 +2222,20 @@ Player::draw(DrawingContext& context)
         if (m_water_jump && m_dir != m_old_dir)
           log_debug << "Obracanko (:" << std::endl;
         if (glm::length(m_physic.get_velocity()) < 50.f)
-          m_sprite->set_action(sa_prefix + "-float" + sa_postfix);
+          m_sprite->set_action(tux_action(FLOAT_ACTION));
         else if (m_water_jump)
-          m_sprite->set_action(sa_prefix + "-swimjump" + sa_postfix);
+          m_sprite->set_action(tux_action(SWIMJUMP_ACTION));
         else if (m_swimboosting)
-          m_sprite->set_action(sa_prefix + "-boost" + sa_postfix);
+          m_sprite->set_action(tux_action(BOOST_ACTION));
         else
-          m_sprite->set_action(sa_prefix + "-swim" + sa_postfix);
+          m_sprite->set_action(tux_action(SWIM_ACTION));
       }
       else
       {
         if (m_physic.get_velocity_y() > 0)
-          m_sprite->set_action(sa_prefix + "-fall" + sa_postfix);
+          m_sprite->set_action(tux_action(FALL_ACTION));
         else if (m_physic.get_velocity_y() <= 0)
-          m_sprite->set_action(sa_prefix + "-jump" + sa_postfix);
+          m_sprite->set_action(tux_action(JUMP_ACTION));
       }
     }
   }
@@ -2200,7 +2250,7 @@ Player::draw(DrawingContext& context)
       {
         m_idle_stage = 0;
         m_idle_timer.start(static_cast<float>(TIME_UNTIL_IDLE) / 1000.0f);
-        m_sprite->set_action(sa_prefix + ("-" + IDLE_STAGES[m_idle_stage]) + sa_postfix, Sprite::LOOPS_CONTINUED);
+        m_sprite->set_action(tux_action(IDLE_STAGE_ACTIONS[m_idle_stage]), Sprite::LOOPS_CONTINUED);
 
         if (!m_should_fancy_idle)
         {
@@ -2219,19 +2269,19 @@ Player::draw(DrawingContext& context)
           if (m_idle_stage >= static_cast<unsigned int>(IDLE_STAGES.size()))
           {
             m_idle_stage = static_cast<int>(IDLE_STAGES.size()) - 1;
-            m_sprite->set_action(sa_prefix + ("-" + IDLE_STAGES[m_idle_stage]) + sa_postfix);
+            m_sprite->set_action(tux_action(IDLE_STAGE_ACTIONS[m_idle_stage]));
             m_sprite->set_animation_loops(-1);
           }
           else
-            m_sprite->set_action(sa_prefix + ("-" + IDLE_STAGES[m_idle_stage]) + sa_postfix, 1);
+            m_sprite->set_action(tux_action(IDLE_STAGE_ACTIONS[m_idle_stage]), 1);
         }
       }
       else
       {
-        if (m_idle_stage != 0 || m_sprite->get_action() != sa_prefix + ("-" + IDLE_STAGES[0]) + sa_postfix)
+        if (m_idle_stage != 0 || m_sprite->get_action_id() != tux_action(IDLE_STAGE_ACTIONS[0]))
         {
           m_idle_stage = 0;
-          m_sprite->set_action(sa_prefix + ("-" + IDLE_STAGES[0]) + sa_postfix);
+          m_sprite->set_action(tux_action(IDLE_STAGE_ACTIONS[0]));
           m_sprite->set_animation_loops(-1);
         }
         m_fancy_idle_active = false;
@@ -2240,9 +2290,9 @@ Player::draw(DrawingContext& context)
     else
     {
       if (std::abs(m_physic.get_velocity_x()) >= MAX_RUN_XM - 3)
-        m_sprite->set_action(sa_prefix + "-run" + sa_postfix);
+        m_sprite->set_action(tux_action(RUN_ACTION));
       else
-        m_sprite->set_action(sa_prefix + "-walk" + sa_postfix);
+        m_sprite->set_action(tux_action(WALK_ACTION));
 
       m_fancy_idle_active = false;
     }
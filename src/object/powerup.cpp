@@ -27,6 +27,10 @@
 #include "supertux/sector.hpp"
 #include "util/reader_mapping.hpp"
 
+const std::vector<std::string> PowerUp::s_preload_sounds = {
+  "sounds/grow.ogg", "sounds/fire-flower.wav", "sounds/gulp.wav"
+};
+
 PowerUp::PowerUp(const ReaderMapping& mapping) :
   MovingSprite(mapping, "images/powerups/egg/egg.sprite", LAYER_OBJECTS, COLGROUP_MOVING),
   physic(),
@@ -106,9 +110,8 @@ void
 PowerUp::initialize()
 {
   physic.enable_gravity(true);
-  SoundManager::current()->preload("sounds/grow.ogg");
-  SoundManager::current()->preload("sounds/fire-flower.wav");
-  SoundManager::current()->preload("sounds/gulp.wav");
+  for (const auto& sound : s_preload_sounds)
+    SoundManager::current()->preload(sound);
 
   // Older levels utilize hardcoded behaviour from the chosen sprite
   if (get_version() == 1)
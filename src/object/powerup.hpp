@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "object/moving_sprite.hpp"
 #include "supertux/physic.hpp"
 
@@ -49,6 +51,10 @@ public:
   virtual void on_flip(float height) override;
   virtual HitResponse collision(MovingObject& other, const CollisionHit& hit) override;
 
+  /** The sounds that initialize() preloads, AssetPrefetch starts loading
+      them for levels that contain the object. */
+  static const std::vector<std::string> s_preload_sounds;
+
   static std::string class_name() { return "powerup"; }
   virtual std::string get_class_name() const override { return class_name(); }
   static std::string display_name() { return _("Powerup"); }
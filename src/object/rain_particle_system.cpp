@@ -16,6 +16,7 @@
 
 #include "object/rain_particle_system.hpp"
 
+#include <algorithm>
 #include <assert.h>
 #include <math.h>
 
@@ -36,6 +37,8 @@
 #include "video/viewport.hpp"
 
 RainParticleSystem::RainParticleSystem() :
+  m_rain_textures(),
+  m_speeds(),
   m_current_speed(1.f),
   m_target_speed(1.f),
   m_speed_fade_time_remaining(0.f),
@@ -55,6 +58,8 @@ RainParticleSystem::RainParticleSystem() :
 
 RainParticleSystem::RainParticleSystem(const ReaderMapping& reader) :
   ParticleSystem_Interactive(reader),
+  m_rain_textures(),
+  m_speeds(),
   m_current_speed(1.f),
   m_target_speed(1.f),
   m_speed_fade_time_remaining(0.f),
@@ -83,6 +88,8 @@ void RainParticleSystem::init()
 {
   rainimages[0] = Surface::from_file("images/particles/rain0.png");
   rainimages[1] = Surface::from_file("images/particles/rain1.png");
+  m_rain_textures[0] = add_texture(rainimages[0]);
+  m_rain_textures[1] = add_texture(rainimages[1]);
 
   virtual_width = static_cast<float>(SCREEN_WIDTH) * 2.0f;
 
@@ -114,21 +121,23 @@ void RainParticleSystem::set_amount(float amount)
   int delta = new_raindropcount - old_raindropcount;
 
   if (delta > 0) {
-    for (int i=0; i<delta; ++i) {
-      auto particle = std::make_unique<RainParticle>();
-      particle->pos.x = static_cast<float>(graphicsRandom.rand(int(virtual_width)));
-      particle->pos.y = static_cast<float>(graphicsRandom.rand(int(virtual_height)));
+    const size_t old_size = particles.size();
+    particles.resize(old_size + delta);
+    m_speeds.resize(old_size + delta);
+    for (size_t i = old_size; i < particles.size(); ++i) {
+      particles.x[i] = static_cast<float>(graphicsRandom.rand(int(virtual_width)));
+      particles.y[i] = static_cast<float>(graphicsRandom.rand(int(virtual_height)));
       int rainsize = graphicsRandom.rand(2);
-      particle->texture = rainimages[rainsize];
+      particles.texture[i] = m_rain_textures[rainsize];
       do {
-        particle->speed = ((static_cast<float>(rainsize) + 1.0f) * 45.0f + graphicsRandom.randf(3.6f));
-      } while(particle->speed < 1);
-      particles.push_back(std::move(particle));
+        m_speeds[i] = ((static_cast<float>(rainsize) + 1.0f) * 45.0f + graphicsRandom.randf(3.6f));
+      } while(m_speeds[i] < 1);
+      update_velocity(i);
     }
   } else if (delta < 0) {
-    for (int i=0; i>delta; --i) {
-      particles.pop_back();
-    }
+    const size_t new_size = particles.size() - std::min(particles.size(), static_cast<size_t>(-delta));
+    particles.resize(new_size);
+    m_speeds.resize(new_size);
   }
 
   m_current_real_amount = real_amount;
@@ -136,8 +145,18 @@ void RainParticleSystem::set_amount(float amount)
 
 void RainParticleSystem::set_angle(float angle)
 {
-  for (const auto& particle : particles)
-    particle->angle = angle;
+  for (size_t i = 0; i < particles.size(); ++i)
+  {
+    particles.angle[i] = angle;
+    update_velocity(i);
+  }
+}
+
+void RainParticleSystem::update_velocity(size_t index)
+{
+  const float angle = (particles.angle[index] + 45.f) * 3.14159265f / 180.f;
+  particles.vx[index] = -m_speeds[index] * sinf(angle);
+  particles.vy[index] = m_speeds[index] * cosf(angle);
 }
 
 void RainParticleSystem::update(float dt_sec)
@@ -198,37 +217,44 @@ void RainParticleSystem::update(float dt_sec)
   float abs_x = cam_translation.x;
   float abs_y = cam_translation.y;
 
-  for (auto& it : particles) {
-    auto particle = static_cast<RainParticle*>(it.get());
+  // Move all drops first, this loop is plain arithmetic.
+  const size_t count = particles.size();
+  float* x = particles.x.data();
+  float* y = particles.y.data();
+  const float* vx = particles.vx.data();
+  const float* vy = particles.vy.data();
+  for (size_t i = 0; i < count; ++i) {
+    x[i] += vx[i] * movement_multiplier;
+    y[i] += vy[i] * movement_multiplier;
+  }
 
-    float movement = particle->speed * movement_multiplier;
-    particle->pos.y += movement * cosf((particle->angle + 45.f) * 3.14159265f / 180.f);
-    particle->pos.x -= movement * sinf((particle->angle + 45.f) * 3.14159265f / 180.f);
-    int col = collision(particle, Vector(-movement, movement));
-    if ((particle->pos.y > static_cast<float>(SCREEN_HEIGHT) + abs_y) || (col >= 0)) {
+  for (size_t i = 0; i < count; ++i) {
+    float movement = m_speeds[i] * movement_multiplier;
+    int col = tile_collision(Vector(x[i], y[i]), Vector(-movement, movement));
+    if ((y[i] > static_cast<float>(SCREEN_HEIGHT) + abs_y) || (col >= 0)) {
       //Create rainsplash
-      if ((particle->pos.y <= static_cast<float>(SCREEN_HEIGHT) + abs_y) && (col >= 1)){
+      if ((y[i] <= static_cast<float>(SCREEN_HEIGHT) + abs_y) && (col >= 1)){
         bool vertical = (col == 2);
         if (!vertical) { //check if collision happened from above
           int splash_x, splash_y; // move outside if statement when
                                   // uncommenting the else statement below.
-          splash_x = int(particle->pos.x);
-          splash_y = int(particle->pos.y) - (int(particle->pos.y) % 32) + 32;
+          splash_x = int(x[i]);
+          splash_y = int(y[i]) - (int(y[i]) % 32) + 32;
           Sector::get().add<RainSplash>(Vector(static_cast<float>(splash_x), static_cast<float>(splash_y)),
                                              vertical);
         }
         // Uncomment the following to display vertical splashes, too
         /* else {
-           splash_x = int(particle->pos.x) - (int(particle->pos.x) % 32) + 32;
-           splash_y = int(particle->pos.y);
+           splash_x = int(x[i]) - (int(x[i]) % 32) + 32;
+           splash_y = int(y[i]);
            Sector::get().add<RainSplash>(Vector(splash_x, splash_y),vertical);
            } */
       }
       int new_x = graphicsRandom.rand(int(virtual_width)) + int(abs_x);
       int new_y = 0;
       //FIXME: Don't move particles over solid tiles
-      particle->pos.x = static_cast<float>(new_x);
-      particle->pos.y = static_cast<float>(new_y);
+      x[i] = static_cast<float>(new_x);
+      y[i] = static_cast<float>(new_y);
     }
   }
 }
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "object/particlesystem_interactive.hpp"
 
 #include "math/easing.hpp"
@@ -94,18 +96,16 @@ private:
   void set_amount(float amount);
   void set_angle(float angle);
 
-private:
-  class RainParticle : public Particle
-  {
-  public:
-    float speed;
-
-    RainParticle() :
-      speed()
-    {}
-  };
+  /** Derives the velocity of particle @c index from its speed and angle */
+  void update_velocity(size_t index);
 
+private:
   SurfacePtr rainimages[2];
+  uint8_t m_rain_textures[2];
+
+  // Falling speed of every particle, the ParticleStore holds the
+  // velocity that results from it and the angle.
+  std::vector<float> m_speeds;
 
   float m_current_speed;
   float m_target_speed;
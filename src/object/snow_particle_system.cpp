@@ -40,7 +40,13 @@ SnowParticleSystem::SnowParticleSystem() :
   m_epsilon(),
   m_spin_speed(),
   m_state_length(),
-  m_snowimages()
+  m_snowimages(),
+  m_wobble(),
+  m_anchor_x(),
+  m_spin(),
+  m_flake_size(),
+  m_drift_noise(),
+  m_wobble_noise()
 {
   init();
 }
@@ -55,7 +61,13 @@ SnowParticleSystem::SnowParticleSystem(const ReaderMapping& reader) :
   m_epsilon(),
   m_spin_speed(),
   m_state_length(),
-  m_snowimages()
+  m_snowimages(),
+  m_wobble(),
+  m_anchor_x(),
+  m_spin(),
+  m_flake_size(),
+  m_drift_noise(),
+  m_wobble_noise()
 {
   reader.get("state_length", m_state_length, 5.0f);
   reader.get("wind_speed", m_wind_speed, 30.0f);
@@ -79,30 +91,38 @@ SnowParticleSystem::init()
 
   m_timer.start(.01f);
 
+  const uint8_t snow_textures[3] = {
+    add_texture(m_snowimages[0]),
+    add_texture(m_snowimages[1]),
+    add_texture(m_snowimages[2])
+  };
+
   // Create random snowflakes.
   int snowflakecount = static_cast<int>(virtual_width / 10.0f);
+  particles.resize(snowflakecount);
+  m_wobble.resize(snowflakecount);
+  m_anchor_x.resize(snowflakecount);
+  m_spin.resize(snowflakecount);
+  m_flake_size.resize(snowflakecount);
   for (int i = 0; i < snowflakecount; ++i)
   {
-    auto particle = std::make_unique<SnowParticle>();
     int snowsize = graphicsRandom.rand(3);
 
-    particle->pos.x = graphicsRandom.randf(virtual_width);
-    particle->pos.y = graphicsRandom.randf(static_cast<float>(SCREEN_HEIGHT));
-    particle->anchorx = particle->pos.x + (graphicsRandom.randf(-0.5, 0.5) * 16);
+    particles.x[i] = graphicsRandom.randf(virtual_width);
+    particles.y[i] = graphicsRandom.randf(static_cast<float>(SCREEN_HEIGHT));
+    m_anchor_x[i] = particles.x[i] + (graphicsRandom.randf(-0.5, 0.5) * 16);
     // Drift will change with wind gusts.
-    particle->drift_speed = graphicsRandom.randf(-0.5f, 0.5f) * 0.3f;
-    particle->wobble = 0.0;
+    particles.vx[i] = graphicsRandom.randf(-0.5f, 0.5f) * 0.3f;
+    m_wobble[i] = 0.0;
 
-    particle->texture = m_snowimages[snowsize];
-    particle->flake_size = static_cast<int>(powf(static_cast<float>(snowsize) + 3.0f, 4.0f)); // Since it ranges from 0 to 2.
+    particles.texture[i] = snow_textures[snowsize];
+    m_flake_size[i] = static_cast<float>(static_cast<int>(powf(static_cast<float>(snowsize) + 3.0f, 4.0f))); // Since it ranges from 0 to 2.
 
-    particle->speed = 6.32f * (1.0f + (2.0f - static_cast<float>(snowsize)) / 2.0f + graphicsRandom.randf(1.8f));
+    particles.vy[i] = 6.32f * (1.0f + (2.0f - static_cast<float>(snowsize)) / 2.0f + graphicsRandom.randf(1.8f));
 
     // Spinning.
-    particle->angle = graphicsRandom.randf(360.0);
-    particle->spin_speed = graphicsRandom.randf(-m_spin_speed, m_spin_speed);
-
-    particles.push_back(std::move(particle));
+    particles.angle[i] = graphicsRandom.randf(360.0);
+    m_spin[i] = graphicsRandom.randf(-m_spin_speed, m_spin_speed);
   }
 }
 
@@ -164,28 +184,45 @@ SnowParticleSystem::update(float dt_sec)
       assert(false);
   }
 
-  float sq_g = sqrtf(Sector::get().get_gravity());
+  const float sq_g = sqrtf(Sector::get().get_gravity());
+  const size_t count = particles.size();
 
-  for (auto& part : particles)
+  // Draw the random changes up front, so that the loop below is plain
+  // arithmetic.
+  m_drift_noise.resize(count);
+  m_wobble_noise.resize(count);
+  for (size_t i = 0; i < count; ++i)
   {
-    auto particle = dynamic_cast<SnowParticle*>(part.get());
-    if (!particle)
-      continue;
-
-    float anchor_delta;
+    m_drift_noise[i] = graphicsRandom.randf(-m_epsilon, m_epsilon);
+    m_wobble_noise[i] = graphicsRandom.randf(-m_epsilon, m_epsilon);
+  }
 
+  float* x = particles.x.data();
+  float* y = particles.y.data();
+  float* drift_speed = particles.vx.data();
+  const float* speed = particles.vy.data();
+  float* angle = particles.angle.data();
+  float* wobble = m_wobble.data();
+  float* anchor_x = m_anchor_x.data();
+  const float* spin = m_spin.data();
+  const float* flake_size = m_flake_size.data();
+  const float* drift_noise = m_drift_noise.data();
+  const float* wobble_noise = m_wobble_noise.data();
+  const float gust = m_gust_current_velocity;
+
+  for (size_t i = 0; i < count; ++i)
+  {
     // Falling.
-    particle->pos.y += particle->speed * dt_sec * sq_g;
+    y[i] += speed[i] * dt_sec * sq_g;
     // Drifting (speed approaches wind at a rate dependent on flake size).
-    particle->drift_speed += (m_gust_current_velocity - particle->drift_speed) / static_cast<float>(particle->flake_size) + graphicsRandom.randf(-m_epsilon, m_epsilon);
-    particle->anchorx += particle->drift_speed * dt_sec;
+    drift_speed[i] += (gust - drift_speed[i]) / flake_size[i] + drift_noise[i];
+    anchor_x[i] += drift_speed[i] * dt_sec;
     // Wobbling (particle approaches anchorx).
-    particle->pos.x += particle->wobble * dt_sec * sq_g;
-    anchor_delta = (particle->anchorx - particle->pos.x);
-    particle->wobble += (WOBBLE_FACTOR * anchor_delta) + graphicsRandom.randf(-m_epsilon, m_epsilon);
-    particle->wobble *= WOBBLE_DECAY;
-    // Spinning.
-    particle->angle += particle->spin_speed * dt_sec;
-    particle->angle = fmodf(particle->angle, 360.0);
+    x[i] += wobble[i] * dt_sec * sq_g;
+    const float anchor_delta = anchor_x[i] - x[i];
+    wobble[i] = (wobble[i] + (WOBBLE_FACTOR * anchor_delta + wobble_noise[i])) * WOBBLE_DECAY;
+    // Spinning, same as fmodf(angle, 360), but without a library call.
+    angle[i] += spin[i] * dt_sec;
+    angle[i] -= 360.0f * truncf(angle[i] / 360.0f);
   }
 }
@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "object/particlesystem.hpp"
 #include "supertux/timer.hpp"
 
@@ -46,30 +48,6 @@ public:
 private:
   void init();
 
-  class SnowParticle : public Particle
-  {
-  public:
-    float speed;
-    float wobble;
-    float anchorx;
-    float drift_speed;
-
-    // Turning speed.
-    float spin_speed;
-
-    // For inertia.
-    unsigned int flake_size;
-
-    SnowParticle() :
-      speed(),
-      wobble(),
-      anchorx(),
-      drift_speed(),
-      spin_speed(),
-      flake_size()
-    {}
-  };
-
   // Wind is simulated in discrete "gusts",
   // gust states:
   enum State {
@@ -100,6 +78,17 @@ private:
 
   SurfacePtr m_snowimages[3];
 
+  // Per particle data next to the ParticleStore, which holds the
+  // falling speed in vy and the drift speed in vx.
+  std::vector<float> m_wobble;
+  std::vector<float> m_anchor_x;
+  std::vector<float> m_spin; // Turning speed.
+  std::vector<float> m_flake_size; // For inertia.
+
+  // Random changes of drift and wobble for the current frame.
+  std::vector<float> m_drift_noise;
+  std::vector<float> m_wobble_noise;
+
 private:
   SnowParticleSystem(const SnowParticleSystem&) = delete;
   SnowParticleSystem& operator=(const SnowParticleSystem&) = delete;
@@ -71,7 +71,7 @@ Spotlight::Spotlight(const ReaderMapping& mapping) :
 
   mapping.get("x", m_col.m_bbox.get_left(), 0.0f);
   mapping.get("y", m_col.m_bbox.get_top(), 0.0f);
-  m_col.m_bbox.set_size(32, 32);
+  m_col.set_bbox_size(32, 32);
 
   mapping.get("angle", m_angle, 0.0f);
   mapping.get("speed", m_speed, 50.0f);
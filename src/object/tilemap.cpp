@@ -16,8 +16,6 @@
 
 #include "object/tilemap.hpp"
 
-#include <tuple>
-
 #include <simplesquirrel/class.hpp>
 #include <simplesquirrel/vm.hpp>
 
@@ -40,12 +38,22 @@
 #include "video/drawing_context.hpp"
 #include "video/layer.hpp"
 #include "video/surface.hpp"
+#include "video/texture_mesh.hpp"
 
 TileMap::TileMap(const TileSet *new_tileset) :
   PathObject(),
   m_editor_active(true),
   m_tileset(new_tileset),
   m_tiles(),
+  m_cell_attributes(),
+  m_solid_cells(),
+  m_attribute_cells(),
+  m_cell_words_per_row(0),
+  m_cell_attributes_valid(false),
+  m_chunks(),
+  m_chunks_width(0),
+  m_chunks_valid(false),
+  m_chunks_editor(false),
   m_real_solid(false),
   m_effective_solid(false),
   m_speed_x(1),
@@ -80,6 +88,15 @@ TileMap::TileMap(const TileSet *tileset_, const ReaderMapping& reader) :
   m_editor_active(true),
   m_tileset(tileset_),
   m_tiles(),
+  m_cell_attributes(),
+  m_solid_cells(),
+  m_attribute_cells(),
+  m_cell_words_per_row(0),
+  m_cell_attributes_valid(false),
+  m_chunks(),
+  m_chunks_width(0),
+  m_chunks_valid(false),
+  m_chunks_editor(false),
   m_real_solid(false),
   m_effective_solid(false),
   m_speed_x(1),
@@ -207,6 +224,7 @@ TileMap::parse_tiles(const ReaderMapping& reader)
   m_new_size_y = m_height;
   m_new_offset_x = 0;
   m_new_offset_y = 0;
+  tiles_changed();
 }
 
 void
@@ -470,7 +488,7 @@ TileMap::update(float dt_sec)
     }
   }
 
-  m_objects_hit_bottom.clear();
+  clear_bottom_collision_list();
 }
 
 void
@@ -550,60 +568,64 @@ TileMap::draw(DrawingContext& context)
   Rect t_draw_rect = get_tiles_overlapping(draw_rect);
   Vector start = get_tile_position(t_draw_rect.left, t_draw_rect.top);
 
-  Vector pos(0.0f, 0.0f);
-  int tx, ty;
+  const bool draw_collision_rects = g_debug.show_collision_rects && m_real_solid;
+  const bool draw_deprecated = Editor::is_active() && m_editor_active && g_config->editor_show_deprecated_tiles;
 
-  std::unordered_map<SurfacePtr,
-                     std::tuple<std::vector<Rectf>,
-                                std::vector<Rectf>>> batches;
+  if (draw_collision_rects || draw_deprecated)
+  {
+    Vector pos(0.0f, 0.0f);
+    int tx, ty;
 
-  for (pos.x = start.x, tx = t_draw_rect.left; tx < t_draw_rect.right; pos.x += 32, ++tx) {
-    for (pos.y = start.y, ty = t_draw_rect.top; ty < t_draw_rect.bottom; pos.y += 32, ++ty) {
-      int index = ty*m_width + tx;
-      assert (index >= 0);
-      assert (index < (m_width * m_height));
+    for (pos.x = start.x, tx = t_draw_rect.left; tx < t_draw_rect.right; pos.x += 32, ++tx) {
+      for (pos.y = start.y, ty = t_draw_rect.top; ty < t_draw_rect.bottom; pos.y += 32, ++ty) {
+        int index = ty*m_width + tx;
+        assert (index >= 0);
+        assert (index < (m_width * m_height));
 
-      if (m_tiles[index] == 0) continue;
-      const Tile& tile = m_tileset->get(m_tiles[index]);
-
-	  if (g_debug.show_collision_rects && m_real_solid) {
-        tile.draw_debug(context.color(), pos, LAYER_FOREGROUND1);
-      }
+        if (m_tiles[index] == 0) continue;
+        const Tile& tile = m_tileset->get(m_tiles[index]);
 
-      // If the tilemap is active in editor and showing deprecated tiles is enabled, draw indication over each deprecated tile
-      if (Editor::is_active() && m_editor_active &&
-          g_config->editor_show_deprecated_tiles && tile.is_deprecated())
-      {
-        context.color().draw_text(Resources::normal_font, "!", pos + Vector(16, 8),
-                                  ALIGN_CENTER, LAYER_GUI - 10, Color::RED);
-      }
+        if (draw_collision_rects) {
+          tile.draw_debug(context.color(), pos, LAYER_FOREGROUND1);
+        }
 
-      const SurfacePtr& surface = Editor::is_active() ? tile.get_current_editor_surface() : tile.get_current_surface();
-      if (surface) {
-        std::get<0>(batches[surface]).emplace_back(surface->get_region());
-        std::get<1>(batches[surface]).emplace_back(pos,
-                                                   Sizef(static_cast<float>(surface->get_width()),
-                                                         static_cast<float>(surface->get_height())));
+        // If the tilemap is active in editor and showing deprecated tiles is enabled, draw indication over each deprecated tile
+        if (draw_deprecated && tile.is_deprecated())
+        {
+          context.color().draw_text(Resources::normal_font, "!", pos + Vector(16, 8),
+                                    ALIGN_CENTER, LAYER_GUI - 10, Color::RED);
+        }
       }
     }
   }
 
+  // The tiles themselves are drawn as whole chunks, which only get new
+  // geometry when their tiles change or an animation advances.
   Canvas& canvas = context.get_canvas(m_draw_target);
 
-  for (auto& it : batches)
+  if (t_draw_rect.left < t_draw_rect.right && t_draw_rect.top < t_draw_rect.bottom)
   {
-    const SurfacePtr& surface = it.first;
-    if (surface) {
-      canvas.draw_surface_batch(surface,
-                                std::move(std::get<0>(it.second)),
-                                std::move(std::get<1>(it.second)),
-                                m_current_tint, m_z_pos);
+    const int chunk_right = (t_draw_rect.right + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    const int chunk_bottom = (t_draw_rect.bottom + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    for (int y = t_draw_rect.top / CHUNK_SIZE; y < chunk_bottom; ++y) {
+      for (int x = t_draw_rect.left / CHUNK_SIZE; x < chunk_right; ++x) {
+        for (const auto& mesh : get_chunk(x, y).meshes) {
+          canvas.draw_texture_mesh(mesh, m_offset, m_current_tint, m_z_pos);
+        }
+      }
     }
   }
 
   context.pop_transform();
 }
 
+bool
+TileMap::is_draw_threadsafe() const
+{
+  // The editor marks deprecated tiles with text, which needs the font cache.
+  return !Editor::is_active();
+}
+
 void
 TileMap::set(int newwidth, int newheight, const std::vector<unsigned int>&newt,
              int new_z_pos, bool newsolid)
@@ -616,6 +638,7 @@ TileMap::set(int newwidth, int newheight, const std::vector<unsigned int>&newt,
 
   m_tiles.resize(newt.size());
   m_tiles = newt;
+  tiles_changed();
 
   if (new_z_pos > (LAYER_GUI - 100))
     m_z_pos = LAYER_GUI - 100;
@@ -675,6 +698,7 @@ TileMap::resize(int new_width, int new_height, int fill_id,
     apply_offset_x(fill_id, xoffset);
   if (!offset_finished_y)
     apply_offset_y(fill_id, yoffset);
+  tiles_changed();
 }
 
 void TileMap::resize(const Size& newsize, const Size& resize_offset) {
@@ -694,10 +718,109 @@ TileMap::get_tiles_overlapping(const Rectf &rect) const
   return Rect(t_left, t_top, t_right, t_bottom);
 }
 
+namespace {
+
+bool has_cells(const std::vector<uint64_t>& cells, int words_per_row,
+               int y, int left, int right)
+{
+  if (left >= right)
+    return false;
+
+  const uint64_t* row = cells.data() + y * words_per_row;
+  const int first = left / 64;
+  const int last = (right - 1) / 64;
+  const uint64_t first_mask = ~uint64_t(0) << (left % 64);
+  const uint64_t last_mask = ~uint64_t(0) >> (63 - (right - 1) % 64);
+
+  if (first == last)
+    return (row[first] & first_mask & last_mask) != 0;
+
+  if (row[first] & first_mask)
+    return true;
+  for (int word = first + 1; word < last; ++word)
+    if (row[word])
+      return true;
+  return (row[last] & last_mask) != 0;
+}
+
+uint8_t to_cell_attributes(uint32_t attributes)
+{
+  const uint32_t known = Tile::SOLID | Tile::UNISOLID | Tile::SLOPE |
+                         Tile::ICE | Tile::WATER | Tile::HURTS;
+
+  uint8_t result = 0;
+  if (attributes & Tile::SOLID) result |= TileMap::CELL_SOLID;
+  if (attributes & Tile::UNISOLID) result |= TileMap::CELL_UNISOLID;
+  if (attributes & Tile::SLOPE) result |= TileMap::CELL_SLOPE;
+  if (attributes & Tile::ICE) result |= TileMap::CELL_ICE;
+  if (attributes & Tile::WATER) result |= TileMap::CELL_WATER;
+  if (attributes & Tile::HURTS) result |= TileMap::CELL_HURTS;
+  if (attributes & ~known) result |= TileMap::CELL_OTHER;
+  return result;
+}
+
+} // namespace
+
+bool
+TileMap::has_solid_cells(int y, int left, int right) const
+{
+  update_cell_attributes();
+  return has_cells(m_solid_cells, m_cell_words_per_row, y, left, right);
+}
+
+bool
+TileMap::has_attribute_cells(int y, int left, int right) const
+{
+  update_cell_attributes();
+  return has_cells(m_attribute_cells, m_cell_words_per_row, y, left, right);
+}
+
+void
+TileMap::update_cell_attributes() const
+{
+  if (m_cell_attributes_valid)
+    return;
+
+  m_cell_words_per_row = (m_width + 63) / 64;
+  m_cell_attributes.assign(m_tiles.size(), 0);
+  m_solid_cells.assign(m_cell_words_per_row * m_height, 0);
+  m_attribute_cells.assign(m_cell_words_per_row * m_height, 0);
+  m_cell_attributes_valid = true;
+
+  for (int index = 0; index < static_cast<int>(m_tiles.size()); ++index)
+    set_cell_attributes(index);
+}
+
+void
+TileMap::set_cell_attributes(int index) const
+{
+  const uint8_t attributes = to_cell_attributes(m_tileset->get(m_tiles[index]).get_attributes());
+  m_cell_attributes[index] = attributes;
+
+  const int y = index / m_width;
+  const int x = index % m_width;
+  const uint64_t bit = uint64_t(1) << (x % 64);
+  uint64_t& solid_word = m_solid_cells[y * m_cell_words_per_row + x / 64];
+  uint64_t& attribute_word = m_attribute_cells[y * m_cell_words_per_row + x / 64];
+
+  solid_word = (attributes & CELL_SOLID) ? (solid_word | bit) : (solid_word & ~bit);
+  attribute_word = attributes ? (attribute_word | bit) : (attribute_word & ~bit);
+}
+
 void
 TileMap::hits_object_bottom(CollisionObject& object)
 {
-  m_objects_hit_bottom.insert(&object);
+  if (m_objects_hit_bottom.insert(&object).second)
+    object.add_tilemap_removal_listener(this);
+}
+
+void
+TileMap::clear_bottom_collision_list()
+{
+  for (CollisionObject* other_object : m_objects_hit_bottom) {
+    other_object->del_tilemap_removal_listener(this);
+  }
+  m_objects_hit_bottom.clear();
 }
 
 void
@@ -777,13 +900,137 @@ TileMap::change(int x, int y, uint32_t newtile)
   if(x < 0 || x >= m_width || y < 0 || y >= m_height)
     return;
 
-  m_tiles[y*m_width + x] = newtile;
+  change(y*m_width + x, newtile);
 }
 
 void
 TileMap::change(int idx, uint32_t newtile)
 {
   m_tiles[idx] = newtile;
+  tile_changed(idx);
+}
+
+void
+TileMap::tiles_changed()
+{
+  m_cell_attributes_valid = false;
+  m_chunks_valid = false;
+}
+
+void
+TileMap::tile_changed(int index)
+{
+  if (m_cell_attributes_valid)
+    set_cell_attributes(index);
+
+  if (m_chunks_valid)
+  {
+    const int x = (index % m_width) / CHUNK_SIZE;
+    const int y = (index / m_width) / CHUNK_SIZE;
+    m_chunks[y * m_chunks_width + x].valid = false;
+  }
+}
+
+const TileMap::Chunk&
+TileMap::get_chunk(int x, int y)
+{
+  const bool editor = Editor::is_active();
+  if (!m_chunks_valid || m_chunks_editor != editor)
+  {
+    m_chunks_width = (m_width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    const int chunks_height = (m_height + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+    m_chunks.clear();
+    m_chunks.resize(m_chunks_width * chunks_height);
+    m_chunks_valid = true;
+    m_chunks_editor = editor;
+  }
+
+  Chunk& chunk = m_chunks[y * m_chunks_width + x];
+
+  if (chunk.valid)
+  {
+    for (const auto& animated_tile : chunk.animated_tiles)
+    {
+      const Tile& tile = m_tileset->get(m_tiles[animated_tile.first]);
+      const SurfacePtr surface = editor ? tile.get_current_editor_surface() : tile.get_current_surface();
+      if (surface.get() != animated_tile.second)
+      {
+        chunk.valid = false;
+        break;
+      }
+    }
+  }
+
+  if (!chunk.valid)
+    build_chunk(x, y, chunk);
+
+  return chunk;
+}
+
+void
+TileMap::build_chunk(int x, int y, Chunk& chunk) const
+{
+  struct Group
+  {
+    TexturePtr texture;
+    TexturePtr displacement_texture;
+    Flip flip;
+    std::vector<Rectf> srcrects;
+    std::vector<Rectf> dstrects;
+  };
+
+  // Chunks rarely use more than a few textures, a linear search is
+  // faster than any map here.
+  std::vector<Group> groups;
+
+  chunk.animated_tiles.clear();
+
+  const int right = std::min(m_width, (x + 1) * CHUNK_SIZE);
+  const int bottom = std::min(m_height, (y + 1) * CHUNK_SIZE);
+  for (int ty = y * CHUNK_SIZE; ty < bottom; ++ty) {
+    for (int tx = x * CHUNK_SIZE; tx < right; ++tx) {
+      const int index = ty*m_width + tx;
+      if (m_tiles[index] == 0) continue;
+      const Tile& tile = m_tileset->get(m_tiles[index]);
+
+      const SurfacePtr surface = m_chunks_editor ? tile.get_current_editor_surface() : tile.get_current_surface();
+
+      if (tile.is_animated())
+        chunk.animated_tiles.emplace_back(index, surface.get());
+
+      if (!surface)
+        continue;
+
+      const TexturePtr texture = surface->get_texture();
+      const TexturePtr displacement_texture = surface->get_displacement_texture();
+      auto group = std::find_if(groups.begin(), groups.end(),
+                                [&](const Group& g) {
+                                  return g.texture == texture &&
+                                         g.displacement_texture == displacement_texture &&
+                                         g.flip == surface->get_flip();
+                                });
+      if (group == groups.end())
+      {
+        groups.push_back(Group{texture, displacement_texture, surface->get_flip(), {}, {}});
+        group = groups.end() - 1;
+      }
+
+      group->srcrects.emplace_back(surface->get_region());
+      group->dstrects.emplace_back(Vector(static_cast<float>(tx * 32), static_cast<float>(ty * 32)),
+                                   Sizef(static_cast<float>(surface->get_width()),
+                                         static_cast<float>(surface->get_height())));
+    }
+  }
+
+  chunk.meshes.clear();
+  for (auto& group : groups)
+  {
+    chunk.meshes.push_back(std::make_shared<TextureMesh>(group.texture, group.displacement_texture, group.flip,
+                                                         std::move(group.srcrects),
+                                                         std::move(group.dstrects)));
+  }
+  chunk.valid = true;
 }
 
 void
@@ -822,6 +1069,8 @@ TileMap::autotile(const Vector& pos, uint32_t tile, AutotileSet* autotileset)
       pos.y < 0.f || pos.y >= static_cast<float>(m_height))
     return;
 
+  tiles_changed();
+
   if (autotileset->is_corner())
   {
     const int x = static_cast<int>(pos.x + 0.5f), y = static_cast<int>(pos.y + 0.5f);
@@ -927,6 +1176,8 @@ TileMap::autotile_erase(const Vector& pos, AutotileSet* autotileset)
       pos.y < 0.f || pos.y >= static_cast<float>(m_height))
     return;
 
+  tiles_changed();
+
   if (autotileset->is_corner())
   {
     const int x = static_cast<int>(pos.x + 0.5f), y = static_cast<int>(pos.y + 0.5f);
@@ -19,7 +19,9 @@
 #include "editor/layer_object.hpp"
 
 #include <algorithm>
+#include <memory>
 #include <unordered_set>
+#include <vector>
 
 #include "math/rect.hpp"
 #include "math/rectf.hpp"
@@ -35,6 +37,8 @@ class AutotileSet;
 class CollisionObject;
 class CollisionGroundMovementManager;
 class DrawingContext;
+class Surface;
+class TextureMesh;
 class Tile;
 class TileSet;
 
@@ -76,6 +80,7 @@ public:
 
   virtual void update(float dt_sec) override;
   virtual void draw(DrawingContext& context) override;
+  virtual bool is_draw_threadsafe() const override;
 
   void on_path_resolved() override;
 
@@ -141,11 +146,41 @@ public:
       overlap the given rectangle in the sector. */
   Rect get_tiles_overlapping(const Rectf &rect) const;
 
+  /** Collision relevant attributes of a tile, as stored in the per-cell
+      attribute plane of the tilemap. */
+  enum CellAttributes : uint8_t {
+    CELL_SOLID    = 0x01,
+    CELL_UNISOLID = 0x02,
+    CELL_SLOPE    = 0x04,
+    CELL_ICE      = 0x08,
+    CELL_WATER    = 0x10,
+    CELL_HURTS    = 0x20,
+    /** The tile has any other attribute */
+    CELL_OTHER    = 0x40
+  };
+
+  /** Returns the CellAttributes of tile (x, y), which has to be inside
+      of the tilemap. Much cheaper than looking at get_tile(). */
+  uint8_t get_cell_attributes(int x, int y) const
+  {
+    update_cell_attributes();
+    return m_cell_attributes[y * m_width + x];
+  }
+
+  /** Returns true if any tile in row @c y from @c left (inclusive) to
+      @c right (exclusive) is solid, or has any attributes at all. */
+  bool has_solid_cells(int y, int left, int right) const;
+  bool has_attribute_cells(int y, int left, int right) const;
+
   /** Called by the collision mechanism to indicate that this tilemap has been hit on
       the top, i.e. has hit a moving object on the bottom of its collision rectangle. */
   void hits_object_bottom(CollisionObject& object);
   void notify_object_removal(CollisionObject* other);
 
+  /** Forgets about the objects touching the top, needs to be called
+      before the tilemap gets removed from the sector. */
+  void clear_bottom_collision_list();
+
   int get_layer() const override { return m_z_pos; }
   inline void set_layer(int layer) { m_z_pos = layer; }
 
@@ -265,7 +300,11 @@ public:
 
   inline float get_target_alpha() const { return m_alpha; }
 
-  inline void set_tileset(const TileSet* tileset) { m_tileset = tileset; }
+  inline void set_tileset(const TileSet* tileset)
+  {
+    m_tileset = tileset;
+    tiles_changed();
+  }
 
   inline const std::vector<uint32_t>& get_tiles() const { return m_tiles; }
 
@@ -293,6 +332,21 @@ private:
   void apply_offset_x(int fill_id, int xoffset);
   void apply_offset_y(int fill_id, int yoffset);
 
+  /** Rebuilds the attribute plane if the tiles changed in bulk. */
+  void update_cell_attributes() const;
+  void set_cell_attributes(int index) const;
+
+  /** Invalidates everything cached about the tiles, or only what
+      depends on the tile at @c index. */
+  void tiles_changed();
+  void tile_changed(int index);
+
+  struct Chunk;
+
+  /** Returns the chunk at (x, y) with up to date meshes. */
+  const Chunk& get_chunk(int x, int y);
+  void build_chunk(int x, int y, Chunk& chunk) const;
+
 public:
   bool m_editor_active;
 
@@ -302,6 +356,40 @@ private:
   typedef std::vector<uint32_t> Tiles;
   Tiles m_tiles;
 
+  /** CellAttributes of every tile, plus one bit per tile and row packed
+      into 64 bit words for solid tiles and tiles with any attributes, so
+      that collision checks can skip empty rows quickly. Rebuilt lazily
+      after bulk changes, single tile changes update it in place. */
+  mutable std::vector<uint8_t> m_cell_attributes;
+  mutable std::vector<uint64_t> m_solid_cells;
+  mutable std::vector<uint64_t> m_attribute_cells;
+  mutable int m_cell_words_per_row;
+  mutable bool m_cell_attributes_valid;
+
+  /** Number of tiles in each direction that make up a chunk */
+  static const int CHUNK_SIZE = 32;
+
+  /** The meshes of CHUNK_SIZE x CHUNK_SIZE tiles, one per texture. They
+      are kept until the tiles change, so renderers can keep them in GPU
+      memory instead of getting new geometry every frame. */
+  struct Chunk
+  {
+    std::vector<std::shared_ptr<const TextureMesh>> meshes;
+
+    /** Index and surface of every animated tile when the meshes were
+        built, the chunk is outdated once any of them shows another one. */
+    std::vector<std::pair<int, const Surface*>> animated_tiles;
+
+    bool valid = false;
+  };
+
+  std::vector<Chunk> m_chunks;
+  int m_chunks_width;
+  bool m_chunks_valid;
+
+  /** Whether the chunks were built with the editor images of the tiles */
+  bool m_chunks_editor;
+
 #ifdef DOXYGEN_SCRIPTING
   /**
    * @scripting
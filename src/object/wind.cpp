@@ -52,7 +52,7 @@ Wind::Wind(const ReaderMapping& reader) :
   reader.get("y", m_col.m_bbox.get_top(), 0.0f);
   reader.get("width", w, 32.0f);
   reader.get("height", h, 32.0f);
-  m_col.m_bbox.set_size(w, h);
+  m_col.set_bbox_size(w, h);
 
   reader.get("z-pos", m_layer, LAYER_BACKGROUNDTILES + 1);
 
@@ -16,6 +16,7 @@
 
 #include "physfs/util.hpp"
 
+#include <memory>
 #include <stdexcept>
 
 #include <physfs.h>
@@ -68,6 +69,30 @@ bool remove(const std::string& filename)
   return PHYSFS_delete(filename.c_str()) == 0;
 }
 
+bool read_file(const std::string& filename, std::string& data)
+{
+  std::unique_ptr<PHYSFS_File, int(*)(PHYSFS_File*)> file(PHYSFS_openRead(filename.c_str()), PHYSFS_close);
+  if (!file)
+    return false;
+
+  const PHYSFS_sint64 length = PHYSFS_fileLength(file.get());
+  if (length < 0)
+    return false;
+
+  data.resize(static_cast<size_t>(length));
+  return PHYSFS_readBytes(file.get(), &data[0], length) == length;
+}
+
+bool write_file(const std::string& filename, const std::string& data)
+{
+  std::unique_ptr<PHYSFS_File, int(*)(PHYSFS_File*)> file(PHYSFS_openWrite(filename.c_str()), PHYSFS_close);
+  if (!file)
+    return false;
+
+  const PHYSFS_sint64 length = static_cast<PHYSFS_sint64>(data.size());
+  return PHYSFS_writeBytes(file.get(), data.data(), data.size()) == length;
+}
+
 #define PHYSFS_UTIL_DIRECTORY_GUARD \
   if (!is_directory(dir) || !PHYSFS_exists(dir.c_str())) return
 
@@ -40,6 +40,13 @@ void remove_content(const std::string& dir);
 /** Removes directory with content */
 void remove_with_content(const std::string& dir);
 
+/** Reads the whole file into @c data, returns false if that failed */
+bool read_file(const std::string& filename, std::string& data);
+
+/** Writes @c data to the file in the write directory, returns false if
+    that failed */
+bool write_file(const std::string& filename, const std::string& data);
+
 /** Open directory and call callback for each file */
 bool enumerate_files(const std::string& pathname, std::function<bool(const std::string&)> callback);
 
@@ -0,0 +1,130 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "sprite/action_id.hpp"
+
+#include <array>
+#include <deque>
+#include <limits>
+#include <unordered_map>
+
+namespace {
+
+// Number of values of Direction
+const size_t DIRECTION_COUNT = static_cast<size_t>(Direction::DOWN) + 1;
+
+const uint32_t UNKNOWN = std::numeric_limits<uint32_t>::max();
+
+struct ActionName final
+{
+  std::string name;
+
+  /** The "name-direction" actions by Direction, UNKNOWN until needed */
+  std::array<uint32_t, DIRECTION_COUNT> with_direction;
+};
+
+struct ActionNames final
+{
+  ActionNames() :
+    names(),
+    ids(),
+    joined(),
+    directions()
+  {
+    // Index 0 is the empty name of a default ActionId.
+    names.push_back({ std::string(), {} });
+    names.back().with_direction.fill(UNKNOWN);
+    ids.emplace(std::string(), 0);
+    directions.fill(UNKNOWN);
+  }
+
+  /** Names by index, a deque keeps references to them valid */
+  std::deque<ActionName> names;
+  std::unordered_map<std::string, uint32_t> ids;
+
+  /** The "first-second" actions by both indices */
+  std::unordered_map<uint64_t, uint32_t> joined;
+
+  std::array<uint32_t, DIRECTION_COUNT> directions;
+};
+
+ActionNames& get_action_names()
+{
+  static ActionNames s_names;
+  return s_names;
+}
+
+uint32_t intern(const std::string& name)
+{
+  ActionNames& names = get_action_names();
+  auto it = names.ids.find(name);
+  if (it != names.ids.end())
+    return it->second;
+
+  const auto index = static_cast<uint32_t>(names.names.size());
+  names.names.push_back({ name, {} });
+  names.names.back().with_direction.fill(UNKNOWN);
+  names.ids.emplace(name, index);
+  return index;
+}
+
+} // namespace
+
+ActionId::ActionId(const std::string& name) :
+  m_index(intern(name))
+{
+}
+
+ActionId
+ActionId::with_direction(const Direction& dir) const
+{
+  if (dir == Direction::NONE)
+    return *this;
+
+  uint32_t& index = get_action_names().names[m_index].with_direction[static_cast<size_t>(dir)];
+  if (index == UNKNOWN)
+    index = intern(get_name() + "-" + dir_to_string(dir));
+  return ActionId(index);
+}
+
+ActionId
+ActionId::join(const ActionId& first, const ActionId& second)
+{
+  auto& joined = get_action_names().joined;
+  const uint64_t key = (static_cast<uint64_t>(first.m_index) << 32) | second.m_index;
+  auto it = joined.find(key);
+  if (it != joined.end())
+    return ActionId(it->second);
+
+  const uint32_t index = intern(first.get_name() + "-" + second.get_name());
+  joined.emplace(key, index);
+  return ActionId(index);
+}
+
+ActionId
+ActionId::from_direction(const Direction& dir)
+{
+  uint32_t& index = get_action_names().directions[static_cast<size_t>(dir)];
+  if (index == UNKNOWN)
+    index = intern(dir_to_string(dir));
+  return ActionId(index);
+}
+
+const std::string&
+ActionId::get_name() const
+{
+  return get_action_names().names[m_index].name;
+}
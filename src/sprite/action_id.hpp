@@ -0,0 +1,61 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+#include "supertux/direction.hpp"
+
+/**
+ * Handle of a sprite action name. The name is looked up once when the
+ * handle is created, after that Sprite::set_action() compares and finds
+ * actions by the handle without building or hashing strings. Keep the
+ * handles of hot call sites around, e.g. as constants, and create them
+ * on the main thread.
+ */
+class ActionId final
+{
+public:
+  /** The empty name */
+  ActionId() : m_index(0) {}
+  explicit ActionId(const std::string& name);
+
+  /** The action "name-direction", e.g. "walk-left", or this action for
+      Direction::NONE */
+  ActionId with_direction(const Direction& dir) const;
+
+  /** The action "first-second", e.g. "big-walk" */
+  static ActionId join(const ActionId& first, const ActionId& second);
+
+  /** The action "direction", e.g. "left" */
+  static ActionId from_direction(const Direction& dir);
+
+  const std::string& get_name() const;
+
+  /** Small number that is unique for each name */
+  inline uint32_t get_index() const { return m_index; }
+
+  inline bool operator==(const ActionId& other) const { return m_index == other.m_index; }
+  inline bool operator!=(const ActionId& other) const { return m_index != other.m_index; }
+
+private:
+  explicit ActionId(uint32_t index) : m_index(index) {}
+
+private:
+  uint32_t m_index;
+};
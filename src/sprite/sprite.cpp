@@ -23,6 +23,12 @@
 #include "util/log.hpp"
 #include "video/surface.hpp"
 
+namespace {
+
+const ActionId DEFAULT_ACTION("default");
+
+} // namespace
+
 Sprite::Sprite(SpriteData& newdata) :
   m_data(newdata),
   m_frame(0),
@@ -34,10 +40,14 @@ Sprite::Sprite(SpriteData& newdata) :
   m_color(1.0f, 1.0f, 1.0f, 1.0f),
   m_blend(),
   m_is_paused(false),
-  m_action(m_data.get_action("default"))
+  m_action(m_data.get_action(DEFAULT_ACTION)),
+  m_action_id(DEFAULT_ACTION)
 {
   if (!m_action)
+  {
     m_action = m_data.actions.begin()->second.get();
+    m_action_id = ActionId(m_action->name);
+  }
   m_last_ticks = g_game_time;
 }
 
@@ -52,7 +62,8 @@ Sprite::Sprite(const Sprite& other) :
   m_color(1.0f, 1.0f, 1.0f, 1.0f),
   m_blend(),
   m_is_paused(other.m_is_paused),
-  m_action(other.m_action)
+  m_action(other.m_action),
+  m_action_id(other.m_action_id)
 {
 }
 
@@ -69,38 +80,47 @@ Sprite::clone() const
 void
 Sprite::set_action(const std::string& name, const Direction& dir, int loops)
 {
-  if (dir == Direction::NONE)
-    set_action(name, loops);
-  else
-    set_action(name + "-" + dir_to_string(dir), loops);
+  set_action(ActionId(name).with_direction(dir), loops);
 }
 
 void
 Sprite::set_action(const Direction& dir, const std::string& name, int loops)
 {
   if (dir == Direction::NONE)
-    set_action(name, loops);
+    set_action(ActionId(name), loops);
   else
-    set_action(dir_to_string(dir) + "-" + name, loops);
+    set_action(ActionId::join(ActionId::from_direction(dir), ActionId(name)), loops);
 }
 
 void
 Sprite::set_action(const Direction& dir, int loops)
 {
-  set_action(dir_to_string(dir), loops);
+  set_action(ActionId::from_direction(dir), loops);
 }
 
 void
 Sprite::set_action(const std::string& name, int loops)
 {
-  if (m_action && m_action->name == name)
+  set_action(ActionId(name), loops);
+}
+
+void
+Sprite::set_action(const ActionId& id, const Direction& dir, int loops)
+{
+  set_action(id.with_direction(dir), loops);
+}
+
+void
+Sprite::set_action(const ActionId& id, int loops)
+{
+  if (m_action && m_action_id == id)
     return;
 
-  const SpriteData::Action* newaction = m_data.get_action(name);
+  const SpriteData::Action* newaction = m_data.get_action(id);
   if (!newaction) {
     // HACK: Lots of things trigger this message therefore turning it into a warning
     // would make it quite annoying
-    log_debug << "Action '" << name << "' not found." << std::endl;
+    log_debug << "Action '" << id.get_name() << "' not found." << std::endl;
     return;
   }
 
@@ -111,6 +131,7 @@ Sprite::set_action(const std::string& name, int loops)
   if (loops == LOOPS_CONTINUED)
   {
     m_action = newaction;
+    m_action_id = id;
     update();
     return;
   }
@@ -126,6 +147,7 @@ Sprite::set_action(const std::string& name, int loops)
   }
 
   m_action = newaction;
+  m_action_id = id;
   m_last_ticks = g_game_time;
 }
 
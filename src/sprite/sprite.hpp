@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "sprite/action_id.hpp"
 #include "sprite/sprite_data.hpp"
 #include "sprite/sprite_ptr.hpp"
 #include "supertux/direction.hpp"
@@ -44,6 +45,13 @@ public:
   /** Set action (or state) */
   void set_action(const std::string& name, int loops = -1);
 
+  /** Set action (or state) by its handle, which skips looking up the
+      name, setting the current action again only compares the handles */
+  void set_action(const ActionId& id, int loops = -1);
+
+  /** Sets the action "name-direction" by handles, see ActionId::with_direction() */
+  void set_action(const ActionId& id, const Direction& dir, int loops = -1);
+
   /** Composes action (or state) string from an action name and a particular direction
    * in the form of "name-direction", eg. "walk-left"
    */
@@ -86,6 +94,7 @@ public:
 
   /** Get current action name */
   inline const std::string& get_action() const { return m_action->name; }
+  inline const ActionId& get_action_id() const { return m_action_id; }
 
   int get_width() const;
   int get_height() const;
@@ -143,6 +152,7 @@ private:
   bool m_is_paused;
 
   const SpriteData::Action* m_action;
+  ActionId m_action_id;
 
 private:
   Sprite(const Sprite& other);
@@ -18,6 +18,7 @@
 #include "sprite/sprite_data.hpp"
 
 #include <algorithm>
+#include <memory>
 #include <stdexcept>
 #include <sstream>
 
@@ -67,17 +68,21 @@ SpriteData::Action::reset(SurfacePtr surface)
 }
 
 
-SpriteData::SpriteData(const std::string& filename) :
+SpriteData::SpriteData(const std::string& filename, const ReaderDocument* doc) :
   m_filename(filename),
   m_load_successful(false),
-  actions()
+  actions(),
+  m_action_slots()
 {
-  load();
+  load(doc);
 }
 
 void
-SpriteData::load()
+SpriteData::load(const ReaderDocument* doc)
 {
+  // Reloading may add actions that weren't found before.
+  m_action_slots.clear();
+
   // Reset all existing actions to a dummy texture
   if (!actions.empty())
   {
@@ -90,8 +95,13 @@ SpriteData::load()
   {
     try
     {
-      auto doc = ReaderDocument::from_file(m_filename);
-      auto root = doc.get_root();
+      std::unique_ptr<ReaderDocument> parsed_doc;
+      if (!doc)
+      {
+        parsed_doc = std::make_unique<ReaderDocument>(ReaderDocument::from_file(m_filename));
+        doc = parsed_doc.get();
+      }
+      auto root = doc->get_root();
 
       if (root.get_name() != "supertux-sprite")
       {
@@ -382,9 +392,9 @@ SpriteData::parse_action(const ReaderMapping& mapping)
         max_w = std::max(max_w, static_cast<float>(w));
         max_h = std::max(max_w, static_cast<float>(h));
 
-        auto surface = Surface::from_file(FileSystem::join(mapping.get_doc().get_directory(),
-                                                           arr[1].as_string()),
-                                          region);
+        auto surface = Surface::from_file_packed(FileSystem::join(mapping.get_doc().get_directory(),
+                                                                  arr[1].as_string()),
+                                                 region);
         action->surfaces.push_back(surface);
       }
 
@@ -397,7 +407,7 @@ SpriteData::parse_action(const ReaderMapping& mapping)
       float max_h = 0;
       for (const auto& image : images)
       {
-        auto surface = Surface::from_file(FileSystem::join(mapping.get_doc().get_directory(), image));
+        auto surface = Surface::from_file_packed(FileSystem::join(mapping.get_doc().get_directory(), image));
         max_w = std::max(max_w, static_cast<float>(surface->get_width()));
         max_h = std::max(max_h, static_cast<float>(surface->get_height()));
         action->surfaces.push_back(surface);
@@ -459,3 +469,19 @@ SpriteData::get_action(const std::string& act) const
   }
   return i->second.get();
 }
+
+const SpriteData::Action*
+SpriteData::get_action(const ActionId& id) const
+{
+  const uint32_t index = id.get_index();
+  if (index >= m_action_slots.size())
+    m_action_slots.resize(index + 1, { nullptr, false });
+
+  ActionSlot& slot = m_action_slots[index];
+  if (!slot.resolved)
+  {
+    slot.action = get_action(id.get_name());
+    slot.resolved = true;
+  }
+  return slot.action;
+}
@@ -21,8 +21,10 @@
 #include <unordered_map>
 #include <vector>
 
+#include "sprite/action_id.hpp"
 #include "video/surface_ptr.hpp"
 
+class ReaderDocument;
 class ReaderMapping;
 
 class SpriteData final
@@ -30,9 +32,10 @@ class SpriteData final
   friend class Sprite;
 
 public:
-  SpriteData(const std::string& filename);
+  /** @c doc is the already parsed sprite file, if there is one */
+  SpriteData(const std::string& filename, const ReaderDocument* doc = nullptr);
 
-  void load();
+  void load(const ReaderDocument* doc = nullptr);
 
 private:
   struct Action final
@@ -84,6 +87,10 @@ private:
 
   const Action* get_action(const std::string& act) const;
 
+  /** Looks the action up by name the first time, later calls index
+      m_action_slots. */
+  const Action* get_action(const ActionId& id) const;
+
 private:
   const std::string m_filename;
   bool m_load_successful;
@@ -91,6 +98,15 @@ private:
   typedef std::unordered_map<std::string, std::unique_ptr<Action>> Actions;
   Actions actions;
 
+  struct ActionSlot
+  {
+    const Action* action;
+    bool resolved;
+  };
+
+  /** Actions by ActionId index, filled as Sprites ask for them */
+  mutable std::vector<ActionSlot> m_action_slots;
+
 private:
   SpriteData(const SpriteData& other);
   SpriteData& operator=(const SpriteData&) = delete;
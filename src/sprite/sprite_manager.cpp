@@ -14,13 +14,45 @@
 //
 //  You should have received a copy of the GNU General Public License
 //  along with this program.  If not, see <http://www.gnu.org/licenses/>.
-
 #include "sprite/sprite_manager.hpp"
 
+#include <algorithm>
+#include <sexp/value.hpp>
+
 #include "sprite/sprite.hpp"
+#include "sprite/sprite_data.hpp"
+#include "util/file_system.hpp"
+#include "util/reader_document.hpp"
+#include "util/string_util.hpp"
+#include "util/thread_pool.hpp"
+#include "video/texture_manager.hpp"
+
+namespace {
+
+void collect_images(const sexp::Value& sx, std::vector<std::string>& images)
+{
+  if (sx.is_array())
+  {
+    for (const auto& item : sx.as_array())
+      collect_images(item, images);
+  }
+  else if (sx.is_string())
+  {
+    const std::string& text = sx.as_string();
+    if (StringUtil::has_suffix(text, ".png") || StringUtil::has_suffix(text, ".jpg"))
+      images.push_back(text);
+  }
+}
+
+} // namespace
 
 SpriteManager::SpriteManager() :
-  m_sprites()
+  m_sprites(),
+  m_prefetched()
+{
+}
+
+SpriteManager::~SpriteManager()
 {
 }
 
@@ -45,13 +77,78 @@ SpriteManager::create(const std::string& name)
 SpriteData*
 SpriteManager::load(const std::string& filename)
 {
+  auto it = m_prefetched.find(filename);
+  if (it != m_prefetched.end())
+  {
+    PrefetchedSprite sprite = it->second.get();
+    m_prefetched.erase(it);
+
+    for (auto& image : sprite.images)
+      TextureManager::current()->prefetch(image.first, std::move(image.second));
+
+    m_sprites[filename] = std::make_unique<SpriteData>(filename, sprite.doc.get());
+    return m_sprites[filename].get();
+  }
+
   m_sprites[filename] = std::make_unique<SpriteData>(filename);
   return m_sprites[filename].get();
 }
 
+void
+SpriteManager::prefetch(const std::string& filename)
+{
+  ThreadPool* thread_pool = ThreadPool::current();
+  if (!thread_pool ||
+      m_sprites.find(filename) != m_sprites.end() ||
+      m_prefetched.find(filename) != m_prefetched.end())
+    return;
+
+  // Plain images are used as sprites as well.
+  if (!StringUtil::has_suffix(filename, ".sprite"))
+  {
+    TextureManager::current()->prefetch(filename);
+    return;
+  }
+
+  m_prefetched[filename] = thread_pool->schedule([filename, thread_pool]{
+    PrefetchedSprite sprite;
+    try
+    {
+      sprite.doc = std::make_unique<ReaderDocument>(ReaderDocument::from_file_silent(filename));
+    }
+    catch (const std::exception&)
+    {
+      // SpriteData reports the error when it loads the file again.
+      return sprite;
+    }
+
+    std::vector<std::string> images;
+    collect_images(sprite.doc->get_sexp(), images);
+    std::sort(images.begin(), images.end());
+    images.erase(std::unique(images.begin(), images.end()), images.end());
+
+    const std::string directory = sprite.doc->get_directory();
+    for (const auto& image : images)
+    {
+      const std::string path = FileSystem::join(directory, image);
+      sprite.images.emplace_back(path, thread_pool->schedule([path]{
+        return TextureManager::decode_image(path);
+      }));
+    }
+    return sprite;
+  });
+}
+
+void
+SpriteManager::drop_prefetched()
+{
+  m_prefetched.clear();
+}
+
 void
 SpriteManager::reload()
 {
+  m_prefetched.clear();
   for (const auto& sprite_data : m_sprites)
     sprite_data.second->load();
 }
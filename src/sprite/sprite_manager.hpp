@@ -19,12 +19,17 @@
 
 #include "util/currenton.hpp"
 
+#include <future>
 #include <unordered_map>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "sprite/sprite_ptr.hpp"
+#include "video/sdl_surface_ptr.hpp"
 
+class ReaderDocument;
 class SpriteData;
 
 class SpriteManager final : public Currenton<SpriteManager>
@@ -33,12 +38,29 @@ private:
   typedef std::unordered_map<std::string, std::unique_ptr<SpriteData>> Sprites;
   Sprites m_sprites;
 
+  /** A sprite file parsed in the background, together with the images
+      it uses, which get decoded in the background as well. */
+  struct PrefetchedSprite
+  {
+    std::unique_ptr<ReaderDocument> doc;
+    std::vector<std::pair<std::string, std::future<SDLSurfacePtr>>> images;
+  };
+  std::unordered_map<std::string, std::future<PrefetchedSprite>> m_prefetched;
+
 public:
   SpriteManager();
+  ~SpriteManager() override;
 
   /** Loads a sprite. */
   SpritePtr create(const std::string& filename);
 
+  /** Starts parsing the sprite and decoding its images on the
+      ThreadPool, so that a later create() doesn't wait for the disk. */
+  void prefetch(const std::string& filename);
+
+  /** Forgets the prefetched sprites that nothing has created */
+  void drop_prefetched();
+
   /** Reloads all sprites. */
   void reload();
 
@@ -0,0 +1,126 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "supertux/asset_prefetch.hpp"
+
+#include <sexp/value.hpp>
+
+#include <algorithm>
+
+#include "audio/sound_manager.hpp"
+#include "badguy/badguy.hpp"
+#include "object/bonus_block.hpp"
+#include "object/brick.hpp"
+#include "object/coin.hpp"
+#include "object/powerup.hpp"
+#include "sprite/sprite_manager.hpp"
+#include "supertux/game_object_factory.hpp"
+#include "util/string_util.hpp"
+#include "video/texture_manager.hpp"
+
+AssetPrefetch::AssetPrefetch() :
+  m_images(),
+  m_sprites(),
+  m_sounds(),
+  m_music(),
+  m_objects()
+{
+}
+
+void
+AssetPrefetch::scan(const sexp::Value& sx)
+{
+  if (sx.is_array())
+  {
+    const auto& items = sx.as_array();
+    if (!items.empty() && items.front().is_symbol())
+      m_objects.insert(items.front().as_string());
+
+    for (const auto& item : items)
+      scan(item);
+  }
+  else if (sx.is_string())
+  {
+    const std::string& text = sx.as_string();
+    if (StringUtil::has_suffix(text, ".png") || StringUtil::has_suffix(text, ".jpg"))
+      m_images.insert(text);
+    else if (StringUtil::has_suffix(text, ".sprite"))
+      m_sprites.insert(text);
+    else if (StringUtil::has_suffix(text, ".wav") || StringUtil::has_suffix(text, ".ogg"))
+      m_sounds.insert(text);
+    else if (StringUtil::has_suffix(text, ".music"))
+      m_music.insert(text);
+  }
+}
+
+void
+AssetPrefetch::start()
+{
+  add_object_sounds();
+
+  if (auto* texture_manager = TextureManager::current())
+  {
+    for (const auto& image : m_images)
+      texture_manager->prefetch(image);
+  }
+
+  if (auto* sprite_manager = SpriteManager::current())
+  {
+    for (const auto& sprite : m_sprites)
+      sprite_manager->prefetch(sprite);
+  }
+
+  if (auto* sound_manager = SoundManager::current())
+  {
+    for (const auto& sound : m_sounds)
+      sound_manager->prefetch(sound);
+    for (const auto& music : m_music)
+      sound_manager->prefetch(music);
+  }
+}
+
+void
+AssetPrefetch::add_object_sounds()
+{
+  // The lists are the ones the constructors preload from.
+  const std::pair<std::string, const std::vector<std::string>*> object_sounds[] = {
+    { BonusBlock::class_name(), &Block::s_preload_sounds },
+    { BonusBlock::class_name(), &BonusBlock::s_light_sounds },
+    { Brick::class_name(), &Block::s_preload_sounds },
+    { Coin::class_name(), &Coin::s_preload_sounds },
+    { HeavyCoin::class_name(), &Coin::s_preload_sounds },
+    { HeavyCoin::class_name(), &HeavyCoin::s_preload_sounds },
+    { PowerUp::class_name(), &PowerUp::s_preload_sounds }
+  };
+
+  for (const auto& object_sound : object_sounds)
+  {
+    if (m_objects.find(object_sound.first) != m_objects.end())
+      m_sounds.insert(object_sound.second->begin(), object_sound.second->end());
+  }
+
+  const auto& badguys = GameObjectFactory::instance().get_registered_badguys();
+  const bool has_badguys = std::any_of(badguys.begin(), badguys.end(),
+    [this](const std::string& name) { return m_objects.find(name) != m_objects.end(); });
+  if (has_badguys)
+    m_sounds.insert(BadGuy::s_preload_sounds.begin(), BadGuy::s_preload_sounds.end());
+}
+
+size_t
+AssetPrefetch::get_count() const
+{
+  return m_images.size() + m_sprites.size() + m_sounds.size() + m_music.size();
+}
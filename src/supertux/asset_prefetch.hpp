@@ -0,0 +1,61 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <set>
+#include <string>
+
+namespace sexp {
+class Value;
+} // namespace sexp
+
+/** Collects the images, sprites, sounds and music a level file refers
+    to and starts loading them on the ThreadPool, so that the objects
+    of the level don't wait for the disk one after another while they
+    get built. The sounds that the objects of the level play themselves
+    are added by their names. */
+class AssetPrefetch final
+{
+public:
+  AssetPrefetch();
+
+  /** Collects the files referenced anywhere below @c sx */
+  void scan(const sexp::Value& sx);
+
+  /** Hands the collected files to the resource managers */
+  void start();
+
+  /** Number of files collected so far */
+  size_t get_count() const;
+
+private:
+  /** Adds the sounds of the objects found by scan() */
+  void add_object_sounds();
+
+private:
+  std::set<std::string> m_images;
+  std::set<std::string> m_sprites;
+  std::set<std::string> m_sounds;
+  std::set<std::string> m_music;
+
+  /** Names of the lists in the level, which include the object names */
+  std::set<std::string> m_objects;
+
+private:
+  AssetPrefetch(const AssetPrefetch&) = delete;
+  AssetPrefetch& operator=(const AssetPrefetch&) = delete;
+};
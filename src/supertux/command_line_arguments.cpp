@@ -96,6 +96,7 @@ CommandLineArguments::print_help(const char* arg0) const
     << _("  --verbose                    Print verbose messages") << "\n"
     << _("  --debug                      Print extra verbose messages") << "\n"
     << _("  --print-datadir              Print SuperTux's primary data directory.") << "\n"
+    << _("  --precompile-data            Store all levels, tilesets and sprites in the binary cache and quit") << "\n"
     << _("  --acknowledgements           Print the licenses of libraries used by SuperTux.") << "\n"
     << "\n"
     << _("Video Options:") << "\n"
@@ -167,6 +168,10 @@ CommandLineArguments::parse_args(int argc, char** argv)
     {
       m_action = PRINT_ACKNOWLEDGEMENTS;
     }
+    else if (arg == "--precompile-data")
+    {
+      m_action = PRECOMPILE_DATA;
+    }
     else if (arg == "--debug")
     {
       m_log_level = LOG_DEBUG;
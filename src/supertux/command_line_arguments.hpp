@@ -36,7 +36,8 @@ public:
     PRINT_VERSION,
     PRINT_HELP,
     PRINT_DATADIR,
-    PRINT_ACKNOWLEDGEMENTS
+    PRINT_ACKNOWLEDGEMENTS,
+    PRECOMPILE_DATA
   };
 
 private:
@@ -161,6 +161,11 @@ public:
   /** Indicates if the object should be added at the beginning of the object list. */
   virtual bool has_object_manager_priority() const { return false; }
 
+  /** Indicates if draw() may run on a worker thread, alongside draw()
+      of other such objects. It must then only touch the object itself
+      and the DrawingContext, no fonts, sprites or other shared caches. */
+  virtual bool is_draw_threadsafe() const { return false; }
+
   /** Returns the amount of coins that this object is worth.
       This is considered when calculating all coins in a level. */
   virtual int get_coins_worth() const { return 0; }
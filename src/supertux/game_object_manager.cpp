@@ -31,7 +31,16 @@
 #include "supertux/moving_object.hpp"
 #include "util/reader_document.hpp"
 #include "util/reader_mapping.hpp"
+#include "util/thread_pool.hpp"
 #include "util/writer.hpp"
+#include "video/drawing_context.hpp"
+
+namespace {
+
+// Below this, handing objects to the workers costs more than it saves.
+const size_t MIN_PARALLEL_DRAW_OBJECTS = 4;
+
+} // namespace
 
 bool GameObjectManager::s_draw_solids_only = false;
 
@@ -53,7 +62,8 @@ GameObjectManager::GameObjectManager(bool undo_tracking) :
   m_objects_by_name(),
   m_objects_by_uid(),
   m_objects_by_type_index(),
-  m_name_resolve_requests()
+  m_name_resolve_requests(),
+  m_draw_spans()
 {
 }
 
@@ -244,6 +254,13 @@ GameObjectManager::draw(DrawingContext& context)
     return;
   }
 
+  ThreadPool* thread_pool = ThreadPool::current();
+  if (thread_pool && thread_pool->get_thread_count() > 1)
+  {
+    draw_parallel(context, *thread_pool);
+    return;
+  }
+
   for (const auto& object : m_gameobjects)
   {
     if (!object->is_valid())
@@ -253,6 +270,78 @@ GameObjectManager::draw(DrawingContext& context)
   }
 }
 
+void
+GameObjectManager::draw_parallel(DrawingContext& context, ThreadPool& thread_pool)
+{
+  // Recording 0 is filled by this thread with all objects that aren't
+  // thread-safe, the thread-safe ones are marked with 1 for now.
+  m_draw_spans.clear();
+  size_t threadsafe_count = 0;
+  for (const auto& object : m_gameobjects)
+  {
+    if (!object->is_valid())
+      continue;
+
+    const bool threadsafe = object->is_draw_threadsafe();
+    m_draw_spans.push_back({ object.get(), threadsafe ? size_t(1) : size_t(0), 0, 0, 0, 0 });
+    if (threadsafe)
+      threadsafe_count += 1;
+  }
+
+  if (threadsafe_count < MIN_PARALLEL_DRAW_OBJECTS)
+  {
+    for (const auto& span : m_draw_spans)
+      span.object->draw(context);
+    return;
+  }
+
+  // Every worker gets a contiguous share of the thread-safe objects.
+  const size_t share_count = std::min(thread_pool.get_thread_count(), threadsafe_count);
+  size_t threadsafe_index = 0;
+  for (auto& span : m_draw_spans)
+  {
+    if (span.recording == 0)
+      continue;
+
+    span.recording = 1 + threadsafe_index * share_count / threadsafe_count;
+    threadsafe_index += 1;
+  }
+
+  context.begin_recording(1 + share_count);
+
+  const bool overlay = context.is_overlay();
+  const auto draw_share = [this, &context, overlay](size_t recording_index) {
+    DrawingContext& recording = context.get_recording_context(recording_index);
+    for (auto& span : m_draw_spans)
+    {
+      if (span.recording != recording_index)
+        continue;
+
+      span.color_begin = recording.color().get_request_count();
+      span.light_begin = overlay ? 0 : recording.light().get_request_count();
+      span.object->draw(recording);
+      span.color_end = recording.color().get_request_count();
+      span.light_end = overlay ? 0 : recording.light().get_request_count();
+    }
+  };
+
+  thread_pool.parallel_for(share_count,
+                           [&draw_share](size_t i) { draw_share(1 + i); },
+                           [&draw_share] { draw_share(0); });
+
+  // Appending the requests in object order gives each canvas the same
+  // request order as drawing everything on this thread would.
+  for (const auto& span : m_draw_spans)
+  {
+    DrawingContext& recording = context.get_recording_context(span.recording);
+    context.color().take_requests(recording.color(), span.color_begin, span.color_end);
+    if (!overlay)
+      context.light().take_requests(recording.light(), span.light_begin, span.light_end);
+  }
+
+  context.set_ambient_color(context.get_recording_context(0).get_ambient_color());
+}
+
 void
 GameObjectManager::flush_game_objects()
 {
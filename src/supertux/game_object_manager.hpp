@@ -32,6 +32,7 @@
 
 class DrawingContext;
 class MovingObject;
+class ThreadPool;
 class TileMap;
 
 template<class T> class GameObjectRange;
@@ -333,6 +334,23 @@ private:
   void this_before_object_add(GameObject& object);
   void this_before_object_remove(GameObject& object);
 
+  /** Records the thread-safe objects on the workers of @c thread_pool
+      and the others on this thread, then moves the requests into
+      @c context in object order. */
+  void draw_parallel(DrawingContext& context, ThreadPool& thread_pool);
+
+private:
+  /** Where the requests of an object went during draw_parallel() */
+  struct DrawSpan
+  {
+    GameObject* object;
+    size_t recording;
+    size_t color_begin;
+    size_t color_end;
+    size_t light_begin;
+    size_t light_end;
+  };
+
 protected:
   /** An initial flush_game_objects() call has been initiated. */
   bool m_initialized;
@@ -370,6 +388,8 @@ private:
 
   std::vector<NameResolveRequest> m_name_resolve_requests;
 
+  std::vector<DrawSpan> m_draw_spans;
+
 private:
   GameObjectManager(const GameObjectManager&) = delete;
   GameObjectManager& operator=(const GameObjectManager&) = delete;
@@ -17,6 +17,7 @@
 #include "supertux/game_session.hpp"
 
 #include <cfloat>
+#include <chrono>
 #include <fmt/format.h>
 #include <stdexcept>
 
@@ -47,6 +48,7 @@
 #include "supertux/sector.hpp"
 #include "supertux/shrinkfade.hpp"
 #include "util/file_system.hpp"
+#include "util/reader_document.hpp"
 #include "video/compositor.hpp"
 #include "video/drawing_context.hpp"
 #include "video/surface.hpp"
@@ -69,6 +71,7 @@ GameSession::GameSession(const std::string& levelfile_, Savegame& savegame, Stat
   m_game_pause(false),
   m_speed_before_pause(ScreenManager::current()->get_speed()),
   m_levelfile(levelfile_),
+  m_level_document(),
   m_spawnpoints(),
   m_activated_checkpoint(),
   m_newsector(),
@@ -193,7 +196,21 @@ GameSession::restart_level(bool after_death, bool preserve_music)
   }
 
   try {
-    m_level = LevelParser::from_file(m_levelfile, false, false);
+    const auto load_start = std::chrono::steady_clock::now();
+    const bool reparse = !m_level_document || m_level_document->get_filename() != m_levelfile;
+    if (reparse)
+    {
+      try {
+        m_level_document = std::make_unique<ReaderDocument>(ReaderDocument::from_file(m_levelfile));
+      } catch(std::exception& e) {
+        throw std::runtime_error("Problem when reading level '" + m_levelfile + "': " + e.what());
+      }
+    }
+    m_level = LevelParser::from_document(*m_level_document, false, false);
+
+    log_info << "Level " << (reparse ? "loaded from file" : "rebuilt from memory") << " in "
+             << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - load_start).count()
+             << " ms" << std::endl;
 
     /* Determine the spawnpoint to spawn/respawn Tux to. */
     const GameSession::SpawnPoint* spawnpoint = nullptr;
@@ -41,6 +41,7 @@ class DrawingContext;
 class EndSequence;
 class Level;
 class Player;
+class ReaderDocument;
 class Sector;
 class Statistics;
 class Savegame;
@@ -170,6 +171,10 @@ private:
 
   std::string m_levelfile;
 
+  /** The parsed level file, kept so restarts after a death rebuild the
+      level from memory instead of reading and parsing the file again */
+  std::unique_ptr<ReaderDocument> m_level_document;
+
   // Spawnpoints
   std::vector<SpawnPoint> m_spawnpoints;
   const SpawnPoint* m_activated_checkpoint;
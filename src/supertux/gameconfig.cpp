@@ -63,6 +63,8 @@ Config::Config() :
   music_enabled(true),
   sound_volume(100),
   music_volume(50),
+  stream_lookahead(2.0f),
+  sound_cache_size(32),
   flash_intensity(50),
   random_seed(0), // Set by time(), by default (unless in config).
   enable_script_debugger(false),
@@ -304,6 +306,8 @@ Config::load()
     config_audio_mapping->get("music_enabled", music_enabled);
     config_audio_mapping->get("sound_volume", sound_volume);
     config_audio_mapping->get("music_volume", music_volume);
+    config_audio_mapping->get("stream_lookahead", stream_lookahead);
+    config_audio_mapping->get("sound_cache_size", sound_cache_size);
   }
 
   std::optional<ReaderMapping> config_control_mapping;
@@ -461,6 +465,8 @@ Config::save()
   writer.write("music_enabled", music_enabled);
   writer.write("sound_volume", sound_volume);
   writer.write("music_volume", music_volume);
+  writer.write("stream_lookahead", stream_lookahead);
+  writer.write("sound_cache_size", sound_cache_size);
   writer.end_list("audio");
 
   writer.start_list("control");
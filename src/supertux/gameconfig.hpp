@@ -77,6 +77,12 @@ public:
   bool music_enabled;
   int sound_volume;
   int music_volume;
+
+  /** Seconds of music that get decoded ahead of playback */
+  float stream_lookahead;
+
+  /** Megabytes of decoded sound effects kept in memory */
+  int sound_cache_size;
   int flash_intensity;
 
   /** initial random seed.  0 ==> set from time() */
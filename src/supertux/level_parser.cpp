@@ -19,6 +19,8 @@
 #include <physfs.h>
 #include <sstream>
 
+#include "sprite/sprite_manager.hpp"
+#include "supertux/asset_prefetch.hpp"
 #include "supertux/constants.hpp"
 #include "supertux/level.hpp"
 #include "supertux/sector.hpp"
@@ -27,6 +29,8 @@
 #include "util/reader.hpp"
 #include "util/reader_document.hpp"
 #include "util/reader_mapping.hpp"
+#include "util/timelog.hpp"
+#include "video/texture_manager.hpp"
 
 std::string
 LevelParser::get_level_name(const std::string& filename)
@@ -72,6 +76,15 @@ LevelParser::from_file(const std::string& filename, bool worldmap, bool editable
   return level;
 }
 
+std::unique_ptr<Level>
+LevelParser::from_document(const ReaderDocument& doc, bool worldmap, bool editable)
+{
+  auto level = std::make_unique<Level>(worldmap);
+  LevelParser parser(*level, worldmap, editable);
+  parser.load_document(doc);
+  return level;
+}
+
 std::unique_ptr<Level>
 LevelParser::from_nothing(const std::string& basedir)
 {
@@ -144,6 +157,20 @@ LevelParser::load(const std::string& filepath)
   }
 }
 
+void
+LevelParser::load_document(const ReaderDocument& doc)
+{
+  m_level.m_filename = doc.get_filename();
+  register_translation_directory(doc.get_filename());
+  try {
+    load(doc);
+  } catch(std::exception& e) {
+    std::stringstream msg;
+    msg << "Problem when reading level '" << doc.get_filename() << "': " << e.what();
+    throw std::runtime_error(msg.str());
+  }
+}
+
 void
 LevelParser::load(const ReaderDocument& doc)
 {
@@ -154,6 +181,18 @@ LevelParser::load(const ReaderDocument& doc)
 
   auto level = root.get_mapping();
 
+  // Decode the files the level refers to in the background, while the
+  // objects get built and pick them up.
+  Timelog timelog;
+  timelog.log("scan");
+  AssetPrefetch prefetch;
+  prefetch.scan(doc.get_sexp());
+  log_debug << "[" << doc.get_filename() << "] prefetching " << prefetch.get_count() << " files" << std::endl;
+
+  timelog.log("prefetch");
+  prefetch.start();
+
+  timelog.log("objects");
   int version = 1;
   level.get("version", version);
   if (version == 1)
@@ -207,6 +246,15 @@ LevelParser::load(const ReaderDocument& doc)
   }
 
   m_level.initialize();
+
+  // All objects are built, images and sprites that none of them loaded
+  // would only hold on to their decoded data.
+  if (auto* texture_manager = TextureManager::current())
+    texture_manager->drop_prefetched();
+  if (auto* sprite_manager = SpriteManager::current())
+    sprite_manager->drop_prefetched();
+
+  timelog.log();
 }
 
 void
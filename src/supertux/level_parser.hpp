@@ -28,6 +28,10 @@ class LevelParser final
 public:
   static std::unique_ptr<Level> from_stream(std::istream& stream, const std::string& context, bool worldmap, bool editable);
   static std::unique_ptr<Level> from_file(const std::string& filename, bool worldmap, bool editable);
+  /** Builds the level from an already parsed level file, @c doc can be
+      kept around to build the same level again without touching the
+      file. */
+  static std::unique_ptr<Level> from_document(const ReaderDocument& doc, bool worldmap, bool editable);
   static std::unique_ptr<Level> from_nothing(const std::string& basedir);
   static std::unique_ptr<Level> from_nothing_worldmap(const std::string& basedir, const std::string& name);
 
@@ -39,6 +43,7 @@ private:
   void load(const ReaderDocument& doc);
   void load(std::istream& stream, const std::string& context);
   void load(const std::string& filepath);
+  void load_document(const ReaderDocument& doc);
   void load_old_format(const ReaderMapping& reader);
   void create(const std::string& filepath, const std::string& levelname);
 
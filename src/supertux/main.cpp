@@ -79,6 +79,7 @@ extern "C" {
 #include "supertux/menu/download_dialog.hpp"
 #include "util/file_system.hpp"
 #include "util/gettext.hpp"
+#include "util/reader_cache.hpp"
 #include "util/reader_document.hpp"
 #include "util/reader_mapping.hpp"
 #include "util/string_util.hpp"
@@ -127,6 +128,7 @@ Main::Main() :
   m_config_subsystem(),
   m_sdl_subsystem(),
   m_console_buffer(),
+  m_thread_pool(),
   m_input_manager(),
   m_video_system(),
   m_ttf_surface_manager(),
@@ -508,6 +510,7 @@ Main::launch_game(const CommandLineArguments& args)
 
   m_sdl_subsystem.reset(new SDLSubsystem());
   m_console_buffer.reset(new ConsoleBuffer());
+  m_thread_pool.reset(new ThreadPool());
 #ifdef ENABLE_TOUCHSCREEN_SUPPORT
   if (getenv("ANDROID_TV")) {
     g_config->mobile_controls = false;
@@ -545,6 +548,8 @@ Main::launch_game(const CommandLineArguments& args)
   m_sound_manager->enable_music(g_config->music_enabled);
   m_sound_manager->set_sound_volume(g_config->sound_volume);
   m_sound_manager->set_music_volume(g_config->music_volume);
+  m_sound_manager->set_stream_lookahead(g_config->stream_lookahead);
+  m_sound_manager->set_sound_cache_size(static_cast<size_t>(g_config->sound_cache_size) * 1024 * 1024);
 
   s_timelog.log("scripting");
   m_squirrel_virtual_machine.reset(new SquirrelVirtualMachine(g_config->enable_script_debugger));
@@ -735,6 +740,13 @@ Main::run(int argc, char** argv)
         args.print_acknowledgements();
         return 0;
 
+      case CommandLineArguments::PRECOMPILE_DATA:
+      {
+        const int count = ReaderCache::precompile("/");
+        std::cout << count << " files are in the binary cache" << std::endl;
+        return 0;
+      }
+
       default:
         launch_game(args);
         break;
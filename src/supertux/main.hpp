@@ -36,6 +36,7 @@
 #include "supertux/screen_manager.hpp"
 #include "supertux/tile_manager.hpp"
 #include "supertux/tile_set.hpp"
+#include "util/thread_pool.hpp"
 #include "video/ttf_surface_manager.hpp"
 
 class ConfigSubsystem final
@@ -106,6 +107,7 @@ private:
   std::unique_ptr<ConfigSubsystem> m_config_subsystem;
   std::unique_ptr<SDLSubsystem> m_sdl_subsystem;
   std::unique_ptr<ConsoleBuffer> m_console_buffer;
+  std::unique_ptr<ThreadPool> m_thread_pool;
   std::unique_ptr<InputManager> m_input_manager;
   std::unique_ptr<VideoSystem> m_video_system;
   std::unique_ptr<TTFSurfaceManager> m_ttf_surface_manager;
@@ -26,6 +26,7 @@
 #include "supertux/gameconfig.hpp"
 #include "supertux/globals.hpp"
 #include "supertux/resources.hpp"
+#include "supertux/sector.hpp"
 #include "util/gettext.hpp"
 #include "util/log.hpp"
 #include "video/texture_manager.hpp"
@@ -81,6 +82,11 @@ DebugMenu::DebugMenu() :
 
   add_entry(_("Dump Texture Cache"), []{ TextureManager::current()->debug_print(get_logging_instance()); });
 
+  add_entry(_("Dump Collision Query Stats"), []{
+      if (auto* sector = Sector::current())
+        sector->get_collision_system().debug_print(get_logging_instance());
+    });
+
   add_hl();
   add_back(_("Back"));
 }
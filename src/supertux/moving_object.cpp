@@ -38,10 +38,10 @@ MovingObject::MovingObject(const ReaderMapping& reader) :
   float height, width;
 
   if (reader.get("width", width))
-    m_col.m_bbox.set_width(width);
+    m_col.set_bbox_width(width);
 
   if (reader.get("height", height))
-    m_col.m_bbox.set_height(height);
+    m_col.set_bbox_height(height);
 
   reader.get("x", m_col.m_bbox.get_left());
   reader.get("y", m_col.m_bbox.get_top());
@@ -72,7 +72,7 @@ public:
   }
   virtual void move(const Vector& dist)
   {
-    m_col.m_bbox.move(dist);
+    m_col.move_bbox(dist);
   }
 
   Vector get_pos() const
@@ -32,6 +32,8 @@
 
 static const int START_COINS = 100;
 static const int MAX_COINS = 9999;
+static const SoundManager::SoundId LIFEUP_SOUND = SoundManager::get_sound_id("sounds/lifeup.wav");
+static const SoundManager::SoundId COIN_SOUND = SoundManager::get_sound_id("sounds/coin.wav");
 
 PlayerStatus::PlayerStatus(int num_players) :
   m_num_players(num_players),
@@ -167,9 +169,9 @@ PlayerStatus::add_coins(int count, bool play_sound)
 
   static float sound_played_time = 0;
   if (count >= 100)
-    SoundManager::current()->play("sounds/lifeup.wav");
+    SoundManager::current()->play(LIFEUP_SOUND);
   else if (g_real_time > sound_played_time + 0.010f) {
-    SoundManager::current()->play("sounds/coin.wav");
+    SoundManager::current()->play(COIN_SOUND);
     sound_played_time = g_real_time;
   }
 }
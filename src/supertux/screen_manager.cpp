@@ -40,8 +40,10 @@
 #include "supertux/screen_fade.hpp"
 #include "supertux/sector.hpp"
 #include "util/log.hpp"
+#include "video/canvas.hpp"
 #include "video/compositor.hpp"
 #include "video/drawing_context.hpp"
+#include "video/ttf_surface_manager.hpp"
 
 #include <stdio.h>
 #include <chrono>
@@ -228,6 +230,47 @@ ScreenManager::draw_fps(DrawingContext& context, FPS_Stats& fps_statistics)
   pos.x -= w2;
   context.color().draw_text(Resources::small_font, str1,
     pos, ALIGN_RIGHT, LAYER_HUD);
+
+  // Requests of the last frame, before and after the canvases merged them
+  pos = Vector(context.get_width() - BORDER_X, pos.y + 20);
+  context.color().draw_text(Resources::small_font, "Draw calls  before / after",
+    pos, ALIGN_RIGHT, LAYER_HUD);
+  snprintf(str1, str_length, "%d / %d",
+    Canvas::s_draw_call_stats.before_merge, Canvas::s_draw_call_stats.after_merge);
+  pos.y += 15;
+  context.color().draw_text(Resources::small_font, str1,
+    pos, ALIGN_RIGHT, LAYER_HUD);
+
+  // Time and draw calls of the lightmap in the last frame
+  pos = Vector(context.get_width() - BORDER_X, pos.y + 20);
+  context.color().draw_text(Resources::small_font, "Lightmap  ms / draw calls",
+    pos, ALIGN_RIGHT, LAYER_HUD);
+  snprintf(str1, str_length, "%s%.2f / %d",
+    Compositor::s_lightmap_stats.reused ? "reused  " : "",
+    static_cast<double>(Compositor::s_lightmap_stats.milliseconds),
+    Compositor::s_lightmap_stats.draw_calls);
+  pos.y += 15;
+  context.color().draw_text(Resources::small_font, str1,
+    pos, ALIGN_RIGHT, LAYER_HUD);
+
+  // Text rendering work of the last second
+  const TTFSurfaceManager::Stats& text_stats = TTFSurfaceManager::current()->get_stats();
+  pos = Vector(context.get_width() - BORDER_X, pos.y + 20);
+  context.color().draw_text(Resources::small_font, "Glyph fills / text uploads per s",
+    pos, ALIGN_RIGHT, LAYER_HUD);
+  snprintf(str1, str_length, "%d / %d", text_stats.glyph_fills, text_stats.texture_uploads);
+  pos.y += 15;
+  context.color().draw_text(Resources::small_font, str1,
+    pos, ALIGN_RIGHT, LAYER_HUD);
+
+  // Streamed sounds that ran dry since the start
+  pos = Vector(context.get_width() - BORDER_X, pos.y + 20);
+  context.color().draw_text(Resources::small_font, "Audio underruns",
+    pos, ALIGN_RIGHT, LAYER_HUD);
+  snprintf(str1, str_length, "%d", SoundManager::current()->get_stream_underruns());
+  pos.y += 15;
+  context.color().draw_text(Resources::small_font, str1,
+    pos, ALIGN_RIGHT, LAYER_HUD);
 }
 
 void
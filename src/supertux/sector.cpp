@@ -417,6 +417,9 @@ Sector::before_object_remove(GameObject& object)
   if (moving_object) {
     m_collision_system->remove(moving_object->get_collision_object());
   }
+  else if (auto* tilemap = dynamic_cast<TileMap*>(&object)) {
+    tilemap->clear_bottom_collision_list();
+  }
 
   if (s_current == this)
     m_squirrel_environment->unexpose(object.get_name());
@@ -228,6 +228,7 @@ public:
   Camera& get_camera() const;
   DisplayEffect& get_effect() const;
   inline TextObject& get_text_object() const { return m_text_object; }
+  inline CollisionSystem& get_collision_system() const { return *m_collision_system; }
 
   std::vector<Player*> get_players() const;
 
@@ -141,6 +141,10 @@ public:
 
   inline bool is_deprecated() const { return m_deprecated; }
 
+  /** Whether get_current_surface() or get_current_editor_surface()
+      depend on the game time */
+  inline bool is_animated() const { return m_images.size() > 1 || m_editor_images.size() > 1; }
+
   inline const std::string& get_object_name() const { return m_object_name; }
   inline const std::string& get_object_data() const { return m_object_data; }
 
@@ -481,7 +481,7 @@ std::vector<SurfacePtr>
     if (iter.is_string())
     {
       std::string file = iter.as_string_item();
-      surfaces.push_back(Surface::from_file(FileSystem::join(m_tiles_path, file), surface_region));
+      surfaces.push_back(Surface::from_file_packed(FileSystem::join(m_tiles_path, file), surface_region));
     }
     else if (iter.is_pair() && iter.get_key() == "surface")
     {
@@ -514,8 +514,8 @@ std::vector<SurfacePtr>
           rect.bottom = rect.top + surface_region->get_height();
         }
 
-        surfaces.push_back(Surface::from_file(FileSystem::join(m_tiles_path, file),
-                                              rect));
+        surfaces.push_back(Surface::from_file_packed(FileSystem::join(m_tiles_path, file),
+                                                     rect));
       }
     }
     else
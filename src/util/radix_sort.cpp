@@ -0,0 +1,60 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "util/radix_sort.hpp"
+
+#include <array>
+#include <utility>
+
+void
+radix_sort(std::vector<uint64_t>& keys, std::vector<uint64_t>& scratch)
+{
+  const size_t count = keys.size();
+  if (count < 2)
+    return;
+
+  // Build the histograms of all eight bytes in a single pass.
+  std::array<std::array<size_t, 256>, 8> histograms = {};
+  for (const uint64_t key : keys)
+    for (size_t byte = 0; byte < 8; ++byte)
+      ++histograms[byte][(key >> (byte * 8)) & 0xff];
+
+  scratch.resize(count);
+
+  for (size_t byte = 0; byte < 8; ++byte)
+  {
+    auto& histogram = histograms[byte];
+    const size_t shift = byte * 8;
+
+    // Every key has the same value here, the pass wouldn't move anything.
+    if (histogram[(keys[0] >> shift) & 0xff] == count)
+      continue;
+
+    size_t offset = 0;
+    for (auto& bucket : histogram)
+    {
+      const size_t bucket_count = bucket;
+      bucket = offset;
+      offset += bucket_count;
+    }
+
+    for (const uint64_t key : keys)
+      scratch[histogram[(key >> shift) & 0xff]++] = key;
+
+    std::swap(keys, scratch);
+  }
+}
@@ -0,0 +1,325 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "util/reader_binary.hpp"
+
+#include <stdexcept>
+#include <string.h>
+#include <vector>
+
+namespace {
+
+const char MAGIC[4] = { 'S', 'T', 'D', 'B' };
+
+// Written in host order, data from a machine with a different byte
+// order is rejected instead of converted.
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+// Shorter runs of integers are cheaper to store one by one.
+const size_t MIN_INTEGER_RUN = 4;
+
+enum Tag : uint8_t
+{
+  TAG_NIL,
+  TAG_FALSE,
+  TAG_TRUE,
+  TAG_INTEGER,
+  TAG_REAL,
+  TAG_STRING,
+  TAG_SYMBOL,
+  TAG_ARRAY,
+  /** Only inside arrays, stands for several integer elements */
+  TAG_INTEGER_RUN
+};
+
+template<typename T>
+void write_raw(std::string& out, const T& value)
+{
+  out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void write_string(std::string& out, const std::string& value)
+{
+  write_raw(out, static_cast<uint32_t>(value.size()));
+  out.append(value);
+}
+
+void write_value(std::string& out, const sexp::Value& sx)
+{
+  const int32_t line = sx.get_line();
+
+  if (sx.is_nil())
+  {
+    write_raw(out, TAG_NIL);
+    write_raw(out, line);
+  }
+  else if (sx.is_boolean())
+  {
+    write_raw(out, sx.as_bool() ? TAG_TRUE : TAG_FALSE);
+    write_raw(out, line);
+  }
+  else if (sx.is_integer())
+  {
+    write_raw(out, TAG_INTEGER);
+    write_raw(out, line);
+    write_raw(out, static_cast<int32_t>(sx.as_int()));
+  }
+  else if (sx.is_real())
+  {
+    write_raw(out, TAG_REAL);
+    write_raw(out, line);
+    write_raw(out, sx.as_float());
+  }
+  else if (sx.is_string())
+  {
+    write_raw(out, TAG_STRING);
+    write_raw(out, line);
+    write_string(out, sx.as_string());
+  }
+  else if (sx.is_symbol())
+  {
+    write_raw(out, TAG_SYMBOL);
+    write_raw(out, line);
+    write_string(out, sx.as_string());
+  }
+  else if (sx.is_array())
+  {
+    const auto& arr = sx.as_array();
+    write_raw(out, TAG_ARRAY);
+    write_raw(out, line);
+    write_raw(out, static_cast<uint32_t>(arr.size()));
+
+    for (size_t i = 0; i < arr.size();)
+    {
+      // Runs end at line breaks, so every element keeps its line.
+      size_t run_end = i;
+      while (run_end < arr.size() && arr[run_end].is_integer() &&
+             arr[run_end].get_line() == arr[i].get_line())
+        ++run_end;
+
+      if (run_end - i < MIN_INTEGER_RUN)
+      {
+        write_value(out, arr[i]);
+        ++i;
+        continue;
+      }
+
+      write_raw(out, TAG_INTEGER_RUN);
+      write_raw(out, static_cast<int32_t>(arr[i].get_line()));
+      write_raw(out, static_cast<uint32_t>(run_end - i));
+      for (; i < run_end; ++i)
+        write_raw(out, static_cast<int32_t>(arr[i].as_int()));
+    }
+  }
+  else
+  {
+    throw std::runtime_error("ReaderBinary: can't store value, only documents parsed with arrays are supported");
+  }
+}
+
+class BinaryReader final
+{
+public:
+  BinaryReader(const char* data, size_t size) :
+    m_pos(data),
+    m_end(data + size)
+  {
+  }
+
+  template<typename T>
+  bool read(T& value)
+  {
+    if (static_cast<size_t>(m_end - m_pos) < sizeof(T))
+      return false;
+
+    memcpy(&value, m_pos, sizeof(T));
+    m_pos += sizeof(T);
+    return true;
+  }
+
+  bool read_string(std::string& value)
+  {
+    uint32_t size;
+    if (!read(size) || static_cast<size_t>(m_end - m_pos) < size)
+      return false;
+
+    value.assign(m_pos, size);
+    m_pos += size;
+    return true;
+  }
+
+  bool read_integers(std::vector<sexp::Value>& arr, uint32_t count, int32_t line)
+  {
+    if (static_cast<size_t>(m_end - m_pos) / sizeof(int32_t) < count)
+      return false;
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      int32_t value;
+      memcpy(&value, m_pos, sizeof(value));
+      m_pos += sizeof(value);
+
+      arr.push_back(sexp::Value::integer(value));
+      arr.back().set_line(line);
+    }
+    return true;
+  }
+
+  bool at_end() const { return m_pos == m_end; }
+
+  std::optional<sexp::Value> read_value()
+  {
+    uint8_t tag;
+    int32_t line;
+    if (!read(tag) || !read(line))
+      return std::nullopt;
+
+    std::optional<sexp::Value> result;
+    switch (tag)
+    {
+      case TAG_NIL:
+        result = sexp::Value::nil();
+        break;
+
+      case TAG_FALSE:
+      case TAG_TRUE:
+        result = sexp::Value::boolean(tag == TAG_TRUE);
+        break;
+
+      case TAG_INTEGER:
+      {
+        int32_t value;
+        if (!read(value))
+          return std::nullopt;
+        result = sexp::Value::integer(value);
+        break;
+      }
+
+      case TAG_REAL:
+      {
+        float value;
+        if (!read(value))
+          return std::nullopt;
+        result = sexp::Value::real(value);
+        break;
+      }
+
+      case TAG_STRING:
+      case TAG_SYMBOL:
+      {
+        std::string value;
+        if (!read_string(value))
+          return std::nullopt;
+        result = (tag == TAG_STRING) ? sexp::Value::string(value) : sexp::Value::symbol(value);
+        break;
+      }
+
+      case TAG_ARRAY:
+      {
+        uint32_t count;
+        // No element takes less than the four bytes of an integer in a run.
+        if (!read(count) || static_cast<size_t>(m_end - m_pos) / sizeof(int32_t) < count)
+          return std::nullopt;
+
+        std::vector<sexp::Value> arr;
+        arr.reserve(count);
+        while (arr.size() < count)
+        {
+          if (peek_integer_run())
+          {
+            uint32_t run_count;
+            int32_t run_line;
+            m_pos += 1;
+            if (!read(run_line) || !read(run_count) ||
+                run_count > count - arr.size() ||
+                !read_integers(arr, run_count, run_line))
+              return std::nullopt;
+          }
+          else
+          {
+            auto element = read_value();
+            if (!element)
+              return std::nullopt;
+            arr.push_back(std::move(*element));
+          }
+        }
+        result = sexp::Value::array(std::move(arr));
+        break;
+      }
+
+      default:
+        return std::nullopt;
+    }
+
+    result->set_line(line);
+    return result;
+  }
+
+private:
+  bool peek_integer_run() const
+  {
+    return m_pos < m_end && static_cast<uint8_t>(*m_pos) == TAG_INTEGER_RUN;
+  }
+
+private:
+  const char* m_pos;
+  const char* m_end;
+
+private:
+  BinaryReader(const BinaryReader&) = delete;
+  BinaryReader& operator=(const BinaryReader&) = delete;
+};
+
+} // namespace
+
+namespace ReaderBinary {
+
+const uint32_t VERSION = 1;
+
+void
+write(const sexp::Value& sx, const std::string& key, std::string& out)
+{
+  out.append(MAGIC, sizeof(MAGIC));
+  write_raw(out, VERSION);
+  write_raw(out, BYTE_ORDER_MARK);
+  write_string(out, key);
+  write_value(out, sx);
+}
+
+std::optional<sexp::Value>
+read(const char* data, size_t size, const std::string& key)
+{
+  if (size < sizeof(MAGIC) || memcmp(data, MAGIC, sizeof(MAGIC)) != 0)
+    return std::nullopt;
+
+  BinaryReader reader(data + sizeof(MAGIC), size - sizeof(MAGIC));
+
+  uint32_t version;
+  uint32_t byte_order_mark;
+  std::string stored_key;
+  if (!reader.read(version) || version != VERSION ||
+      !reader.read(byte_order_mark) || byte_order_mark != BYTE_ORDER_MARK ||
+      !reader.read_string(stored_key) || stored_key != key)
+    return std::nullopt;
+
+  auto result = reader.read_value();
+  if (!reader.at_end())
+    return std::nullopt;
+  return result;
+}
+
+} // namespace ReaderBinary
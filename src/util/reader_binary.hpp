@@ -0,0 +1,44 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <optional>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <sexp/value.hpp>
+
+/** Versioned binary form of parsed documents, so they can be cached
+    and loaded again without going through the text parser. Runs of
+    integers, like the tiles of a tilemap, are stored as plain blocks
+    that are read without touching every element on its own. */
+namespace ReaderBinary {
+
+/** Bumped whenever the layout changes, data of other versions is ignored */
+extern const uint32_t VERSION;
+
+/** Appends the binary form of @c sx to @c out. @c key identifies the
+    source of the data, usually a hash of the text it was parsed from.
+    Throws if @c sx contains values that can't be stored. */
+void write(const sexp::Value& sx, const std::string& key, std::string& out);
+
+/** Rebuilds a value from @c data, returns std::nullopt if @c data has
+    a different version or key or is damaged. */
+std::optional<sexp::Value> read(const char* data, size_t size, const std::string& key);
+
+} // namespace ReaderBinary
@@ -0,0 +1,146 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "util/reader_cache.hpp"
+
+#include <physfs.h>
+#include <iostream>
+#include <unordered_set>
+#include <vector>
+
+#include "addon/md5.hpp"
+#include "physfs/util.hpp"
+#include "util/file_system.hpp"
+#include "util/log.hpp"
+#include "util/reader_binary.hpp"
+#include "util/reader_document.hpp"
+#include "util/string_util.hpp"
+
+namespace {
+
+const char* const CACHE_DIRECTORY = "cache/documents";
+const char* const CACHE_EXTENSION = ".stdb";
+
+std::string get_cache_filename(const std::string& key)
+{
+  return FileSystem::join(CACHE_DIRECTORY, key + CACHE_EXTENSION);
+}
+
+} // namespace
+
+namespace ReaderCache {
+
+bool
+is_cacheable(const std::string& filename)
+{
+  return StringUtil::has_suffix(filename, ".stl") ||
+         StringUtil::has_suffix(filename, ".stwm") ||
+         StringUtil::has_suffix(filename, ".strf") ||
+         StringUtil::has_suffix(filename, ".sprite");
+}
+
+bool
+is_available()
+{
+  // Only precompile() creates the directory.
+  return PHYSFS_exists(CACHE_DIRECTORY) != 0;
+}
+
+std::string
+get_key(const std::string& text)
+{
+  MD5 md5;
+  md5.update(reinterpret_cast<uint8_t*>(const_cast<char*>(text.data())),
+             static_cast<unsigned int>(text.size()));
+  return md5.hex_digest();
+}
+
+std::optional<sexp::Value>
+load(const std::string& key)
+{
+  const std::string filename = get_cache_filename(key);
+  if (!PHYSFS_exists(filename.c_str()))
+    return std::nullopt;
+
+  std::string data;
+  if (!physfsutil::read_file(filename, data))
+    return std::nullopt;
+
+  // Outdated entries are ignored, precompile() removes them.
+  return ReaderBinary::read(data.data(), data.size(), key);
+}
+
+void
+store(const std::string& key, const sexp::Value& sx)
+{
+  std::string data;
+  ReaderBinary::write(sx, key, data);
+
+  if (!PHYSFS_exists(CACHE_DIRECTORY) && !PHYSFS_mkdir(CACHE_DIRECTORY))
+    throw std::runtime_error(std::string("Couldn't create ") + CACHE_DIRECTORY + ": " + physfsutil::get_last_error());
+
+  const std::string filename = get_cache_filename(key);
+  if (!physfsutil::write_file(filename, data))
+    throw std::runtime_error("Couldn't write " + filename + ": " + physfsutil::get_last_error());
+}
+
+int
+precompile(const std::string& directory)
+{
+  std::unordered_set<std::string> keys;
+
+  physfsutil::enumerate_files_recurse(directory, [&keys](const std::string& filename) {
+    if (!is_cacheable(filename))
+      return false;
+
+    try
+    {
+      std::string text;
+      if (!physfsutil::read_file(filename, text))
+        throw std::runtime_error(physfsutil::get_last_error());
+
+      const std::string key = get_key(text);
+      if (keys.find(key) == keys.end() && !load(key))
+      {
+        const auto doc = ReaderDocument::from_string(text, filename);
+        store(key, doc.get_sexp());
+        std::cout << "Precompiled " << filename << std::endl;
+      }
+      keys.insert(key);
+    }
+    catch (const std::exception& err)
+    {
+      log_warning << "Couldn't precompile " << filename << ": " << err.what() << std::endl;
+    }
+    return false;
+  });
+
+  // Entries of files that changed or are gone would never be used again.
+  std::vector<std::string> outdated;
+  physfsutil::enumerate_files(CACHE_DIRECTORY, [&keys, &outdated](const std::string& filename) {
+    const std::string key = filename.substr(0, filename.find('.'));
+    if (keys.find(key) == keys.end())
+      outdated.push_back(FileSystem::join(CACHE_DIRECTORY, filename));
+    return false;
+  });
+  for (const auto& filename : outdated)
+    physfsutil::remove(filename);
+
+  return static_cast<int>(keys.size());
+}
+
+} // namespace ReaderCache
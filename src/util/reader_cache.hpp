@@ -0,0 +1,51 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <sexp/value.hpp>
+
+/** Keeps the parsed form of data files in the user directory, stored
+    with ReaderBinary. Entries are named after the MD5 of the text they
+    were parsed from, so a changed file simply misses the cache and is
+    parsed as text again. */
+namespace ReaderCache {
+
+/** Levels, worldmaps, tilesets and sprites are looked up in the cache */
+bool is_cacheable(const std::string& filename);
+
+/** Whether there is a cache directory, without it files aren't hashed */
+bool is_available();
+
+/** Returns the cache key for the content of a file */
+std::string get_key(const std::string& text);
+
+/** Returns the cached document for @c key, if there is a valid one.
+    Doesn't log, so that it can be used on worker threads. */
+std::optional<sexp::Value> load(const std::string& key);
+
+/** Stores @c sx as the cached document for @c key */
+void store(const std::string& key, const sexp::Value& sx);
+
+/** Parses every cacheable file below @c directory and stores the
+    results, entries that no longer belong to any file are removed.
+    Returns the number of files that are in the cache afterwards. */
+int precompile(const std::string& directory);
+
+} // namespace ReaderCache
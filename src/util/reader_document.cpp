@@ -20,8 +20,10 @@
 #include <sstream>
 
 #include "physfs/ifile_stream.hpp"
+#include "physfs/util.hpp"
 #include "util/file_system.hpp"
 #include "util/log.hpp"
+#include "util/reader_cache.hpp"
 
 ReaderDocument
 ReaderDocument::from_string(const std::string& string, const std::string& filename, int depth)
@@ -41,6 +43,24 @@ ReaderDocument
 ReaderDocument::from_file(const std::string& filename, int depth)
 {
   log_debug << "ReaderDocument::parse: " << filename << std::endl;
+  return from_file_silent(filename, depth);
+}
+
+ReaderDocument
+ReaderDocument::from_file_silent(const std::string& filename, int depth)
+{
+  if (depth < 0 && ReaderCache::is_cacheable(filename) && ReaderCache::is_available())
+  {
+    std::string text;
+    if (!physfsutil::read_file(filename, text))
+      throw std::runtime_error("Parser problem: Couldn't open file '" + filename + "'.");
+
+    const std::string key = ReaderCache::get_key(text);
+    if (auto sx = ReaderCache::load(key))
+      return ReaderDocument(filename, std::move(*sx));
+
+    return from_string(text, filename, depth);
+  }
 
   IFileStream in(filename);
   if (!in.good()) {
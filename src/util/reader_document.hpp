@@ -30,6 +30,10 @@ public:
   static ReaderDocument from_stream(std::istream& stream, const std::string& filename = "<stream>", int depth = -1);
   static ReaderDocument from_file(const std::string& filename, int depth = -1);
 
+  /** Like from_file(), but doesn't log, so that it can be used on
+      worker threads */
+  static ReaderDocument from_file_silent(const std::string& filename, int depth = -1);
+
 public:
   ReaderDocument(const std::string& filename, sexp::Value sx);
 
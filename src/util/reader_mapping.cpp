@@ -30,7 +30,8 @@ bool ReaderMapping::s_translations_enabled = true;
 ReaderMapping::ReaderMapping(const ReaderDocument& doc, const sexp::Value& sx) :
   m_doc(doc),
   m_sx(sx),
-  m_arr([this]() -> decltype(m_arr){ assert_is_array(m_doc, m_sx); return m_sx.as_array();}())
+  m_arr([this]() -> decltype(m_arr){ assert_is_array(m_doc, m_sx); return m_sx.as_array();}()),
+  m_index()
 {
 }
 
@@ -48,6 +49,23 @@ ReaderMapping::get_item(const char* key) const
   if (!key || !key[0]) // Check whether key is valid and non-empty
     return nullptr;
 
+  if (m_arr.size() > ReaderMappingIndex::MIN_SIZE)
+  {
+    if (!m_index.is_built())
+    {
+      // Report broken children the same way the scan below would.
+      for (size_t i = 1; i < m_arr.size(); ++i)
+      {
+        assert_array_size_ge(m_doc, m_arr[i], 1);
+        assert_is_symbol(m_doc, m_arr[i].as_array()[0]);
+      }
+      m_index.build(m_arr);
+    }
+
+    const size_t index = m_index.find(m_arr, key);
+    return index ? &m_arr[index] : nullptr;
+  }
+
   for (size_t i = 1; i < m_arr.size(); ++i)
   {
     auto const& pair = m_arr[i];
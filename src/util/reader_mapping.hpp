@@ -20,6 +20,7 @@
 #include <optional>
 
 #include "util/reader_iterator.hpp"
+#include "util/reader_mapping_index.hpp"
 #include "util/uid.hpp"
 
 namespace sexp {
@@ -96,4 +97,8 @@ private:
   const ReaderDocument& m_doc;
   const sexp::Value& m_sx;
   const std::vector<sexp::Value>& m_arr;
+
+  /** Built on the first lookup in larger mappings, as objects look up
+      dozens of keys each. */
+  mutable ReaderMappingIndex m_index;
 };
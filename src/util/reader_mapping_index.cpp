@@ -0,0 +1,105 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "util/reader_mapping_index.hpp"
+
+#include <assert.h>
+#include <sexp/value.hpp>
+#include <string.h>
+
+namespace {
+
+uint32_t hash_key(const char* key, size_t length)
+{
+  // FNV-1a, keys are short identifiers.
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < length; ++i)
+  {
+    hash ^= static_cast<uint8_t>(key[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+const std::string* get_key(const sexp::Value& child)
+{
+  if (!child.is_array() || child.as_array().empty() || !child.as_array()[0].is_symbol())
+    return nullptr;
+  return &child.as_array()[0].as_string();
+}
+
+} // namespace
+
+ReaderMappingIndex::ReaderMappingIndex() :
+  m_slots()
+{
+}
+
+void
+ReaderMappingIndex::build(const std::vector<sexp::Value>& arr)
+{
+  // Keep the table at most half full, so probe sequences stay short.
+  size_t size = 16;
+  while (size < arr.size() * 2)
+    size *= 2;
+  m_slots.assign(size, 0);
+
+  const size_t mask = size - 1;
+  for (size_t i = 1; i < arr.size(); ++i)
+  {
+    const std::string* key = get_key(arr[i]);
+    if (!key)
+      continue;
+
+    const uint64_t hash = hash_key(key->data(), key->size());
+    for (size_t slot = hash & mask;; slot = (slot + 1) & mask)
+    {
+      if (m_slots[slot] == 0)
+      {
+        m_slots[slot] = (hash << 32) | i;
+        break;
+      }
+
+      // The first child with a key wins, like in a linear scan.
+      if ((m_slots[slot] >> 32) == hash &&
+          *get_key(arr[m_slots[slot] & 0xffffffff]) == *key)
+        break;
+    }
+  }
+}
+
+size_t
+ReaderMappingIndex::find(const std::vector<sexp::Value>& arr, const char* key) const
+{
+  assert(is_built());
+
+  const size_t length = strlen(key);
+  const uint64_t hash = hash_key(key, length);
+  const size_t mask = m_slots.size() - 1;
+
+  for (size_t slot = hash & mask; m_slots[slot] != 0; slot = (slot + 1) & mask)
+  {
+    if ((m_slots[slot] >> 32) != hash)
+      continue;
+
+    const size_t index = m_slots[slot] & 0xffffffff;
+    const std::string& candidate = *get_key(arr[index]);
+    if (candidate.size() == length && memcmp(candidate.data(), key, length) == 0)
+      return index;
+  }
+  return 0;
+}
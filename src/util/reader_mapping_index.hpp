@@ -0,0 +1,55 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace sexp {
+class Value;
+} // namespace sexp
+
+/** Open-addressed hash index over the (key value...) children of a
+    mapping, so looking up a key doesn't compare it against every other
+    key of the mapping. */
+class ReaderMappingIndex final
+{
+public:
+  /** Mappings with fewer children are faster to scan than to index */
+  static const size_t MIN_SIZE = 8;
+
+public:
+  ReaderMappingIndex();
+
+  /** Indexes the children of @c arr, the first element is the name of
+      the mapping and is skipped, as are children that don't start with
+      a symbol. */
+  void build(const std::vector<sexp::Value>& arr);
+
+  /** Returns the position of the first child in @c arr with the given
+      key, 0 if there's none. @c arr must be the array passed to build(). */
+  size_t find(const std::vector<sexp::Value>& arr, const char* key) const;
+
+  inline bool is_built() const { return !m_slots.empty(); }
+
+private:
+  /** The hash of the key in the upper 32 bits and the position of the
+      child in the lower ones, 0 marks empty slots. */
+  std::vector<uint64_t> m_slots;
+};
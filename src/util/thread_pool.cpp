@@ -0,0 +1,204 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "util/thread_pool.hpp"
+
+#include <algorithm>
+#include <system_error>
+
+namespace {
+
+// More workers rarely pay off for the small loops of a game frame.
+const size_t MAX_WORKERS = 7;
+
+size_t default_worker_count()
+{
+#ifdef __EMSCRIPTEN__
+  return 0;
+#else
+  const size_t cores = std::thread::hardware_concurrency();
+  return std::min(cores > 1 ? cores - 1 : 0, MAX_WORKERS);
+#endif
+}
+
+} // namespace
+
+ThreadPool::ThreadPool() :
+  ThreadPool(default_worker_count())
+{
+}
+
+ThreadPool::ThreadPool(size_t worker_count) :
+  m_workers(),
+  m_mutex(),
+  m_work_cv(),
+  m_done_cv(),
+  m_task(nullptr),
+  m_task_count(0),
+  m_next_index(0),
+  m_exception(),
+  m_jobs(),
+  m_generation(0),
+  m_active_workers(0),
+  m_quit(false)
+{
+  for (size_t i = 0; i < worker_count; ++i)
+  {
+    try
+    {
+      m_workers.emplace_back(&ThreadPool::run_worker, this);
+    }
+    catch (const std::system_error&)
+    {
+      // Go on with the workers we have, the caller always takes part.
+      break;
+    }
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_quit = true;
+  }
+  m_work_cv.notify_all();
+
+  for (auto& worker : m_workers)
+    worker.join();
+}
+
+void
+ThreadPool::parallel_for(size_t count, const std::function<void(size_t)>& task,
+                         const std::function<void()>& caller_task)
+{
+  if (m_workers.empty() || count == 0)
+  {
+    if (caller_task)
+      caller_task();
+    for (size_t i = 0; i < count; ++i)
+      task(i);
+    return;
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    // Workers that woke up late for the previous loop may still be
+    // looking at it.
+    m_done_cv.wait(lock, [this]{ return m_active_workers == 0; });
+
+    m_task = &task;
+    m_task_count = count;
+    m_next_index = 0;
+    m_exception = nullptr;
+    m_generation += 1;
+  }
+  m_work_cv.notify_all();
+
+  if (caller_task)
+  {
+    try
+    {
+      caller_task();
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (!m_exception)
+        m_exception = std::current_exception();
+    }
+  }
+
+  run_tasks();
+
+  std::exception_ptr exception;
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done_cv.wait(lock, [this]{ return m_active_workers == 0; });
+    m_task = nullptr;
+    std::swap(exception, m_exception);
+  }
+
+  if (exception)
+    std::rethrow_exception(exception);
+}
+
+void
+ThreadPool::run_worker()
+{
+  uint64_t generation = 0;
+  while (true)
+  {
+    std::function<void()> job;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_work_cv.wait(lock, [this, generation]{
+        return m_quit || m_generation != generation || !m_jobs.empty();
+      });
+      if (m_quit)
+        return;
+
+      if (m_generation != generation)
+      {
+        generation = m_generation;
+        m_active_workers += 1;
+      }
+      else
+      {
+        job = std::move(m_jobs.front());
+        m_jobs.pop_front();
+      }
+    }
+
+    if (job)
+    {
+      // Jobs report their exceptions through their future.
+      job();
+      continue;
+    }
+
+    run_tasks();
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_active_workers -= 1;
+    }
+    m_done_cv.notify_all();
+  }
+}
+
+void
+ThreadPool::run_tasks()
+{
+  while (true)
+  {
+    const size_t index = m_next_index.fetch_add(1);
+    if (index >= m_task_count)
+      return;
+
+    try
+    {
+      (*m_task)(index);
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (!m_exception)
+        m_exception = std::current_exception();
+    }
+  }
+}
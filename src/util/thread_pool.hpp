@@ -0,0 +1,110 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "util/currenton.hpp"
+
+/** A fixed set of worker threads that share loops with the thread
+    calling parallel_for() and run background jobs from schedule(). */
+class ThreadPool final : public Currenton<ThreadPool>
+{
+public:
+  /** Starts @c worker_count threads, by default one less than the
+      number of cores, as the calling thread does its share of the work. */
+  ThreadPool();
+  ThreadPool(size_t worker_count);
+  ~ThreadPool() override;
+
+  /** Calls @c task for every index in [0, count) on the workers and the
+      calling thread and returns once all calls are done. If given,
+      @c caller_task runs on the calling thread first, while the workers
+      already start on the loop. The first exception thrown by any of
+      the calls is rethrown afterwards. */
+  void parallel_for(size_t count, const std::function<void(size_t)>& task,
+                    const std::function<void()>& caller_task = {});
+
+  /** Runs @c task on a worker in the background, the result or the
+      exception thrown by @c task is delivered through the returned
+      future. Loops from parallel_for() take priority over waiting jobs.
+      Without workers @c task runs right away on the calling thread. */
+  template<typename F>
+  std::future<std::invoke_result_t<F>> schedule(F task)
+  {
+    using Result = std::invoke_result_t<F>;
+    auto job = std::make_shared<std::packaged_task<Result()>>(std::move(task));
+    std::future<Result> future = job->get_future();
+
+    if (m_workers.empty())
+    {
+      (*job)();
+      return future;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_jobs.push_back([job]{ (*job)(); });
+    }
+    m_work_cv.notify_one();
+    return future;
+  }
+
+  /** Number of threads taking part in parallel_for(), including the caller */
+  inline size_t get_thread_count() const { return m_workers.size() + 1; }
+
+private:
+  void run_worker();
+  void run_tasks();
+
+private:
+  std::vector<std::thread> m_workers;
+
+  std::mutex m_mutex;
+  std::condition_variable m_work_cv;
+  std::condition_variable m_done_cv;
+
+  /** The loop that is currently running, only changed while no worker
+      is in run_tasks(). */
+  const std::function<void(size_t)>* m_task;
+  size_t m_task_count;
+  std::atomic<size_t> m_next_index;
+  std::exception_ptr m_exception;
+
+  /** Jobs from schedule() that no worker has picked up yet */
+  std::deque<std::function<void()>> m_jobs;
+
+  uint64_t m_generation;
+  int m_active_workers;
+  bool m_quit;
+
+private:
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+};
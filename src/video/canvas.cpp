@@ -18,23 +18,147 @@
 
 #include <algorithm>
 #include <array>
+#include <cstring>
 
 #include "supertux/globals.hpp"
 #include "util/log.hpp"
 #include "util/obstackpp.hpp"
+#include "util/radix_sort.hpp"
 #include "video/drawing_context.hpp"
 #include "video/drawing_request.hpp"
 #include "video/painter.hpp"
 #include "video/renderer.hpp"
 #include "video/surface.hpp"
+#include "video/texture_mesh.hpp"
 #include "video/video_system.hpp"
 
+namespace {
+
+/** Requests on different sides of the lightmap are drawn by different
+    render() calls, so they must never be merged. */
+int get_lightmap_side(int layer)
+{
+  return (layer > LAYER_LIGHTMAP) - (layer < LAYER_LIGHTMAP);
+}
+
+bool is_solid(const DrawingRequest& request)
+{
+  switch (request.get_type())
+  {
+    case RequestType::FILLRECT:
+      return static_cast<const FillRectRequest&>(request).radius == 0.0f;
+
+    case RequestType::LINE:
+    case RequestType::SOLID_BATCH:
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+const Color& get_solid_color(const DrawingRequest& request)
+{
+  switch (request.get_type())
+  {
+    case RequestType::FILLRECT:
+      return static_cast<const FillRectRequest&>(request).color;
+
+    case RequestType::LINE:
+      return static_cast<const LineRequest&>(request).color;
+
+    default:
+      return static_cast<const SolidBatchRequest&>(request).color;
+  }
+}
+
+void add_to_batch(SolidBatchRequest& batch, const DrawingRequest& request)
+{
+  switch (request.get_type())
+  {
+    case RequestType::FILLRECT:
+      batch.rects.push_back(static_cast<const FillRectRequest&>(request).rect);
+      break;
+
+    case RequestType::LINE:
+    {
+      const auto& line = static_cast<const LineRequest&>(request);
+      batch.lines.push_back(line.pos);
+      batch.lines.push_back(line.dest_pos);
+      break;
+    }
+
+    default:
+    {
+      const auto& other = static_cast<const SolidBatchRequest&>(request);
+      batch.rects.insert(batch.rects.end(), other.rects.begin(), other.rects.end());
+      batch.lines.insert(batch.lines.end(), other.lines.begin(), other.lines.end());
+      break;
+    }
+  }
+}
+
+/** Additive blending is commutative, so these requests may be drawn in
+    any order relative to each other. */
+bool is_additive(const DrawingRequest& request)
+{
+  return request.get_type() == RequestType::TEXTURE && request.blend == Blend::ADD;
+}
+
+Color with_alpha(const Color& color, float alpha)
+{
+  return Color(color.red, color.green, color.blue, color.alpha * alpha);
+}
+
+// How many of the preceding additive requests are looked at for one
+// with the same texture.
+const size_t MAX_ADDITIVE_MERGE_DISTANCE = 32;
+
+void add_to_signature(std::vector<uint32_t>& signature, float value)
+{
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  signature.push_back(bits);
+}
+
+void add_to_signature(std::vector<uint32_t>& signature, const void* pointer)
+{
+  const uint64_t value = reinterpret_cast<uintptr_t>(pointer);
+  signature.push_back(static_cast<uint32_t>(value));
+  signature.push_back(static_cast<uint32_t>(value >> 32));
+}
+
+void add_to_signature(std::vector<uint32_t>& signature, const Color& color)
+{
+  add_to_signature(signature, color.red);
+  add_to_signature(signature, color.green);
+  add_to_signature(signature, color.blue);
+  add_to_signature(signature, color.alpha);
+}
+
+void add_to_signature(std::vector<uint32_t>& signature, const Rectf& rect)
+{
+  add_to_signature(signature, rect.get_left());
+  add_to_signature(signature, rect.get_top());
+  add_to_signature(signature, rect.get_right());
+  add_to_signature(signature, rect.get_bottom());
+}
+
+} // namespace
+
+Canvas::DrawCallStats Canvas::s_draw_call_stats = { 0, 0 };
+
 Canvas::Canvas(DrawingContext& context, obstack& obst) :
   m_context(context),
   m_obst(obst),
-  m_requests()
+  m_requests(),
+  m_sort_keys(),
+  m_sort_scratch(),
+  m_sorted_requests(),
+  m_requests_sorted(false)
 {
   m_requests.reserve(500);
+  m_sort_keys.reserve(500);
 }
 
 Canvas::~Canvas()
@@ -47,21 +171,287 @@ Canvas::clear()
 {
   for (const auto& request : m_requests)
   {
-    request->~DrawingRequest();
+    // Requests moved to another canvas are destroyed there.
+    if (request)
+      request->~DrawingRequest();
   }
   m_requests.clear();
+  m_sort_keys.clear();
+  m_requests_sorted = false;
+}
+
+void
+Canvas::add_request(DrawingRequest* request)
+{
+  // Flipping the sign bit makes negative layers sort before positive ones.
+  const uint64_t layer = static_cast<uint32_t>(request->layer) ^ 0x80000000u;
+
+  m_sort_keys.push_back((layer << 32) | m_requests.size());
+  m_requests.push_back(request);
+}
+
+void
+Canvas::take_requests(Canvas& other, size_t begin, size_t end)
+{
+  assert(!m_requests_sorted && !other.m_requests_sorted);
+
+  for (size_t i = begin; i < end; ++i)
+  {
+    add_request(other.m_requests[i]);
+    other.m_requests[i] = nullptr;
+  }
+}
+
+void
+Canvas::sort_requests()
+{
+  // The keys are unique, so sorting them gives the same order as a
+  // stable sort by layer, without touching the requests themselves.
+  radix_sort(m_sort_keys, m_sort_scratch);
+
+  m_sorted_requests.clear();
+  m_sorted_requests.reserve(m_requests.size());
+  for (const uint64_t key : m_sort_keys)
+    m_sorted_requests.push_back(m_requests[key & 0xffffffff]);
+
+  m_requests.swap(m_sorted_requests);
+}
+
+bool
+Canvas::try_merge(DrawingRequest*& target, DrawingRequest& request)
+{
+  if (get_lightmap_side(target->layer) != get_lightmap_side(request.layer) ||
+      target->blend != request.blend ||
+      !(target->viewport == request.viewport))
+    return false;
+
+  if (target->get_type() == RequestType::TEXTURE &&
+      request.get_type() == RequestType::TEXTURE)
+  {
+    auto& first = static_cast<TextureRequest&>(*target);
+    const auto& second = static_cast<const TextureRequest&>(request);
+
+    if (!first.colors.empty() || !second.colors.empty() ||
+        first.texture != second.texture ||
+        first.displacement_texture != second.displacement_texture ||
+        first.flip != second.flip ||
+        first.alpha != second.alpha ||
+        !(first.color == second.color))
+      return false;
+
+    first.srcrects.insert(first.srcrects.end(), second.srcrects.begin(), second.srcrects.end());
+    first.dstrects.insert(first.dstrects.end(), second.dstrects.begin(), second.dstrects.end());
+    first.angles.insert(first.angles.end(), second.angles.begin(), second.angles.end());
+    return true;
+  }
+
+  if (target->get_type() == RequestType::GETPIXEL &&
+      request.get_type() == RequestType::GETPIXEL)
+  {
+    auto& first = static_cast<GetPixelRequest&>(*target);
+    const auto& second = static_cast<const GetPixelRequest&>(request);
+
+    first.positions.insert(first.positions.end(), second.positions.begin(), second.positions.end());
+    first.color_ptrs.insert(first.color_ptrs.end(), second.color_ptrs.begin(), second.color_ptrs.end());
+    return true;
+  }
+
+  if (is_solid(*target) && is_solid(request) &&
+      get_solid_color(*target) == get_solid_color(request))
+  {
+    if (target->get_type() != RequestType::SOLID_BATCH)
+    {
+      auto batch = new(m_obst) SolidBatchRequest(*target);
+      batch->color = get_solid_color(*target);
+      add_to_batch(*batch, *target);
+
+      target->~DrawingRequest();
+      target = batch;
+    }
+
+    add_to_batch(static_cast<SolidBatchRequest&>(*target), request);
+    return true;
+  }
+
+  return false;
+}
+
+bool
+Canvas::try_merge_additive(DrawingRequest& target, DrawingRequest& request)
+{
+  if (!is_additive(target) ||
+      get_lightmap_side(target.layer) != get_lightmap_side(request.layer) ||
+      !(target.viewport == request.viewport))
+    return false;
+
+  auto& first = static_cast<TextureRequest&>(target);
+  const auto& second = static_cast<const TextureRequest&>(request);
+
+  if (first.texture != second.texture ||
+      first.displacement_texture != second.displacement_texture ||
+      first.flip != second.flip)
+    return false;
+
+  const bool same_color = first.colors.empty() && second.colors.empty() &&
+                          first.alpha == second.alpha && first.color == second.color;
+  if (!same_color)
+  {
+    // The alpha of the request applies to all of its quads, so it is
+    // moved into the per-quad colors.
+    if (first.colors.empty())
+      first.colors.assign(first.srcrects.size(), with_alpha(first.color, first.alpha));
+    else if (first.alpha != 1.0f)
+      for (auto& color : first.colors)
+        color = with_alpha(color, first.alpha);
+    first.alpha = 1.0f;
+
+    if (second.colors.empty())
+      first.colors.insert(first.colors.end(), second.srcrects.size(), with_alpha(second.color, second.alpha));
+    else
+      for (const auto& color : second.colors)
+        first.colors.push_back(with_alpha(color, second.alpha));
+  }
+
+  first.srcrects.insert(first.srcrects.end(), second.srcrects.begin(), second.srcrects.end());
+  first.dstrects.insert(first.dstrects.end(), second.dstrects.begin(), second.dstrects.end());
+  first.angles.insert(first.angles.end(), second.angles.begin(), second.angles.end());
+  return true;
+}
+
+void
+Canvas::merge_requests()
+{
+  if (m_requests.empty())
+    return;
+
+  // Only neighbours in the sorted list get merged, so the drawing order
+  // stays the same. Additive requests are the exception, they may join
+  // any request of the run of additive requests they are part of.
+  size_t count = 1;
+  size_t additive_begin = is_additive(*m_requests[0]) ? 0 : 1;
+  for (size_t i = 1; i < m_requests.size(); ++i)
+  {
+    DrawingRequest* request = m_requests[i];
+
+    bool merged = false;
+    if (is_additive(*request))
+    {
+      const size_t search_end = count - std::min(count - additive_begin, MAX_ADDITIVE_MERGE_DISTANCE);
+      for (size_t j = count; j > search_end && !merged; --j)
+        merged = try_merge_additive(*m_requests[j - 1], *request);
+    }
+    else
+    {
+      merged = try_merge(m_requests[count - 1], *request);
+    }
+
+    if (merged)
+    {
+      request->~DrawingRequest();
+    }
+    else
+    {
+      m_requests[count++] = request;
+      if (!is_additive(*request))
+        additive_begin = count;
+    }
+  }
+
+  s_draw_call_stats.before_merge += static_cast<int>(m_requests.size());
+  s_draw_call_stats.after_merge += static_cast<int>(count);
+
+  m_requests.resize(count);
+}
+
+void
+Canvas::prepare()
+{
+  // The same canvas may be rendered more than once per frame. Merging
+  // replaces requests, so the sort keys are only valid the first time.
+  if (!m_requests_sorted)
+  {
+    sort_requests();
+    merge_requests();
+    m_requests_sorted = true;
+  }
+}
+
+bool
+Canvas::get_signature(std::vector<uint32_t>& signature) const
+{
+  assert(m_requests_sorted);
+
+  for (const auto& i : m_requests)
+  {
+    const DrawingRequest& request = *i;
+
+    signature.push_back(static_cast<uint32_t>(request.get_type()));
+    signature.push_back(static_cast<uint32_t>(request.layer));
+    signature.push_back(static_cast<uint32_t>(request.flip));
+    signature.push_back(static_cast<uint32_t>(request.blend));
+    add_to_signature(signature, request.alpha);
+    signature.push_back(static_cast<uint32_t>(request.viewport.left));
+    signature.push_back(static_cast<uint32_t>(request.viewport.top));
+    signature.push_back(static_cast<uint32_t>(request.viewport.right));
+    signature.push_back(static_cast<uint32_t>(request.viewport.bottom));
+
+    switch (request.get_type())
+    {
+      case RequestType::TEXTURE:
+      {
+        const auto& texture_request = static_cast<const TextureRequest&>(request);
+        add_to_signature(signature, texture_request.texture);
+        add_to_signature(signature, texture_request.displacement_texture);
+        add_to_signature(signature, texture_request.color);
+        signature.push_back(static_cast<uint32_t>(texture_request.srcrects.size()));
+        signature.push_back(static_cast<uint32_t>(texture_request.colors.size()));
+        for (size_t j = 0; j < texture_request.srcrects.size(); ++j)
+        {
+          add_to_signature(signature, texture_request.srcrects[j]);
+          add_to_signature(signature, texture_request.dstrects[j]);
+          add_to_signature(signature, texture_request.angles[j]);
+        }
+        for (const auto& color : texture_request.colors)
+          add_to_signature(signature, color);
+        break;
+      }
+
+      case RequestType::FILLRECT:
+      {
+        const auto& fillrect = static_cast<const FillRectRequest&>(request);
+        add_to_signature(signature, fillrect.rect);
+        add_to_signature(signature, fillrect.color);
+        add_to_signature(signature, fillrect.radius);
+        break;
+      }
+
+      case RequestType::SOLID_BATCH:
+      {
+        const auto& batch = static_cast<const SolidBatchRequest&>(request);
+        add_to_signature(signature, batch.color);
+        signature.push_back(static_cast<uint32_t>(batch.rects.size()));
+        for (const auto& rect : batch.rects)
+          add_to_signature(signature, rect);
+        for (const auto& point : batch.lines)
+        {
+          add_to_signature(signature, point.x);
+          add_to_signature(signature, point.y);
+        }
+        break;
+      }
+
+      default:
+        return false;
+    }
+  }
+
+  return true;
 }
 
 void
 Canvas::render(Renderer& renderer, Filter filter)
 {
-  // On a regular level, each frame has around 50-250 requests (before
-  // batching it was 1000-3000), the sort comparator function is
-  // called approximatly 3-7 times for each request.
-  std::stable_sort(m_requests.begin(), m_requests.end(),
-                   [](const DrawingRequest* r1, const DrawingRequest* r2){
-                     return r1->layer < r2->layer;
-                   });
+  prepare();
 
   Painter& painter = renderer.get_painter();
 
@@ -82,6 +472,10 @@ Canvas::render(Renderer& renderer, Filter filter)
         painter.draw_texture(static_cast<const TextureRequest&>(request));
         break;
 
+      case RequestType::TEXTURE_MESH:
+        painter.draw_texture_mesh(static_cast<const TextureMeshRequest&>(request));
+        break;
+
       case RequestType::GRADIENT:
         painter.draw_gradient(static_cast<const GradientRequest&>(request));
         break;
@@ -102,6 +496,10 @@ Canvas::render(Renderer& renderer, Filter filter)
         painter.draw_triangle(static_cast<const TriangleRequest&>(request));
         break;
 
+      case RequestType::SOLID_BATCH:
+        painter.draw_solid_batch(static_cast<const SolidBatchRequest&>(request));
+        break;
+
       case RequestType::GETPIXEL:
         painter.get_pixel(static_cast<const GetPixelRequest&>(request));
         break;
@@ -142,7 +540,7 @@ Canvas::draw_surface(const SurfacePtr& surface,
   request->displacement_texture = surface->get_displacement_texture().get();
   request->color = color;
 
-  m_requests.push_back(request);
+  add_request(request);
 }
 
 void
@@ -155,8 +553,7 @@ void
 Canvas::draw_surface_scaled(const SurfacePtr& surface, const Rectf& dstrect,
                             int layer, const PaintStyle& style)
 {
-  draw_surface_part(surface, Rectf(0.0f, 0.0f, static_cast<float>(surface->get_width()), static_cast<float>(surface->get_height())),
-                    dstrect, layer, style);
+  draw_surface_part(surface, Rectf(surface->get_region()), dstrect, layer, style);
 }
 
 void
@@ -179,7 +576,7 @@ Canvas::draw_surface_part(const SurfacePtr& surface, const Rectf& srcrect, const
   request->displacement_texture = surface->get_displacement_texture().get();
   request->color = style.get_color();
 
-  m_requests.push_back(request);
+  add_request(request);
 }
 
 void
@@ -225,7 +622,25 @@ Canvas::draw_surface_batch(const SurfacePtr& surface,
   request->texture = surface->get_texture().get();
   request->displacement_texture = surface->get_displacement_texture().get();
 
-  m_requests.push_back(request);
+  add_request(request);
+}
+
+void
+Canvas::draw_texture_mesh(const std::shared_ptr<const TextureMesh>& mesh, const Vector& position,
+                          const Color& color, int layer)
+{
+  if (!mesh) return;
+
+  auto request = new(m_obst) TextureMeshRequest(m_context.transform());
+
+  request->layer = layer;
+  request->flip = m_context.transform().flip ^ mesh->get_flip();
+  request->mesh = mesh;
+  request->origin = apply_translate(position);
+  request->scale = scale();
+  request->color = color;
+
+  add_request(request);
 }
 
 Rectf
@@ -260,7 +675,7 @@ Canvas::draw_gradient(const Color& top, const Color& bottom, int layer,
   request->region = Rectf(apply_translate(region.p1())*scale(),
                           apply_translate(region.p2())*scale());
 
-  m_requests.push_back(request);
+  add_request(request);
 }
 
 void
@@ -283,7 +698,7 @@ Canvas::draw_filled_rect(const Rectf& rect, const Color& color, float radius, in
   request->color.alpha = color.alpha * m_context.transform().alpha;
   request->radius = radius;
 
-  m_requests.push_back(request);
+  add_request(request);
 }
 
 void
@@ -298,7 +713,7 @@ Canvas::draw_inverse_ellipse(const Vector& pos, const Vector& size, const Color&
   request->color.alpha  = color.alpha * m_context.transform().alpha;
   request->size         = size*scale();
 
-  m_requests.push_back(request);
+  add_request(request);
 }
 
 void
@@ -313,7 +728,7 @@ Canvas::draw_line(const Vector& pos1, const Vector& pos2, const Color& color, in
   request->color.alpha  = color.alpha * m_context.transform().alpha;
   request->dest_pos     = apply_translate(pos2)*scale();
 
-  m_requests.push_back(request);
+  add_request(request);
 }
 
 void
@@ -329,7 +744,7 @@ Canvas::draw_triangle(const Vector& pos1, const Vector& pos2, const Vector& pos3
   request->color = color;
   request->color.alpha = color.alpha * m_context.transform().alpha;
 
-  m_requests.push_back(request);
+  add_request(request);
 }
 
 void
@@ -372,10 +787,10 @@ Canvas::get_pixel(const Vector& position, const std::shared_ptr<Color>& color_ou
   auto request = new(m_obst) GetPixelRequest(m_context.transform());
 
   request->layer = LAYER_GETPIXEL;
-  request->pos = pos;
-  request->color_ptr = color_out;
+  request->positions.push_back(pos);
+  request->color_ptrs.push_back(color_out);
 
-  m_requests.push_back(request);
+  add_request(request);
 }
 
 Vector
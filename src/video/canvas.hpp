@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <stdint.h>
 #include <string>
 #include <vector>
 #include <memory>
@@ -36,6 +37,7 @@
 
 class DrawingContext;
 class Renderer;
+class TextureMesh;
 class VideoSystem;
 struct DrawingRequest;
 
@@ -44,6 +46,16 @@ class Canvas final
 public:
   enum Filter { BELOW_LIGHTMAP, ABOVE_LIGHTMAP, ALL };
 
+  /** Number of requests of all canvases before and after render()
+      merged them, reset by Compositor::render() at the start of each
+      frame and shown in the FPS overlay. */
+  struct DrawCallStats
+  {
+    int before_merge;
+    int after_merge;
+  };
+  static DrawCallStats s_draw_call_stats;
+
 public:
   Canvas(DrawingContext& context, obstack& obst);
   ~Canvas();
@@ -66,6 +78,10 @@ public:
                           std::vector<float> angles,
                           const Color& color,
                           int layer);
+  /** Draws a mesh of static geometry, renderers may keep it in GPU
+      memory instead of uploading it every frame. */
+  void draw_texture_mesh(const std::shared_ptr<const TextureMesh>& mesh, const Vector& position,
+                         const Color& color, int layer);
   Rectf draw_text(const FontPtr& font, const std::string& text,
                   const Vector& position, FontAlignment alignment, int layer, const Color& color = Color(1.0,1.0,1.0));
   /** Draw text to the center of the screen */
@@ -95,19 +111,57 @@ public:
   void get_pixel(const Vector& position, const std::shared_ptr<Color>& color_out);
 
   void clear();
+
+  /** Sorts and merges the requests, render() does this itself when it
+      hasn't been done since the last clear(). */
+  void prepare();
   void render(Renderer& renderer, Filter filter);
 
+  /** Appends a description of everything the prepared requests draw to
+      @c signature, equal signatures give equal pixels. Returns false if
+      a request can't be described, e.g. because it reads pixels back. */
+  bool get_signature(std::vector<uint32_t>& signature) const;
+
+  /** Moves the requests [begin, end) of @c other to the end of this
+      canvas, as if they had been drawn here. The requests stay in the
+      memory of the other canvas' obstack. */
+  void take_requests(Canvas& other, size_t begin, size_t end);
+  inline size_t get_request_count() const { return m_requests.size(); }
+
   inline DrawingContext& get_context() { return m_context; }
 
 private:
   Vector apply_translate(const Vector& pos) const;
   float scale() const;
 
+  /** Queues the request and builds its sort key */
+  void add_request(DrawingRequest* request);
+
+  /** Orders the requests by layer, keeping the submission order within
+      each layer. */
+  void sort_requests();
+
+  /** Combines adjacent requests of the sorted request list that can be
+      drawn with a single painter call. Additive texture requests are
+      order independent, so within a run of them every request with the
+      same texture is combined, regardless of color and layer. */
+  void merge_requests();
+  bool try_merge(DrawingRequest*& target, DrawingRequest& request);
+  bool try_merge_additive(DrawingRequest& target, DrawingRequest& request);
+
 private:
   DrawingContext& m_context;
   obstack& m_obst;
   std::vector<DrawingRequest*> m_requests;
 
+  /** One key per request, the biased layer in the upper 32 bits and the
+      index into m_requests in the lower ones. */
+  std::vector<uint64_t> m_sort_keys;
+  std::vector<uint64_t> m_sort_scratch;
+  std::vector<DrawingRequest*> m_sorted_requests;
+
+  bool m_requests_sorted;
+
 private:
   Canvas(const Canvas&) = delete;
   Canvas& operator=(const Canvas&) = delete;
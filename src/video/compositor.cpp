@@ -17,14 +17,30 @@
 
 #include "video/compositor.hpp"
 
+#include <chrono>
+#include <cstring>
+
 #include "math/rect.hpp"
+#include "video/canvas.hpp"
 #include "video/drawing_context.hpp"
 #include "video/drawing_request.hpp"
 #include "video/painter.hpp"
 #include "video/renderer.hpp"
+#include "video/texture_manager.hpp"
+#include "video/ttf_surface_manager.hpp"
 #include "video/video_system.hpp"
 
+namespace {
+
+/** Describes what the lightmap texture holds, empty when unknown. A
+    Compositor only lives for one frame, the lightmap much longer. */
+std::vector<uint32_t> s_lightmap_signature;
+std::vector<uint32_t> s_next_lightmap_signature;
+
+} // namespace
+
 bool Compositor::s_render_lighting = true;
+Compositor::LightmapStats Compositor::s_lightmap_stats = { 0.0f, 0, false };
 
 Compositor::Compositor(VideoSystem& video_system, float time_offset) :
   m_video_system(video_system),
@@ -51,6 +67,13 @@ Compositor::make_context(bool overlay)
 void
 Compositor::render()
 {
+  // Images loaded since the last frame may still be missing on the GPU.
+  TextureManager::current()->flush_atlas();
+  if (TTFSurfaceManager::current())
+    TTFSurfaceManager::current()->flush();
+
+  Canvas::s_draw_call_stats = { 0, 0 };
+
   auto& lightmap = m_video_system.get_lightmap();
 
   bool use_lightmap = std::any_of(m_drawing_contexts.begin(), m_drawing_contexts.end(),
@@ -60,23 +83,12 @@ Compositor::render()
 
   use_lightmap = use_lightmap && s_render_lighting;
 
-  // Prepare lightmap.
-  if (use_lightmap)
-  {
-    lightmap.start_draw();
-    Painter& painter = lightmap.get_painter();
+  s_lightmap_stats = { 0.0f, 0, false };
 
-    for (auto& ctx : m_drawing_contexts)
-    {
-      if (!ctx->is_overlay())
-      {
-        painter.clear(ctx->get_ambient_color());
-
-        ctx->light().render(lightmap, Canvas::ALL);
-      }
-    }
-    lightmap.end_draw();
-  }
+  if (use_lightmap)
+    render_lightmap();
+  else
+    s_lightmap_signature.clear();
 
   auto back_renderer = m_video_system.get_back_renderer();
   if (back_renderer)
@@ -144,3 +156,70 @@ Compositor::render()
   obstack_free(&m_obst, nullptr);
   obstack_init(&m_obst);
 }
+
+void
+Compositor::render_lightmap()
+{
+  const auto start_time = std::chrono::steady_clock::now();
+
+  auto& lightmap = m_video_system.get_lightmap();
+
+  // The texture is part of the signature, as a new lightmap texture
+  // starts out empty.
+  s_next_lightmap_signature.clear();
+  const TexturePtr texture = lightmap.get_texture();
+  const uint64_t texture_id = reinterpret_cast<uintptr_t>(texture.get());
+  s_next_lightmap_signature.push_back(static_cast<uint32_t>(texture_id));
+  s_next_lightmap_signature.push_back(static_cast<uint32_t>(texture_id >> 32));
+
+  bool reusable = true;
+  for (auto& ctx : m_drawing_contexts)
+  {
+    if (ctx->is_overlay())
+      continue;
+
+    const Color& ambient_color = ctx->get_ambient_color();
+    for (const float value : { ambient_color.red, ambient_color.green,
+                               ambient_color.blue, ambient_color.alpha })
+    {
+      uint32_t bits;
+      std::memcpy(&bits, &value, sizeof(bits));
+      s_next_lightmap_signature.push_back(bits);
+    }
+
+    Canvas& canvas = ctx->light();
+    canvas.prepare();
+    reusable = canvas.get_signature(s_next_lightmap_signature) && reusable;
+    s_lightmap_stats.draw_calls += static_cast<int>(canvas.get_request_count());
+  }
+
+  if (reusable && s_next_lightmap_signature == s_lightmap_signature)
+  {
+    s_lightmap_stats.reused = true;
+    s_lightmap_stats.draw_calls = 0;
+  }
+  else
+  {
+    lightmap.start_draw();
+    Painter& painter = lightmap.get_painter();
+
+    for (auto& ctx : m_drawing_contexts)
+    {
+      if (!ctx->is_overlay())
+      {
+        painter.clear(ctx->get_ambient_color());
+
+        ctx->light().render(lightmap, Canvas::ALL);
+      }
+    }
+    lightmap.end_draw();
+
+    if (reusable)
+      s_lightmap_signature.swap(s_next_lightmap_signature);
+    else
+      s_lightmap_signature.clear();
+  }
+
+  s_lightmap_stats.milliseconds = std::chrono::duration<float, std::milli>(
+    std::chrono::steady_clock::now() - start_time).count();
+}
@@ -31,6 +31,18 @@ public:
   /** Debug flag to disable lighting, used in the editor */
   static bool s_render_lighting;
 
+  /** Cost of the lightmap in the last frame, shown in the FPS overlay */
+  struct LightmapStats
+  {
+    /** Time spent preparing and submitting the light requests */
+    float milliseconds;
+    int draw_calls;
+
+    /** The lights didn't change, so last frame's lightmap was kept */
+    bool reused;
+  };
+  static LightmapStats s_lightmap_stats;
+
 public:
   Compositor(VideoSystem& video_system, float time_offset);
   ~Compositor();
@@ -43,6 +55,11 @@ public:
       otherwise their lighting would get messed up. */
   DrawingContext& make_context(bool overlay = false);
 
+private:
+  /** Draws the light canvases into the lightmap, unless they draw the
+      same as in the frame the lightmap currently holds. */
+  void render_lightmap();
+
 private:
   VideoSystem& m_video_system;
 
@@ -34,10 +34,17 @@ DrawingContext::DrawingContext(VideoSystem& video_system_, obstack& obst, bool o
   m_transform_stack({ DrawingTransform(m_video_system.get_viewport()) }),
   m_colormap_canvas(*this, m_obst),
   m_lightmap_canvas(*this, m_obst),
-  m_time_offset(time_offset)
+  m_time_offset(time_offset),
+  m_recordings()
 {
 }
 
+DrawingContext::Recording::~Recording()
+{
+  context.reset();
+  obstack_free(&obst, nullptr);
+}
+
 DrawingContext::~DrawingContext()
 {
   clear();
@@ -48,6 +55,35 @@ DrawingContext::clear()
 {
   m_lightmap_canvas.clear();
   m_colormap_canvas.clear();
+
+  // Requests taken from the recordings were destroyed above, so their
+  // memory can go now.
+  for (auto& recording : m_recordings)
+  {
+    recording->context->clear();
+    obstack_free(&recording->obst, nullptr);
+    obstack_init(&recording->obst);
+  }
+}
+
+void
+DrawingContext::begin_recording(size_t count)
+{
+  while (m_recordings.size() < count)
+  {
+    auto recording = std::make_unique<Recording>();
+    obstack_init(&recording->obst);
+    recording->context = std::make_unique<DrawingContext>(m_video_system, recording->obst, m_overlay, m_time_offset);
+    m_recordings.push_back(std::move(recording));
+  }
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    DrawingContext& context = *m_recordings[i]->context;
+    context.m_transform_stack = { transform() };
+    context.m_ambient_color = m_ambient_color;
+    context.m_time_offset = m_time_offset;
+  }
 }
 
 Rectf
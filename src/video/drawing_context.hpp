@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <obstack.h>
@@ -97,6 +98,14 @@ public:
 
   void clear();
 
+  /** Prepares @c count recording contexts, each with its own obstack,
+      that start out with the current transform, ambient color and time
+      offset. Requests can be drawn into them from other threads and
+      moved over with Canvas::take_requests() afterwards. They are
+      cleared together with this context. */
+  void begin_recording(size_t count);
+  inline DrawingContext& get_recording_context(size_t index) { return *m_recordings[index]->context; }
+
   inline void set_viewport(const Rect& viewport) { transform().viewport = viewport; }
   inline const Rect& get_viewport() const { return transform().viewport; }
 
@@ -109,6 +118,20 @@ public:
 
   inline bool is_overlay() const { return m_overlay; }
 
+private:
+  struct Recording
+  {
+    Recording() : obst(), context() {}
+    ~Recording();
+
+    obstack obst;
+    std::unique_ptr<DrawingContext> context;
+
+  private:
+    Recording(const Recording&) = delete;
+    Recording& operator=(const Recording&) = delete;
+  };
+
 private:
   VideoSystem& m_video_system;
 
@@ -128,6 +151,9 @@ private:
 
   float m_time_offset;
 
+  /** Kept between frames, so their obstacks can reuse their memory */
+  std::vector<std::unique_ptr<Recording>> m_recordings;
+
 private:
   DrawingContext(const DrawingContext&) = delete;
   DrawingContext& operator=(const DrawingContext&) = delete;
@@ -29,10 +29,11 @@
 #include "video/gradient.hpp"
 
 class Surface;
+class TextureMesh;
 
 enum class RequestType
 {
-  TEXTURE, GRADIENT, FILLRECT, INVERSEELLIPSE, GETPIXEL, LINE, TRIANGLE
+  TEXTURE, TEXTURE_MESH, GRADIENT, FILLRECT, INVERSEELLIPSE, GETPIXEL, LINE, TRIANGLE, SOLID_BATCH
 };
 
 struct DrawingRequest
@@ -65,7 +66,8 @@ struct TextureRequest : public DrawingRequest
     srcrects(),
     dstrects(),
     angles(),
-    color(1.0f, 1.0f, 1.0f)
+    color(1.0f, 1.0f, 1.0f),
+    colors()
   {}
 
   RequestType get_type() const override { return RequestType::TEXTURE; }
@@ -77,11 +79,40 @@ struct TextureRequest : public DrawingRequest
   std::vector<float> angles;
   Color color;
 
+  /** One color per quad, replaces color when not empty. Filled when
+      requests of differently colored lights get combined. */
+  std::vector<Color> colors;
+
 private:
   TextureRequest(const TextureRequest&) = delete;
   TextureRequest& operator=(const TextureRequest&) = delete;
 };
 
+struct TextureMeshRequest : public DrawingRequest
+{
+  TextureMeshRequest(const DrawingTransform& transform) :
+    DrawingRequest(transform),
+    mesh(),
+    origin(0.0f, 0.0f),
+    scale(1.0f),
+    color(1.0f, 1.0f, 1.0f)
+  {}
+
+  RequestType get_type() const override { return RequestType::TEXTURE_MESH; }
+
+  std::shared_ptr<const TextureMesh> mesh;
+
+  /** The destination rectangles of the mesh are moved by origin and
+      then multiplied by scale. */
+  Vector origin;
+  float scale;
+  Color color;
+
+private:
+  TextureMeshRequest(const TextureMeshRequest&) = delete;
+  TextureMeshRequest& operator=(const TextureMeshRequest&) = delete;
+};
+
 struct GradientRequest : public DrawingRequest
 {
   GradientRequest(const DrawingTransform& transform)  :
@@ -152,6 +183,31 @@ struct LineRequest : public DrawingRequest
   Color color;
 };
 
+/** Filled rectangles and lines of a single color, merged from adjacent
+    FillRectRequests and LineRequests by Canvas::render() */
+struct SolidBatchRequest : public DrawingRequest
+{
+  /** Takes layer, blend and viewport from the first merged request */
+  SolidBatchRequest(const DrawingRequest& first) :
+    DrawingRequest(first),
+    rects(),
+    lines(),
+    color()
+  {}
+
+  RequestType get_type() const override { return RequestType::SOLID_BATCH; }
+
+  std::vector<Rectf> rects;
+
+  /** Start and end point of every line */
+  std::vector<Vector> lines;
+  Color color;
+
+private:
+  SolidBatchRequest(const SolidBatchRequest&) = delete;
+  SolidBatchRequest& operator=(const SolidBatchRequest&) = delete;
+};
+
 struct TriangleRequest : public DrawingRequest
 {
   TriangleRequest(const DrawingTransform& transform) :
@@ -172,14 +228,16 @@ struct GetPixelRequest : public DrawingRequest
 {
   GetPixelRequest(const DrawingTransform& transform) :
     DrawingRequest(transform),
-    pos(0.0f, 0.0f),
-    color_ptr()
+    positions(),
+    color_ptrs()
   {}
 
   RequestType get_type() const override { return RequestType::GETPIXEL; }
 
-  Vector pos;
-  std::shared_ptr<Color> color_ptr;
+  /** All queries of a frame are merged into one request, so painters
+      can read them back together. */
+  std::vector<Vector> positions;
+  std::vector<std::shared_ptr<Color>> color_ptrs;
 
 private:
   GetPixelRequest(const GetPixelRequest&) = delete;
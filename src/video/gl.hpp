@@ -39,6 +39,10 @@
 inline void glGenVertexArrays(GLsizei n, GLuint *arrays) {}
 inline void glDeleteVertexArrays(GLsizei n, GLuint *arrays) {}
 inline void glBindVertexArray(GLuint vao) {}
+// Instancing is never used without OpenGL 3.3, see
+// GL33CoreContext::supports_instancing()
+inline void glVertexAttribDivisor(GLuint index, GLuint divisor) {}
+inline void glDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instancecount) {}
 #endif
 
 #else
@@ -16,14 +16,18 @@
 
 #include "video/gl/gl20_context.hpp"
 
+#include <stddef.h>
+
 #include "supertux/globals.hpp"
 #include "video/glutil.hpp"
 #include "video/color.hpp"
 #include "video/gl/gl_texture.hpp"
+#include "video/gl/gl_vertex_stream.hpp"
 
 #ifndef USE_OPENGLES2
 
-GL20Context::GL20Context()
+GL20Context::GL20Context() :
+  m_vertex_stream(new GLVertexStream(false))
 {
   assert_gl();
 }
@@ -71,6 +75,19 @@ GL20Context::ortho(float width, float height, bool vflip)
   assert_gl();
 }
 
+void
+GL20Context::set_transform(float x, float y, float scale)
+{
+  assert_gl();
+
+  glMatrixMode(GL_MODELVIEW);
+  glLoadIdentity();
+  glScalef(scale, scale, 1.0f);
+  glTranslatef(x, y, 0.0f);
+
+  assert_gl();
+}
+
 void
 GL20Context::blend_func(GLenum src, GLenum dst)
 {
@@ -188,4 +205,42 @@ GL20Context::draw_arrays(GLenum type, GLint first, GLsizei count)
   assert_gl();
 }
 
+GLVertex*
+GL20Context::map_vertices(size_t count)
+{
+  return static_cast<GLVertex*>(m_vertex_stream->map(count));
+}
+
+void
+GL20Context::draw_vertices(GLenum type)
+{
+  assert_gl();
+
+  const GLsizei count = static_cast<GLsizei>(m_vertex_stream->get_mapped_count());
+  const GLint first = m_vertex_stream->commit();
+  const GLsizei stride = sizeof(GLVertex);
+
+  glEnableClientState(GL_VERTEX_ARRAY);
+  glVertexPointer(2, GL_FLOAT, stride, reinterpret_cast<void*>(offsetof(GLVertex, x)));
+
+  glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+  glTexCoordPointer(2, GL_FLOAT, stride, reinterpret_cast<void*>(offsetof(GLVertex, u)));
+
+  glEnableClientState(GL_COLOR_ARRAY);
+  glColorPointer(4, GL_FLOAT, stride, reinterpret_cast<void*>(offsetof(GLVertex, r)));
+
+  glDrawArrays(type, first, count);
+
+  // All the other draws take their arrays from client memory.
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  assert_gl();
+}
+
+void
+GL20Context::next_frame()
+{
+  m_vertex_stream->next_frame();
+}
+
 #endif
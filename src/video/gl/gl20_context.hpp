@@ -18,8 +18,12 @@
 
 #include "video/gl/gl_context.hpp"
 
+#include <memory>
+
 #ifndef USE_OPENGLES2
 
+class GLVertexStream;
+
 class GL20Context final : public GLContext
 {
 public:
@@ -31,6 +35,7 @@ public:
   virtual void bind() override;
 
   virtual void ortho(float width, float height, bool vflip) override;
+  virtual void set_transform(float x, float y, float scale) override;
 
   virtual void blend_func(GLenum src, GLenum dst) override;
 
@@ -46,9 +51,19 @@ public:
   virtual void bind_no_texture() override;
 
   virtual void draw_arrays(GLenum type, GLint first, GLsizei count) override;
+  virtual GLVertex* map_vertices(size_t count) override;
+  virtual void draw_vertices(GLenum type) override;
+  virtual void next_frame() override;
+
+  virtual bool supports_buffers() const override { return false; }
 
   virtual bool supports_framebuffer() const override { return false; }
 
+  virtual bool supports_instancing() const override { return false; }
+
+private:
+  std::unique_ptr<GLVertexStream> m_vertex_stream;
+
 private:
   GL20Context(const GL20Context&) = delete;
   GL20Context& operator=(const GL20Context&) = delete;
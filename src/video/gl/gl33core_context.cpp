@@ -22,6 +22,7 @@
 #include "video/gl/gl_texture.hpp"
 #include "video/gl/gl_texture_renderer.hpp"
 #include "video/gl/gl_vertex_arrays.hpp"
+#include "video/gl/gl_vertex_stream.hpp"
 #include "video/gl/gl_video_system.hpp"
 #include "video/glutil.hpp"
 
@@ -29,15 +30,24 @@ GL33CoreContext::GL33CoreContext(GLVideoSystem& video_system) :
   m_video_system(video_system),
   m_program(),
   m_vertex_arrays(),
+  m_vertex_stream(),
+  m_instance_stream(),
   m_white_texture(),
   m_black_texture(),
   m_grey_texture(),
-  m_transparent_texture()
+  m_transparent_texture(),
+  m_projection_sx(1.0f),
+  m_projection_sy(1.0f),
+  m_projection_tx(0.0f),
+  m_projection_ty(0.0f)
 {
   assert_gl();
 
   m_program.reset(new GLProgram);
   m_vertex_arrays.reset(new GLVertexArrays(*this));
+  m_vertex_stream.reset(new GLVertexStream(GLVertexStream::supports_persistent_mapping()));
+  m_instance_stream.reset(new GLVertexStream(GLVertexStream::supports_persistent_mapping(),
+                                             sizeof(GLInstance)));
   m_white_texture.reset(new GLTexture(1, 1, Color::WHITE));
   m_black_texture.reset(new GLTexture(1, 1, Color::BLACK));
   m_grey_texture.reset(new GLTexture(1, 1, Color::from_rgba8888(128, 128, 0, 0)));
@@ -116,15 +126,28 @@ GL33CoreContext::ortho(float width, float height, bool vflip)
 {
   assert_gl();
 
-  const float sx = 2.0f / static_cast<float>(width);
-  const float sy = -2.0f / static_cast<float>(height) * (vflip ? 1.0f : -1.0f);
+  m_projection_sx = 2.0f / static_cast<float>(width);
+  m_projection_sy = -2.0f / static_cast<float>(height) * (vflip ? 1.0f : -1.0f);
 
-  const float tx = -1.0f;
-  const float ty = 1.0f * (vflip ? 1.0f : -1.0f);
+  m_projection_tx = -1.0f;
+  m_projection_ty = 1.0f * (vflip ? 1.0f : -1.0f);
+
+  set_transform(0.0f, 0.0f, 1.0f);
+
+  assert_gl();
+}
+
+void
+GL33CoreContext::set_transform(float x, float y, float scale)
+{
+  assert_gl();
+
+  const float sx = m_projection_sx * scale;
+  const float sy = m_projection_sy * scale;
 
   const float mvp_matrix[] = {
-    sx, 0, tx,
-    0, sy, ty,
+    sx, 0, sx * x + m_projection_tx,
+    0, sy, sy * y + m_projection_ty,
     0, 0, 1
   };
 
@@ -162,6 +185,18 @@ GL33CoreContext::set_texcoord(float u, float v)
   m_vertex_arrays->set_texcoord(u, v);
 }
 
+void
+GL33CoreContext::set_position_buffer(GLuint buffer)
+{
+  m_vertex_arrays->set_position_buffer(buffer);
+}
+
+void
+GL33CoreContext::set_texcoord_buffer(GLuint buffer)
+{
+  m_vertex_arrays->set_texcoord_buffer(buffer);
+}
+
 void
 GL33CoreContext::set_colors(const float* data, size_t size)
 {
@@ -243,3 +278,67 @@ GL33CoreContext::draw_arrays(GLenum type, GLint first, GLsizei count)
 
   assert_gl();
 }
+
+GLVertex*
+GL33CoreContext::map_vertices(size_t count)
+{
+  return static_cast<GLVertex*>(m_vertex_stream->map(count));
+}
+
+void
+GL33CoreContext::draw_vertices(GLenum type)
+{
+  assert_gl();
+
+  const GLsizei count = static_cast<GLsizei>(m_vertex_stream->get_mapped_count());
+  const GLint first = m_vertex_stream->commit();
+
+  m_vertex_arrays->set_vertex_stream(m_vertex_stream->get_buffer());
+  glDrawArrays(type, first, count);
+
+  assert_gl();
+}
+
+bool
+GL33CoreContext::supports_instancing() const
+{
+#if defined(USE_OPENGLES2)
+  // The GLSL 1.00 shader has no instance attributes.
+  return false;
+#else
+  return true;
+#endif
+}
+
+GLInstance*
+GL33CoreContext::map_instances(size_t count)
+{
+  return static_cast<GLInstance*>(m_instance_stream->map(count));
+}
+
+void
+GL33CoreContext::draw_instances()
+{
+  assert_gl();
+
+  const GLsizei count = static_cast<GLsizei>(m_instance_stream->get_mapped_count());
+  const GLint first = m_instance_stream->commit();
+
+  m_vertex_arrays->set_instance_stream(m_instance_stream->get_buffer(), first);
+
+  const GLint instanced_loc = m_program->get_instanced_location();
+  glUniform1i(instanced_loc, 1);
+  glDrawArraysInstanced(GL_TRIANGLES, 0, 6, count);
+  glUniform1i(instanced_loc, 0);
+
+  m_vertex_arrays->unset_instance_stream();
+
+  assert_gl();
+}
+
+void
+GL33CoreContext::next_frame()
+{
+  m_vertex_stream->next_frame();
+  m_instance_stream->next_frame();
+}
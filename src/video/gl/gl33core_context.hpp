@@ -23,7 +23,9 @@
 class GLProgram;
 class GLTexture;
 class GLVertexArrays;
+class GLVertexStream;
 class GLVideoSystem;
+struct GLInstance;
 
 class GL33CoreContext final : public GLContext
 {
@@ -36,6 +38,7 @@ public:
   virtual void bind() override;
 
   virtual void ortho(float width, float height, bool vflip) override;
+  virtual void set_transform(float x, float y, float scale) override;
 
   virtual void blend_func(GLenum src, GLenum dst) override;
 
@@ -50,9 +53,26 @@ public:
   virtual void bind_texture(const Texture& texture, const Texture* displacement_texture) override;
   virtual void bind_no_texture() override;
   virtual void draw_arrays(GLenum type, GLint first, GLsizei count) override;
+  virtual GLVertex* map_vertices(size_t count) override;
+  virtual void draw_vertices(GLenum type) override;
+  virtual void next_frame() override;
+
+  virtual bool supports_buffers() const override { return true; }
+
+  /** Take positions or texcoords from a buffer object created by the
+      caller instead of uploading them */
+  void set_position_buffer(GLuint buffer);
+  void set_texcoord_buffer(GLuint buffer);
 
   virtual bool supports_framebuffer() const override { return true; }
 
+  virtual bool supports_instancing() const override;
+
+  /** Returns room for @c count instances, draw_instances() draws them
+      as quads with the texture and the color that were set before. */
+  GLInstance* map_instances(size_t count);
+  void draw_instances();
+
   inline GLProgram& get_program() const { return *m_program; }
   inline GLVertexArrays& get_vertex_arrays() const { return *m_vertex_arrays; }
   inline GLTexture& get_white_texture() const { return *m_white_texture; }
@@ -61,11 +81,19 @@ private:
   GLVideoSystem& m_video_system;
   std::unique_ptr<GLProgram> m_program;
   std::unique_ptr<GLVertexArrays> m_vertex_arrays;
+  std::unique_ptr<GLVertexStream> m_vertex_stream;
+  std::unique_ptr<GLVertexStream> m_instance_stream;
   std::unique_ptr<GLTexture> m_white_texture;
   std::unique_ptr<GLTexture> m_black_texture;
   std::unique_ptr<GLTexture> m_grey_texture;
   std::unique_ptr<GLTexture> m_transparent_texture;
 
+  /** The projection set by ortho(), as mvp = (sx * x + tx, sy * y + ty) */
+  float m_projection_sx;
+  float m_projection_sy;
+  float m_projection_tx;
+  float m_projection_ty;
+
 private:
   GL33CoreContext(const GL33CoreContext&) = delete;
   GL33CoreContext& operator=(const GL33CoreContext&) = delete;
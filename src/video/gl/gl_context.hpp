@@ -24,6 +24,7 @@
 class Color;
 class GLTexture;
 class Texture;
+struct GLVertex;
 
 class GLContext
 {
@@ -37,6 +38,10 @@ public:
 
   virtual void ortho(float width, float height, bool vflip) = 0;
 
+  /** Moves all following positions by (x, y) and then scales them,
+      set_transform(0, 0, 1) goes back to plain ortho(). */
+  virtual void set_transform(float x, float y, float scale) = 0;
+
   virtual void blend_func(GLenum src, GLenum dst) = 0;
 
   virtual void set_positions(const float* data, size_t size) = 0;
@@ -52,8 +57,27 @@ public:
 
   virtual void draw_arrays(GLenum type, GLint first, GLsizei count) = 0;
 
+  /** Returns room for @c count vertices in the streaming vertex buffer,
+      draw_vertices() draws them once they are written. Vertices carry
+      their own texcoords and colors, set_texcoord() and set_color()
+      don't apply to them. */
+  virtual GLVertex* map_vertices(size_t count) = 0;
+  virtual void draw_vertices(GLenum type) = 0;
+
+  /** Called once at the end of every frame */
+  virtual void next_frame() = 0;
+
+  /** Whether geometry can be kept in buffer objects between frames,
+      only GL33CoreContext can draw from them. */
+  virtual bool supports_buffers() const = 0;
+
   virtual bool supports_framebuffer() const = 0;
 
+  /** Whether quads can be drawn from one GLInstance each, which the GPU
+      expands, instead of six vertices from map_vertices(). Only
+      GL33CoreContext can draw instances. */
+  virtual bool supports_instancing() const = 0;
+
 private:
   GLContext(const GLContext&) = delete;
   GLContext& operator=(const GLContext&) = delete;
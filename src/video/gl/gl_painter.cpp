@@ -22,14 +22,16 @@
 #include "math/util.hpp"
 #include "supertux/globals.hpp"
 #include "video/drawing_request.hpp"
+#include "video/gl/gl33core_context.hpp"
 #include "video/gl/gl_context.hpp"
-#include "video/gl/gl_pixel_request.hpp"
 #include "video/gl/gl_program.hpp"
 #include "video/gl/gl_renderer.hpp"
 #include "video/gl/gl_texture.hpp"
 #include "video/gl/gl_vertex_arrays.hpp"
+#include "video/gl/gl_vertex_stream.hpp"
 #include "video/gl/gl_video_system.hpp"
 #include "video/glutil.hpp"
+#include "video/texture_mesh.hpp"
 #include "video/video_system.hpp"
 #include "video/viewport.hpp"
 
@@ -57,16 +59,75 @@ inline GLenum dfactor(Blend blend)
   return std::get<1>(blend_factor(blend));
 }
 
+/** Appends the two triangles of a quad, like GLPainter::draw_texture() */
+void add_quad(std::vector<float>& vertices, std::vector<float>& uvs,
+              const Rectf& dstrect, const Rectf& srcrect, const Texture& texture, Flip flip)
+{
+  const float left = dstrect.get_left();
+  const float top = dstrect.get_top();
+  const float right = dstrect.get_right();
+  const float bottom = dstrect.get_bottom();
+
+  float uv_left = srcrect.get_left() / static_cast<float>(texture.get_texture_width());
+  float uv_top = srcrect.get_top() / static_cast<float>(texture.get_texture_height());
+  float uv_right = srcrect.get_right() / static_cast<float>(texture.get_texture_width());
+  float uv_bottom = srcrect.get_bottom() / static_cast<float>(texture.get_texture_height());
+
+  if (flip & HORIZONTAL_FLIP)
+    std::swap(uv_left, uv_right);
+
+  if (flip & VERTICAL_FLIP)
+    std::swap(uv_top, uv_bottom);
+
+  const float vertices_lst[] = {
+    left, top,
+    right, top,
+    right, bottom,
+
+    left, bottom,
+    left, top,
+    right, bottom,
+  };
+  vertices.insert(vertices.end(), std::begin(vertices_lst), std::end(vertices_lst));
+
+  const float uvs_lst[] = {
+    uv_left, uv_top,
+    uv_right, uv_top,
+    uv_right, uv_bottom,
+
+    uv_left, uv_bottom,
+    uv_left, uv_top,
+    uv_right, uv_bottom,
+  };
+  uvs.insert(uvs.end(), std::begin(uvs_lst), std::end(uvs_lst));
+}
+
+// Number of cached meshes after which buffers of deleted meshes get
+// looked for the first time.
+const size_t MIN_MESH_BUFFERS_COLLECT_SIZE = 64;
+
+// Requests with fewer quads than this stay in the vertex stream, it
+// isn't worth switching the vertex layout for them.
+const size_t MIN_INSTANCED_QUADS = 16;
+
 } // namespace
 
 GLPainter::GLPainter(GLVideoSystem& video_system, GLRenderer& renderer) :
   m_video_system(video_system),
   m_renderer(renderer),
-  m_vertices(),
-  m_uvs()
+  m_mesh_buffers(),
+  m_mesh_buffers_collect_size(MIN_MESH_BUFFERS_COLLECT_SIZE),
+  m_pixel_request(),
+  m_pixel_queries()
 {
 }
 
+GLPainter::~GLPainter()
+{
+  for (auto& it : m_mesh_buffers)
+    delete_mesh_buffer(it.second);
+}
+
 void
 GLPainter::draw_texture(const TextureRequest& request)
 {
@@ -77,11 +138,22 @@ GLPainter::draw_texture(const TextureRequest& request)
   assert(request.srcrects.size() == request.dstrects.size());
   assert(request.srcrects.size() == request.angles.size());
 
-  m_vertices.clear();
-  m_uvs.clear();
+  GLContext& context = m_video_system.get_context();
 
-  m_vertices.reserve(request.srcrects.size() * 12);
-  m_uvs.reserve(request.srcrects.size() * 12);
+  const Color color(request.color.red,
+                    request.color.green,
+                    request.color.blue,
+                    request.color.alpha * request.alpha);
+
+  // Instances share a single color.
+  if (context.supports_instancing() && request.colors.empty() &&
+      request.srcrects.size() >= MIN_INSTANCED_QUADS)
+  {
+    draw_texture_instanced(request, color);
+    return;
+  }
+
+  GLVertex* vertex = context.map_vertices(request.srcrects.size() * 6);
 
   for (size_t i = 0; i < request.srcrects.size(); ++i)
   {
@@ -101,29 +173,16 @@ GLPainter::draw_texture(const TextureRequest& request)
     if (request.flip & VERTICAL_FLIP)
       std::swap(uv_top, uv_bottom);
 
+    // Corners in the order top left, top right, bottom right, bottom left.
+    float x[4];
+    float y[4];
+
     if (request.angles[i] == 0.0f)
     {
-      auto vertices_lst = {
-        left, top,
-        right, top,
-        right, bottom,
-
-        left, bottom,
-        left, top,
-        right, bottom,
-      };
-      m_vertices.insert(m_vertices.end(), std::begin(vertices_lst), std::end(vertices_lst));
-
-      auto uvs_lst = {
-        uv_left, uv_top,
-        uv_right, uv_top,
-        uv_right, uv_bottom,
-
-        uv_left, uv_bottom,
-        uv_left, uv_top,
-        uv_right, uv_bottom,
-      };
-      m_uvs.insert(m_uvs.end(), std::begin(uvs_lst), std::end(uvs_lst));
+      x[0] = left;  y[0] = top;
+      x[1] = right; y[1] = top;
+      x[2] = right; y[2] = bottom;
+      x[3] = left;  y[3] = bottom;
     }
     else
     {
@@ -140,42 +199,198 @@ GLPainter::draw_texture(const TextureRequest& request)
       const float new_top = top - center_y;
       const float new_bottom = bottom - center_y;
 
-      const float vertices_lst[] = {
-        new_left*ca - new_top*sa + center_x, new_left*sa + new_top*ca + center_y,
-        new_right*ca - new_top*sa + center_x, new_right*sa + new_top*ca + center_y,
-        new_right*ca - new_bottom*sa + center_x, new_right*sa + new_bottom*ca + center_y,
-
-        new_left*ca - new_bottom*sa + center_x, new_left*sa + new_bottom*ca + center_y,
-        new_left*ca - new_top*sa + center_x, new_left*sa + new_top*ca + center_y,
-        new_right*ca - new_bottom*sa + center_x, new_right*sa + new_bottom*ca + center_y,
-      };
-      m_vertices.insert(m_vertices.end(), std::begin(vertices_lst), std::end(vertices_lst));
-
-      const float uvs_lst[] = {
-        uv_left, uv_top,
-        uv_right, uv_top,
-        uv_right, uv_bottom,
-
-        uv_left, uv_bottom,
-        uv_left, uv_top,
-        uv_right, uv_bottom,
-      };
-      m_uvs.insert(m_uvs.end(), std::begin(uvs_lst), std::end(uvs_lst));
+      x[0] = new_left*ca - new_top*sa + center_x;     y[0] = new_left*sa + new_top*ca + center_y;
+      x[1] = new_right*ca - new_top*sa + center_x;    y[1] = new_right*sa + new_top*ca + center_y;
+      x[2] = new_right*ca - new_bottom*sa + center_x; y[2] = new_right*sa + new_bottom*ca + center_y;
+      x[3] = new_left*ca - new_bottom*sa + center_x;  y[3] = new_left*sa + new_bottom*ca + center_y;
+    }
+
+    const float u[4] = { uv_left, uv_right, uv_right, uv_left };
+    const float v[4] = { uv_top, uv_top, uv_bottom, uv_bottom };
+
+    const Color& quad_color = request.colors.empty() ? color : request.colors[i];
+    const float alpha = request.colors.empty() ? color.alpha : quad_color.alpha * request.alpha;
+
+    for (const int corner : { 0, 1, 2, 3, 0, 2 })
+    {
+      *vertex++ = GLVertex{ x[corner], y[corner], u[corner], v[corner],
+                            quad_color.red, quad_color.green, quad_color.blue, alpha };
     }
   }
 
-  GLContext& context = m_video_system.get_context();
+  context.blend_func(sfactor(request.blend), dfactor(request.blend));
+  context.bind_texture(texture, request.displacement_texture);
+  context.draw_vertices(GL_TRIANGLES);
+
+  assert_gl();
+}
+
+void
+GLPainter::draw_texture_instanced(const TextureRequest& request, const Color& color)
+{
+  assert_gl();
+
+  const auto& texture = static_cast<const GLTexture&>(*request.texture);
+  const float texture_width = static_cast<float>(texture.get_texture_width());
+  const float texture_height = static_cast<float>(texture.get_texture_height());
+
+  // Only called when the context supports instancing.
+  auto& context = static_cast<GL33CoreContext&>(m_video_system.get_context());
+
+  // One record per quad, the vertex shader does the rotation.
+  GLInstance* instance = context.map_instances(request.srcrects.size());
 
+  for (size_t i = 0; i < request.srcrects.size(); ++i)
+  {
+    const Rectf& dstrect = request.dstrects[i];
+    const Rectf& srcrect = request.srcrects[i];
+
+    float uv_left = srcrect.get_left() / texture_width;
+    float uv_top = srcrect.get_top() / texture_height;
+    float uv_right = srcrect.get_right() / texture_width;
+    float uv_bottom = srcrect.get_bottom() / texture_height;
+
+    if (request.flip & HORIZONTAL_FLIP)
+      std::swap(uv_left, uv_right);
+
+    if (request.flip & VERTICAL_FLIP)
+      std::swap(uv_top, uv_bottom);
+
+    *instance++ = GLInstance{ (dstrect.get_left() + dstrect.get_right()) / 2,
+                              (dstrect.get_top() + dstrect.get_bottom()) / 2,
+                              (dstrect.get_right() - dstrect.get_left()) / 2,
+                              (dstrect.get_bottom() - dstrect.get_top()) / 2,
+                              math::radians(request.angles[i]),
+                              uv_left, uv_top, uv_right, uv_bottom };
+  }
+
+  context.set_color(color);
   context.blend_func(sfactor(request.blend), dfactor(request.blend));
   context.bind_texture(texture, request.displacement_texture);
-  context.set_texcoords(m_uvs.data(), sizeof(float) * m_uvs.size());
-  context.set_positions(m_vertices.data(), sizeof(float) * m_vertices.size());
+  context.draw_instances();
+
+  assert_gl();
+}
+
+GLPainter::MeshBuffer&
+GLPainter::get_mesh_buffer(const std::shared_ptr<const TextureMesh>& mesh, Flip flip)
+{
+  GLContext& context = m_video_system.get_context();
+
+  auto it = m_mesh_buffers.find(mesh->get_id());
+  if (it != m_mesh_buffers.end() && it->second.flip == flip)
+    return it->second;
+
+  if (it == m_mesh_buffers.end())
+  {
+    if (m_mesh_buffers.size() >= m_mesh_buffers_collect_size)
+      collect_mesh_buffers();
+
+    it = m_mesh_buffers.emplace(mesh->get_id(), MeshBuffer{mesh, flip, 0, {}, {}, 0, 0}).first;
+
+    if (context.supports_buffers())
+    {
+      glGenBuffers(1, &it->second.position_buffer);
+      glGenBuffers(1, &it->second.texcoord_buffer);
+    }
+  }
+
+  MeshBuffer& buffer = it->second;
+  buffer.flip = flip;
+  buffer.vertices.clear();
+  buffer.uvs.clear();
+
+  const auto& srcrects = mesh->get_srcrects();
+  const auto& dstrects = mesh->get_dstrects();
+
+  buffer.vertices.reserve(srcrects.size() * 12);
+  buffer.uvs.reserve(srcrects.size() * 12);
+
+  for (size_t i = 0; i < srcrects.size(); ++i)
+    add_quad(buffer.vertices, buffer.uvs, dstrects[i], srcrects[i], *mesh->get_texture(), flip);
+
+  buffer.vertex_count = static_cast<GLsizei>(srcrects.size() * 2 * 3);
+
+  if (context.supports_buffers())
+  {
+    glBindBuffer(GL_ARRAY_BUFFER, buffer.position_buffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * buffer.vertices.size(), buffer.vertices.data(), GL_STATIC_DRAW);
+
+    glBindBuffer(GL_ARRAY_BUFFER, buffer.texcoord_buffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * buffer.uvs.size(), buffer.uvs.data(), GL_STATIC_DRAW);
+
+    // The data lives on the GPU now.
+    buffer.vertices = {};
+    buffer.uvs = {};
+  }
+
+  return buffer;
+}
+
+void
+GLPainter::delete_mesh_buffer(MeshBuffer& buffer)
+{
+  if (buffer.position_buffer)
+    glDeleteBuffers(1, &buffer.position_buffer);
+  if (buffer.texcoord_buffer)
+    glDeleteBuffers(1, &buffer.texcoord_buffer);
+}
+
+void
+GLPainter::collect_mesh_buffers()
+{
+  for (auto it = m_mesh_buffers.begin(); it != m_mesh_buffers.end();)
+  {
+    if (it->second.mesh.expired())
+    {
+      delete_mesh_buffer(it->second);
+      it = m_mesh_buffers.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  m_mesh_buffers_collect_size = std::max(MIN_MESH_BUFFERS_COLLECT_SIZE, m_mesh_buffers.size() * 2);
+}
+
+void
+GLPainter::draw_texture_mesh(const TextureMeshRequest& request)
+{
+  assert_gl();
+
+  const TextureMesh& mesh = *request.mesh;
+  if (mesh.get_srcrects().empty())
+    return;
+
+  const MeshBuffer& buffer = get_mesh_buffer(request.mesh, request.flip);
+
+  GLContext& context = m_video_system.get_context();
+
+  context.blend_func(sfactor(request.blend), dfactor(request.blend));
+  context.bind_texture(*mesh.get_texture(), mesh.get_displacement_texture().get());
+
+  if (context.supports_buffers())
+  {
+    auto& core_context = static_cast<GL33CoreContext&>(context);
+    core_context.set_texcoord_buffer(buffer.texcoord_buffer);
+    core_context.set_position_buffer(buffer.position_buffer);
+  }
+  else
+  {
+    context.set_texcoords(buffer.uvs.data(), sizeof(float) * buffer.uvs.size());
+    context.set_positions(buffer.vertices.data(), sizeof(float) * buffer.vertices.size());
+  }
+
   context.set_color(Color(request.color.red,
                           request.color.green,
                           request.color.blue,
                           request.color.alpha * request.alpha));
 
-  context.draw_arrays(GL_TRIANGLES, 0, static_cast<GLsizei>(request.srcrects.size() * 2 * 3));
+  context.set_transform(request.origin.x, request.origin.y, request.scale);
+  context.draw_arrays(GL_TRIANGLES, 0, buffer.vertex_count);
+  context.set_transform(0.0f, 0.0f, 1.0f);
 
   assert_gl();
 }
@@ -460,6 +675,62 @@ GLPainter::draw_triangle(const TriangleRequest& request)
   assert_gl();
 }
 
+void
+GLPainter::draw_solid_batch(const SolidBatchRequest& request)
+{
+  assert_gl();
+
+  GLContext& context = m_video_system.get_context();
+
+  const Color& color = request.color;
+  GLVertex* vertex = context.map_vertices(request.rects.size() * 6 + request.lines.size() / 2 * 6);
+
+  const auto add_corners = [&vertex, &color](const float (&x)[4], const float (&y)[4]) {
+    for (const int corner : { 0, 1, 2, 2, 1, 3 })
+    {
+      *vertex++ = GLVertex{ x[corner], y[corner], 0.0f, 0.0f,
+                            color.red, color.green, color.blue, color.alpha };
+    }
+  };
+
+  for (const auto& rect : request.rects)
+  {
+    const float x[4] = { rect.get_left(), rect.get_right(), rect.get_left(), rect.get_right() };
+    const float y[4] = { rect.get_top(), rect.get_top(), rect.get_bottom(), rect.get_bottom() };
+    add_corners(x, y);
+  }
+
+  // Lines become quads one pixel wide, like in draw_line().
+  const Vector viewport_scale = m_video_system.get_viewport().get_scale();
+  for (size_t i = 0; i + 1 < request.lines.size(); i += 2)
+  {
+    const float& x1 = request.lines[i].x;
+    const float& y1 = request.lines[i].y;
+    const float& x2 = request.lines[i + 1].x;
+    const float& y2 = request.lines[i + 1].y;
+
+    float x_step = (y2 - y1);
+    float y_step = -(x2 - x1);
+
+    const float step_norm = sqrtf(x_step * x_step + y_step * y_step);
+    x_step /= step_norm * viewport_scale.x;
+    y_step /= step_norm * viewport_scale.y;
+
+    x_step *= 0.5f;
+    y_step *= 0.5f;
+
+    const float x[4] = { x1 - x_step, x2 - x_step, x1 + x_step, x2 + x_step };
+    const float y[4] = { y1 - y_step, y2 - y_step, y1 + y_step, y2 + y_step };
+    add_corners(x, y);
+  }
+
+  context.blend_func(sfactor(request.blend), dfactor(request.blend));
+  context.bind_no_texture();
+  context.draw_vertices(GL_TRIANGLES);
+
+  assert_gl();
+}
+
 void
 GLPainter::clear(const Color& color)
 {
@@ -472,40 +743,30 @@ GLPainter::clear(const Color& color)
 }
 
 void
-GLPainter::get_pixel(const GetPixelRequest& request) const
+GLPainter::get_pixel(const GetPixelRequest& request)
 {
-  assert_gl();
-
   const Rect& rect = m_renderer.get_rect();
   const Size& logical_size = m_renderer.get_logical_size();
 
-  float x = request.pos.x * static_cast<float>(rect.get_width()) / static_cast<float>(logical_size.width);
-  float y = request.pos.y * static_cast<float>(rect.get_height()) / static_cast<float>(logical_size.height);
-
-  x += static_cast<float>(rect.left);
-  y += static_cast<float>(rect.top);
-
-#if 0
-  // #ifndef USE_OPENGLES2
-  //
-  // FIXME: glFenceSync() causes crashes on Intel I965, so disable
-  // GLPixelRequest for now, it's not yet properly used anyway.
-  GLPixelRequest pixel_request(1, 1);
-  pixel_request.request(static_cast<int>(x), static_cast<int>(y));
-
-  *(request.color_ptr) = pixel_request.get_color();
+  m_pixel_queries.clear();
+  for (size_t i = 0; i < request.positions.size(); ++i)
+  {
+    float x = request.positions[i].x * static_cast<float>(rect.get_width()) / static_cast<float>(logical_size.width);
+    float y = request.positions[i].y * static_cast<float>(rect.get_height()) / static_cast<float>(logical_size.height);
 
-#else
-  float pixels[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    x += static_cast<float>(rect.left);
+    y += static_cast<float>(rect.top);
 
-  // OpenGLES2 does not have PBOs, only GLES3 has.
-  glReadPixels(static_cast<GLint>(x), static_cast<GLint>(y),
-               1, 1, GL_RGB, GL_FLOAT, pixels);
+    m_pixel_queries.push_back({ static_cast<int>(x), static_cast<int>(y), request.color_ptrs[i] });
+  }
 
-  *(request.color_ptr) = Color(pixels[0], pixels[1], pixels[2]);
-#endif
+  m_pixel_request.request(m_pixel_queries);
+}
 
-  assert_gl();
+void
+GLPainter::resolve_pixel_requests()
+{
+  m_pixel_request.resolve();
 }
 
 void
@@ -18,37 +18,79 @@
 
 #include "video/painter.hpp"
 
+#include <memory>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
 #include "video/flip.hpp"
+#include "video/gl.hpp"
+#include "video/gl/gl_pixel_request.hpp"
 
 enum class Blend;
 class GLRenderer;
 class GLVideoSystem;
+class TextureMesh;
 
 class GLPainter final : public Painter
 {
 public:
   GLPainter(GLVideoSystem& video_system, GLRenderer& renderer);
+  ~GLPainter() override;
 
   virtual void draw_texture(const TextureRequest& request) override;
+  virtual void draw_texture_mesh(const TextureMeshRequest& request) override;
   virtual void draw_gradient(const GradientRequest& request) override;
   virtual void draw_filled_rect(const FillRectRequest& request) override;
   virtual void draw_inverse_ellipse(const InverseEllipseRequest& request) override;
   virtual void draw_line(const LineRequest& request) override;
   virtual void draw_triangle(const TriangleRequest& request) override;
+  virtual void draw_solid_batch(const SolidBatchRequest& request) override;
 
   virtual void clear(const Color& color) override;
-  virtual void get_pixel(const GetPixelRequest& request) const override;
+  virtual void get_pixel(const GetPixelRequest& request) override;
+
+  /** Delivers the colors of the last get_pixel() call, which are read
+      back asynchronously. Called once per frame by the renderers. */
+  void resolve_pixel_requests();
 
   virtual void set_clip_rect(const Rect& rect) override;
   virtual void clear_clip_rect() override;
 
+private:
+  /** Draws the quads of @c request as instances that the GPU expands,
+      for contexts that support it */
+  void draw_texture_instanced(const TextureRequest& request, const Color& color);
+
+  /** Copy of a TextureMesh in GPU memory, or in client memory when the
+      context doesn't support buffer objects. */
+  struct MeshBuffer
+  {
+    std::weak_ptr<const TextureMesh> mesh;
+    Flip flip;
+    GLsizei vertex_count;
+    std::vector<float> vertices;
+    std::vector<float> uvs;
+    GLuint position_buffer;
+    GLuint texcoord_buffer;
+  };
+
+  MeshBuffer& get_mesh_buffer(const std::shared_ptr<const TextureMesh>& mesh, Flip flip);
+  void delete_mesh_buffer(MeshBuffer& buffer);
+
+  /** Drops the buffers of meshes that don't exist anymore */
+  void collect_mesh_buffers();
+
 private:
   GLVideoSystem& m_video_system;
   GLRenderer& m_renderer;
 
 private:
-  std::vector<float> m_vertices;
-  std::vector<float> m_uvs;
+  std::unordered_map<uint64_t, MeshBuffer> m_mesh_buffers;
+  size_t m_mesh_buffers_collect_size;
+
+  GLPixelRequest m_pixel_request;
+  std::vector<GLPixelQuery> m_pixel_queries;
 
 private:
   GLPainter(const GLPainter&) = delete;
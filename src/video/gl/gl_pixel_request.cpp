@@ -16,99 +16,121 @@
 
 #include "video/gl/gl_pixel_request.hpp"
 
-#include <iostream>
+#include <algorithm>
+#include <limits>
 
-#include "util/log.hpp"
 #include "video/glutil.hpp"
 
-#ifndef USE_OPENGLES2
+namespace {
 
-GLPixelRequest::GLPixelRequest(int width, int height) :
-  m_buffer(),
-  m_width(width),
-  m_height(height),
-  m_offset(0),
-  m_sync()
+bool supports_pixel_buffers()
 {
-  assert_gl();
+#ifdef USE_OPENGLES2
+  // OpenGLES2 does not have PBOs, only GLES3 has.
+  return false;
+#else
+  return GLEW_VERSION_2_1 || GLEW_ARB_pixel_buffer_object;
+#endif
+}
 
-  glGenBuffers(1, &m_buffer);
-  glBindBuffer(GL_PIXEL_PACK_BUFFER, m_buffer);
-  glBufferData(GL_PIXEL_PACK_BUFFER, m_width * m_height * 4, nullptr, GL_DYNAMIC_READ);
-  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+} // namespace
 
-  assert_gl();
+GLPixelRequest::GLPixelRequest() :
+  m_buffer(),
+  m_buffer_size(0),
+  m_rect(),
+  m_queries(),
+  m_pixels()
+{
 }
 
 GLPixelRequest::~GLPixelRequest()
 {
-  glDeleteBuffers(1, &m_buffer);
+  if (m_buffer)
+    glDeleteBuffers(1, &m_buffer);
 }
 
 void
-GLPixelRequest::request(int x, int y)
+GLPixelRequest::request(std::vector<GLPixelQuery>& queries)
 {
-  assert_gl();
+  resolve();
 
-  glBindBuffer(GL_PIXEL_PACK_BUFFER, m_buffer);
-  glReadPixels(x, y, m_width, m_height, GL_RGB, GL_UNSIGNED_BYTE,
-               reinterpret_cast<GLvoid*>(m_offset));
-  m_sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, GL_NONE_BIT);
-  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  if (queries.empty())
+    return;
 
   assert_gl();
-}
-
-bool
-GLPixelRequest::is_ready() const
-{
-  assert_gl();
-
-  GLenum ret = glClientWaitSync(m_sync, GL_NONE_BIT, 0);
 
-  if (ret == GL_CONDITION_SATISFIED ||
-      ret == GL_ALREADY_SIGNALED)
+  int left = std::numeric_limits<int>::max();
+  int top = std::numeric_limits<int>::max();
+  int right = std::numeric_limits<int>::min();
+  int bottom = std::numeric_limits<int>::min();
+  for (const auto& query : queries)
   {
-    //std::cout << "fence ready: " << static_cast<int>(ret) << " " << GL_ALREADY_SIGNALED << std::endl;
-    return true;
+    left = std::min(left, query.x);
+    top = std::min(top, query.y);
+    right = std::max(right, query.x + 1);
+    bottom = std::max(bottom, query.y + 1);
   }
-  else if (ret == GL_TIMEOUT_EXPIRED)
+  m_rect = Rect(left, top, right, bottom);
+  m_queries.swap(queries);
 
+  const GLsizeiptr size = static_cast<GLsizeiptr>(m_rect.get_width()) * m_rect.get_height() * 4;
+  m_pixels.resize(static_cast<size_t>(size));
+
+#ifndef USE_OPENGLES2
+  if (!m_buffer && supports_pixel_buffers())
+    glGenBuffers(1, &m_buffer);
+
+  if (m_buffer)
   {
-    //std::cout << "timeout: " << static_cast<int>(ret) << std::endl;
-    return false;
-  }
-  else if (ret == GL_WAIT_FAILED)
-  {
-    return true;
-  }
-  else
-  {
-    log_warning << "unknown glClientWaitSync() return value: " << static_cast<int>(ret) << std::endl;
-    return true;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, m_buffer);
+    if (size > m_buffer_size)
+    {
+      glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+      m_buffer_size = size;
+    }
+
+    // Returns right away, the GPU copies into the buffer when it gets there.
+    glReadPixels(m_rect.left, m_rect.top, m_rect.get_width(), m_rect.get_height(),
+                 GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    assert_gl();
+    return;
   }
+#endif
+
+  glReadPixels(m_rect.left, m_rect.top, m_rect.get_width(), m_rect.get_height(),
+               GL_RGBA, GL_UNSIGNED_BYTE, m_pixels.data());
+  resolve();
 
   assert_gl();
 }
 
 void
-GLPixelRequest::get(void* buffer, size_t length) const
+GLPixelRequest::resolve()
 {
-  assert_gl();
-
-  glBindBuffer(GL_PIXEL_PACK_BUFFER, m_buffer);
-  glGetBufferSubData(GL_PIXEL_PACK_BUFFER, m_offset, length, buffer);
-  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  if (m_queries.empty())
+    return;
 
-  assert_gl();
-}
+#ifndef USE_OPENGLES2
+  if (m_buffer)
+  {
+    assert_gl();
 
-Color
-GLPixelRequest::get_color() const
-{
-  uint8_t data[3];
-  get(data, sizeof(data));
-  return Color::from_rgb888(data[0], data[1], data[2]);
-}
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, m_buffer);
+    glGetBufferSubData(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(m_pixels.size()), m_pixels.data());
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
 
+    assert_gl();
+  }
 #endif
+
+  for (const auto& query : m_queries)
+  {
+    const size_t offset = (static_cast<size_t>(query.y - m_rect.top) * static_cast<size_t>(m_rect.get_width()) +
+                           static_cast<size_t>(query.x - m_rect.left)) * 4;
+    *query.color = Color::from_rgb888(m_pixels[offset], m_pixels[offset + 1], m_pixels[offset + 2]);
+  }
+  m_queries.clear();
+}
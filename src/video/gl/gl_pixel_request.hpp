@@ -16,36 +16,48 @@
 
 #pragma once
 
-#include <stddef.h>
+#include <memory>
+#include <stdint.h>
+#include <vector>
 
+#include "math/rect.hpp"
 #include "video/color.hpp"
 #include "video/gl.hpp"
 
-#ifndef USE_OPENGLES2
+/** A pixel of the bound framebuffer whose color is wanted */
+struct GLPixelQuery
+{
+  int x;
+  int y;
+  std::shared_ptr<Color> color;
+};
 
+/** Reads the pixels of a batch of queries with a single glReadPixels()
+    of the smallest rectangle around them. With a pixel pack buffer the
+    copy doesn't wait for the GPU, the colors are delivered by the next
+    resolve(), usually a frame later when the copy has long finished.
+    Without one the colors are read and delivered right away. */
 class GLPixelRequest final
 {
 public:
-  GLPixelRequest(int width, int height);
+  GLPixelRequest();
   ~GLPixelRequest();
 
-  void request(int x, int y);
-  bool is_ready() const;
-  Color get_color() const;
+  /** Delivers the previous batch and starts reading @c queries, which
+      is left with the storage of the previous batch. */
+  void request(std::vector<GLPixelQuery>& queries);
 
-private:
-  void get(void* buffer, size_t length) const;
+  /** Writes the colors of the pending queries */
+  void resolve();
 
 private:
   GLuint m_buffer;
-  int m_width;
-  int m_height;
-  GLintptr m_offset;
-  GLsync m_sync;
+  GLsizeiptr m_buffer_size;
+  Rect m_rect;
+  std::vector<GLPixelQuery> m_queries;
+  std::vector<uint8_t> m_pixels;
 
 private:
   GLPixelRequest(const GLPixelRequest&) = delete;
   GLPixelRequest& operator=(const GLPixelRequest&) = delete;
 };
-
-#endif
@@ -35,7 +35,11 @@ GLProgram::GLProgram() :
   m_displacement_animate_location(-1),
   m_position_location(-1),
   m_texcoord_location(-1),
-  m_diffuse_location(-1)
+  m_diffuse_location(-1),
+  m_instanced_location(-1),
+  m_instance_rect_location(-1),
+  m_instance_angle_location(-1),
+  m_instance_texcoords_location(-1)
 {
   assert_gl();
 
@@ -74,6 +78,10 @@ GLProgram::GLProgram() :
   m_position_location = glGetAttribLocation(m_program, "position");
   m_texcoord_location = glGetAttribLocation(m_program, "texcoord");
   m_diffuse_location = glGetAttribLocation(m_program, "diffuse");
+  m_instanced_location = glGetUniformLocation(m_program, "instanced");
+  m_instance_rect_location = glGetAttribLocation(m_program, "instance_rect");
+  m_instance_angle_location = glGetAttribLocation(m_program, "instance_angle");
+  m_instance_texcoords_location = glGetAttribLocation(m_program, "instance_texcoords");
 
   assert_gl();
 }
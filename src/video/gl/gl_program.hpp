@@ -45,6 +45,10 @@ public:
   inline GLint get_position_location() const { return check_valid(m_position_location, "position"); }
   inline GLint get_texcoord_location() const { return check_valid(m_texcoord_location, "texcoord"); }
   inline GLint get_diffuse_location() const { return check_valid(m_diffuse_location, "diffuse"); }
+  inline GLint get_instanced_location() const { return check_valid(m_instanced_location, "instanced"); }
+  inline GLint get_instance_rect_location() const { return check_valid(m_instance_rect_location, "instance_rect"); }
+  inline GLint get_instance_angle_location() const { return check_valid(m_instance_angle_location, "instance_angle"); }
+  inline GLint get_instance_texcoords_location() const { return check_valid(m_instance_texcoords_location, "instance_texcoords"); }
 
 private:
   bool get_link_status() const;
@@ -70,6 +74,10 @@ private:
   GLint m_position_location;
   GLint m_texcoord_location;
   GLint m_diffuse_location;
+  GLint m_instanced_location;
+  GLint m_instance_rect_location;
+  GLint m_instance_angle_location;
+  GLint m_instance_texcoords_location;
 
 private:
   GLProgram(const GLProgram&) = delete;
@@ -44,6 +44,9 @@ GLScreenRenderer::start_draw()
   GLContext& context = m_video_system.get_context();
   context.bind();
 
+  // Colors read back last frame are surely done by now.
+  m_painter.resolve_pixel_requests();
+
   context.blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
   const Viewport& viewport = m_video_system.get_viewport();
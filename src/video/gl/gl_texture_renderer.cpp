@@ -77,6 +77,9 @@ GLTextureRenderer::start_draw()
   GLContext& context = m_video_system.get_context();
   context.bind();
 
+  // Colors read back last frame are surely done by now.
+  m_painter.resolve_pixel_requests();
+
   if (m_framebuffer)
   {
     glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer->get_handle());
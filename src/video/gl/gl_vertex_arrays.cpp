@@ -16,9 +16,12 @@
 
 #include "video/gl/gl_vertex_arrays.hpp"
 
+#include <stddef.h>
+
 #include "video/color.hpp"
 #include "video/gl/gl33core_context.hpp"
 #include "video/gl/gl_program.hpp"
+#include "video/gl/gl_vertex_stream.hpp"
 #include "video/gl/gl_video_system.hpp"
 #include "video/glutil.hpp"
 
@@ -72,6 +75,20 @@ GLVertexArrays::set_positions(const float* data, size_t size)
   assert_gl();
 }
 
+void
+GLVertexArrays::set_position_buffer(GLuint buffer)
+{
+  assert_gl();
+
+  glBindBuffer(GL_ARRAY_BUFFER, buffer);
+
+  int loc = m_context.get_program().get_position_location();
+  glVertexAttribPointer(loc, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+  glEnableVertexAttribArray(loc);
+
+  assert_gl();
+}
+
 void
 GLVertexArrays::set_texcoords(const float* data, size_t size)
 {
@@ -99,6 +116,20 @@ GLVertexArrays::set_texcoord(float u, float v)
   assert_gl();
 }
 
+void
+GLVertexArrays::set_texcoord_buffer(GLuint buffer)
+{
+  assert_gl();
+
+  glBindBuffer(GL_ARRAY_BUFFER, buffer);
+
+  int loc = m_context.get_program().get_texcoord_location();
+  glVertexAttribPointer(loc, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+  glEnableVertexAttribArray(loc);
+
+  assert_gl();
+}
+
 void
 GLVertexArrays::set_colors(const float* data, size_t size)
 {
@@ -125,3 +156,75 @@ GLVertexArrays::set_color(const Color& color)
 
   assert_gl();
 }
+
+void
+GLVertexArrays::set_vertex_stream(GLuint buffer)
+{
+  assert_gl();
+
+  glBindBuffer(GL_ARRAY_BUFFER, buffer);
+
+  const GLsizei stride = sizeof(GLVertex);
+  const GLProgram& program = m_context.get_program();
+
+  glVertexAttribPointer(program.get_position_location(), 2, GL_FLOAT, GL_FALSE, stride,
+                        reinterpret_cast<void*>(offsetof(GLVertex, x)));
+  glEnableVertexAttribArray(program.get_position_location());
+
+  glVertexAttribPointer(program.get_texcoord_location(), 2, GL_FLOAT, GL_FALSE, stride,
+                        reinterpret_cast<void*>(offsetof(GLVertex, u)));
+  glEnableVertexAttribArray(program.get_texcoord_location());
+
+  glVertexAttribPointer(program.get_diffuse_location(), 4, GL_FLOAT, GL_FALSE, stride,
+                        reinterpret_cast<void*>(offsetof(GLVertex, r)));
+  glEnableVertexAttribArray(program.get_diffuse_location());
+
+  assert_gl();
+}
+
+void
+GLVertexArrays::set_instance_stream(GLuint buffer, GLint first)
+{
+  assert_gl();
+
+  glBindBuffer(GL_ARRAY_BUFFER, buffer);
+
+  const GLsizei stride = sizeof(GLInstance);
+  const size_t offset = sizeof(GLInstance) * static_cast<size_t>(first);
+  const GLProgram& program = m_context.get_program();
+
+  // The vertex shader makes up positions and texcoords from the instance.
+  glDisableVertexAttribArray(program.get_position_location());
+  glDisableVertexAttribArray(program.get_texcoord_location());
+
+  glVertexAttribPointer(program.get_instance_rect_location(), 4, GL_FLOAT, GL_FALSE, stride,
+                        reinterpret_cast<void*>(offset + offsetof(GLInstance, x)));
+  glVertexAttribDivisor(program.get_instance_rect_location(), 1);
+  glEnableVertexAttribArray(program.get_instance_rect_location());
+
+  glVertexAttribPointer(program.get_instance_angle_location(), 1, GL_FLOAT, GL_FALSE, stride,
+                        reinterpret_cast<void*>(offset + offsetof(GLInstance, angle)));
+  glVertexAttribDivisor(program.get_instance_angle_location(), 1);
+  glEnableVertexAttribArray(program.get_instance_angle_location());
+
+  glVertexAttribPointer(program.get_instance_texcoords_location(), 4, GL_FLOAT, GL_FALSE, stride,
+                        reinterpret_cast<void*>(offset + offsetof(GLInstance, u1)));
+  glVertexAttribDivisor(program.get_instance_texcoords_location(), 1);
+  glEnableVertexAttribArray(program.get_instance_texcoords_location());
+
+  assert_gl();
+}
+
+void
+GLVertexArrays::unset_instance_stream()
+{
+  assert_gl();
+
+  const GLProgram& program = m_context.get_program();
+
+  glDisableVertexAttribArray(program.get_instance_rect_location());
+  glDisableVertexAttribArray(program.get_instance_angle_location());
+  glDisableVertexAttribArray(program.get_instance_texcoords_location());
+
+  assert_gl();
+}
@@ -32,14 +32,24 @@ public:
   void bind();
 
   void set_positions(const float* data, size_t size);
+  void set_position_buffer(GLuint buffer);
 
   /** size is in bytes */
   void set_texcoords(const float* data, size_t size);
   void set_texcoord(float u, float v);
+  void set_texcoord_buffer(GLuint buffer);
 
   void set_colors(const float* data, size_t size);
   void set_color(const Color& color);
 
+  /** Takes positions, texcoords and colors from a buffer of GLVertex */
+  void set_vertex_stream(GLuint buffer);
+
+  /** Takes one quad per instance from a buffer of GLInstance, starting
+      at instance @c first */
+  void set_instance_stream(GLuint buffer, GLint first);
+  void unset_instance_stream();
+
 private:
   GL33CoreContext& m_context;
   GLuint m_vao;
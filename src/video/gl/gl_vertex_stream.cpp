@@ -0,0 +1,244 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "video/gl/gl_vertex_stream.hpp"
+
+#include "util/log.hpp"
+#include "video/glutil.hpp"
+
+#ifdef USE_GLBINDING
+#  include <glbinding/ContextInfo.h>
+#  include <glbinding/gl/extension.h>
+#endif
+
+namespace {
+
+/** Number of frames that may be in flight while the CPU writes the next one */
+const size_t SEGMENT_COUNT = 3;
+
+/** Elements per segment at the start, 2 MiB of GLVertex */
+const size_t INITIAL_CAPACITY = 1 << 16;
+
+size_t grow_capacity(size_t capacity, size_t count)
+{
+  while (capacity < count)
+    capacity *= 2;
+  return capacity;
+}
+
+} // namespace
+
+bool
+GLVertexStream::supports_persistent_mapping()
+{
+#if defined(USE_OPENGLES2) || defined(USE_OPENGLES1)
+  return false;
+#elif defined(USE_GLBINDING)
+  static auto extensions = glbinding::ContextInfo::extensions();
+  return extensions.find(GLextension::GL_ARB_buffer_storage) != extensions.end();
+#else
+  return GLEW_ARB_buffer_storage;
+#endif
+}
+
+GLVertexStream::GLVertexStream(bool persistent, size_t stride) :
+  m_persistent(persistent),
+  m_stride(stride),
+  m_buffer(),
+  m_capacity(0),
+  m_head(0),
+  m_mapped_count(0),
+  m_data(nullptr),
+  m_segment(0),
+#if !defined(USE_OPENGLES2) && !defined(USE_OPENGLES1)
+  m_fences(SEGMENT_COUNT, nullptr),
+#endif
+  m_staging()
+{
+  create_buffer(INITIAL_CAPACITY);
+}
+
+GLVertexStream::~GLVertexStream()
+{
+  delete_buffer();
+}
+
+void
+GLVertexStream::create_buffer(size_t capacity)
+{
+  assert_gl();
+
+  m_capacity = capacity;
+  m_head = 0;
+  m_segment = 0;
+
+  glGenBuffers(1, &m_buffer);
+  glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+
+#if !defined(USE_OPENGLES2) && !defined(USE_OPENGLES1)
+  if (m_persistent)
+  {
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    const GLsizeiptr size = static_cast<GLsizeiptr>(m_stride * m_capacity * SEGMENT_COUNT);
+
+    glBufferStorage(GL_ARRAY_BUFFER, size, nullptr, flags);
+    m_data = static_cast<char*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags));
+
+    if (m_data)
+    {
+      assert_gl();
+      return;
+    }
+
+    log_warning << "GLVertexStream: mapping the vertex buffer failed, falling back to glBufferSubData()" << std::endl;
+    glDeleteBuffers(1, &m_buffer);
+    glGenBuffers(1, &m_buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+    m_persistent = false;
+  }
+#endif
+
+  glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(m_stride * m_capacity),
+               nullptr, GL_STREAM_DRAW);
+
+  assert_gl();
+}
+
+void
+GLVertexStream::delete_buffer()
+{
+#if !defined(USE_OPENGLES2) && !defined(USE_OPENGLES1)
+  if (m_persistent)
+  {
+    for (size_t segment = 0; segment < SEGMENT_COUNT; ++segment)
+      wait_segment(segment);
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+    m_data = nullptr;
+  }
+#endif
+
+  glDeleteBuffers(1, &m_buffer);
+  m_buffer = 0;
+}
+
+void*
+GLVertexStream::map(size_t count)
+{
+  m_mapped_count = count;
+
+  if (!m_persistent)
+  {
+    if (m_staging.size() < m_stride * count)
+      m_staging.resize(m_stride * count);
+    return m_staging.data();
+  }
+
+  if (count > m_capacity)
+  {
+    const size_t capacity = grow_capacity(m_capacity, count);
+    delete_buffer();
+    create_buffer(capacity);
+  }
+  else if (m_head + count > m_capacity)
+  {
+    next_segment();
+  }
+
+  return m_data + m_stride * (m_segment * m_capacity + m_head);
+}
+
+GLint
+GLVertexStream::commit()
+{
+  assert_gl();
+
+  glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+
+  if (!m_persistent)
+  {
+    // Orphaning the buffer lets the driver hand out fresh memory, while
+    // draws that still use the old contents keep it until they are done.
+    if (m_mapped_count > m_capacity)
+    {
+      m_capacity = grow_capacity(m_capacity, m_mapped_count);
+      glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(m_stride * m_capacity),
+                   nullptr, GL_STREAM_DRAW);
+      m_head = 0;
+    }
+    else if (m_head + m_mapped_count > m_capacity)
+    {
+      glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(m_stride * m_capacity),
+                   nullptr, GL_STREAM_DRAW);
+      m_head = 0;
+    }
+
+    glBufferSubData(GL_ARRAY_BUFFER,
+                    static_cast<GLintptr>(m_stride * m_head),
+                    static_cast<GLsizeiptr>(m_stride * m_mapped_count),
+                    m_staging.data());
+  }
+
+  // The persistent mapping is coherent, so nothing needs to be flushed.
+  const size_t first = (m_persistent ? m_segment * m_capacity : 0) + m_head;
+  m_head += m_mapped_count;
+  m_mapped_count = 0;
+
+  assert_gl();
+
+  return static_cast<GLint>(first);
+}
+
+void
+GLVertexStream::next_frame()
+{
+  if (m_persistent && m_head > 0)
+    next_segment();
+}
+
+void
+GLVertexStream::next_segment()
+{
+#if !defined(USE_OPENGLES2) && !defined(USE_OPENGLES1)
+  m_fences[m_segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, GL_NONE_BIT);
+  m_segment = (m_segment + 1) % SEGMENT_COUNT;
+  wait_segment(m_segment);
+#endif
+  m_head = 0;
+}
+
+void
+GLVertexStream::wait_segment(size_t segment)
+{
+#if !defined(USE_OPENGLES2) && !defined(USE_OPENGLES1)
+  GLsync& fence = m_fences[segment];
+  if (!fence)
+    return;
+
+  // Waits for at most a second at a time, so a lost context can't hang us.
+  for (int i = 0; i < 10; ++i)
+  {
+    const GLenum ret = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+    if (ret != GL_TIMEOUT_EXPIRED)
+      break;
+  }
+
+  glDeleteSync(fence);
+  fence = nullptr;
+#endif
+}
@@ -0,0 +1,116 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <stddef.h>
+#include <vector>
+
+#include "video/gl.hpp"
+
+/** Vertex layout of the GLVertexStream, positions, texcoords and
+    colors are interleaved. */
+struct GLVertex
+{
+  float x, y;
+  float u, v;
+  float r, g, b, a;
+};
+
+/** Layout of the per-quad records that GL33CoreContext::draw_instances()
+    expands into quads in the vertex shader */
+struct GLInstance
+{
+  /** Center and half of the size of the quad */
+  float x, y;
+  float half_width, half_height;
+
+  /** Rotation around the center, in radians */
+  float angle;
+
+  /** Texcoords of the top left and the bottom right corner */
+  float u1, v1, u2, v2;
+};
+
+/**
+ * Streaming vertex buffer that the GLPainter appends the geometry of
+ * each request to, so that draws don't each allocate a new buffer. It
+ * holds elements of @c stride bytes, GLVertex by default.
+ *
+ * With ARB_buffer_storage the buffer is mapped once for its whole
+ * lifetime and split into one segment per frame in flight, fences keep
+ * segments that the GPU is still reading from being overwritten.
+ * Without it vertices are written to client memory and copied into the
+ * buffer with glBufferSubData(), the buffer is orphaned when it is full.
+ */
+class GLVertexStream final
+{
+public:
+  /** Whether the context supports persistently mapped buffers */
+  static bool supports_persistent_mapping();
+
+public:
+  GLVertexStream(bool persistent, size_t stride = sizeof(GLVertex));
+  ~GLVertexStream();
+
+  /** Returns room for @c count elements, which stays valid until commit() */
+  void* map(size_t count);
+
+  /** Hands the vertices written since map() to the GPU, leaves the
+      buffer bound to GL_ARRAY_BUFFER and returns the index of the first
+      element. */
+  GLint commit();
+
+  /** Called once at the end of every frame */
+  void next_frame();
+
+  inline GLuint get_buffer() const { return m_buffer; }
+  inline size_t get_mapped_count() const { return m_mapped_count; }
+
+private:
+  void create_buffer(size_t capacity);
+  void delete_buffer();
+
+  /** Fences the current segment and waits until the GPU is done with
+      the next one. */
+  void next_segment();
+  void wait_segment(size_t segment);
+
+private:
+  bool m_persistent;
+  size_t m_stride;
+  GLuint m_buffer;
+
+  /** Number of elements the buffer (or each segment of it) holds */
+  size_t m_capacity;
+  size_t m_head;
+  size_t m_mapped_count;
+
+  /** Persistent mapping */
+  char* m_data;
+  size_t m_segment;
+#if !defined(USE_OPENGLES2) && !defined(USE_OPENGLES1)
+  std::vector<GLsync> m_fences;
+#endif
+
+  /** Client memory for the glBufferSubData() path */
+  std::vector<char> m_staging;
+
+private:
+  GLVertexStream(const GLVertexStream&) = delete;
+  GLVertexStream& operator=(const GLVertexStream&) = delete;
+};
@@ -305,6 +305,7 @@ void
 GLVideoSystem::flip()
 {
   assert_gl();
+  m_context->next_frame();
   SDL_GL_SwapWindow(m_sdl_window.get());
 }
 
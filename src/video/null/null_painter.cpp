@@ -33,6 +33,12 @@ NullPainter::draw_texture(const TextureRequest& request)
   log_info << "NullPainter::draw_texture()" << std::endl;
 }
 
+void
+NullPainter::draw_texture_mesh(const TextureMeshRequest& request)
+{
+  log_info << "NullPainter::draw_texture_mesh()" << std::endl;
+}
+
 void
 NullPainter::draw_gradient(const GradientRequest& request)
 {
@@ -63,6 +69,12 @@ NullPainter::draw_triangle(const TriangleRequest& request)
   log_info << "NullPainter::draw_triangle()" << std::endl;
 }
 
+void
+NullPainter::draw_solid_batch(const SolidBatchRequest& request)
+{
+  log_info << "NullPainter::draw_solid_batch()" << std::endl;
+}
+
 
 void
 NullPainter::clear(const Color& color)
@@ -71,7 +83,7 @@ NullPainter::clear(const Color& color)
 }
 
 void
-NullPainter::get_pixel(const GetPixelRequest& request) const
+NullPainter::get_pixel(const GetPixelRequest& request)
 {
   log_info << "NullPainter::get_pixel()" << std::endl;
 }
@@ -27,14 +27,16 @@ public:
   ~NullPainter() override;
 
   virtual void draw_texture(const TextureRequest& request) override;
+  virtual void draw_texture_mesh(const TextureMeshRequest& request) override;
   virtual void draw_gradient(const GradientRequest& request) override;
   virtual void draw_filled_rect(const FillRectRequest& request) override;
   virtual void draw_inverse_ellipse(const InverseEllipseRequest& request) override;
   virtual void draw_line(const LineRequest& request) override;
   virtual void draw_triangle(const TriangleRequest& request) override;
+  virtual void draw_solid_batch(const SolidBatchRequest& request) override;
 
   virtual void clear(const Color& color) override;
-  virtual void get_pixel(const GetPixelRequest& request) const override;
+  virtual void get_pixel(const GetPixelRequest& request) override;
 
   virtual void set_clip_rect(const Rect& rect) override;
   virtual void clear_clip_rect() override;
@@ -25,9 +25,14 @@
 #include "video/texture_manager.hpp"
 
 NullVideoSystem::NullVideoSystem() :
+  NullVideoSystem(Size(1920, 1080))
+{
+}
+
+NullVideoSystem::NullVideoSystem(const Size& screen_size) :
   m_window_size(g_config->window_size),
   m_vsync_mode(0),
-  m_viewport(Rect(0, 0, 1920, 1080), Vector(1.0f, 1.0f)),
+  m_viewport(Rect(0, 0, screen_size), Vector(1.0f, 1.0f)),
   m_screen_renderer(new NullRenderer),
   m_lightmap_renderer(new NullRenderer),
   m_texture_manager(new TextureManager)
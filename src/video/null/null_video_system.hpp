@@ -28,6 +28,11 @@ class NullVideoSystem : public VideoSystem
 {
 public:
   NullVideoSystem();
+
+  /** Uses a logical screen of the given size, for code that sizes
+      itself after the screen */
+  NullVideoSystem(const Size& screen_size);
+
   ~NullVideoSystem() override;
 
   virtual std::string get_name() const override { return "Null"; }
@@ -28,7 +28,9 @@ struct GetPixelRequest;
 struct GradientRequest;
 struct InverseEllipseRequest;
 struct LineRequest;
+struct SolidBatchRequest;
 struct TextureBatchRequest;
+struct TextureMeshRequest;
 struct TextureRequest;
 struct TriangleRequest;
 
@@ -39,14 +41,16 @@ public:
   virtual ~Painter() {}
 
   virtual void draw_texture(const TextureRequest& request) = 0;
+  virtual void draw_texture_mesh(const TextureMeshRequest& request) = 0;
   virtual void draw_gradient(const GradientRequest& request) = 0;
   virtual void draw_filled_rect(const FillRectRequest& request) = 0;
   virtual void draw_inverse_ellipse(const InverseEllipseRequest& request) = 0;
   virtual void draw_line(const LineRequest& request) = 0;
   virtual void draw_triangle(const TriangleRequest& request) = 0;
+  virtual void draw_solid_batch(const SolidBatchRequest& request) = 0;
 
   virtual void clear(const Color& color) = 0;
-  virtual void get_pixel(const GetPixelRequest& request) const = 0;
+  virtual void get_pixel(const GetPixelRequest& request) = 0;
 
   virtual void set_clip_rect(const Rect& rect) = 0;
   virtual void clear_clip_rect() = 0;
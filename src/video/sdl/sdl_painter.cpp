@@ -29,6 +29,7 @@
 #include "video/renderer.hpp"
 #include "video/sdl/sdl_texture.hpp"
 #include "video/sdl/sdl_video_system.hpp"
+#include "video/texture_mesh.hpp"
 #include "video/viewport.hpp"
 
 namespace {
@@ -222,10 +223,12 @@ SDLPainter::draw_texture(const TextureRequest& request)
     const SDL_Rect& src_rect = request.srcrects[i].to_rect().to_sdl();
     const SDL_FRect& dst_rect = request.dstrects[i].to_sdl();
 
-    Uint8 r = static_cast<Uint8>(request.color.red * 255);
-    Uint8 g = static_cast<Uint8>(request.color.green * 255);
-    Uint8 b = static_cast<Uint8>(request.color.blue * 255);
-    Uint8 a = static_cast<Uint8>(request.color.alpha * request.alpha * 255);
+    const Color& color = request.colors.empty() ? request.color : request.colors[i];
+
+    Uint8 r = static_cast<Uint8>(color.red * 255);
+    Uint8 g = static_cast<Uint8>(color.green * 255);
+    Uint8 b = static_cast<Uint8>(color.blue * 255);
+    Uint8 a = static_cast<Uint8>(color.alpha * request.alpha * 255);
 
     SDL_SetTextureColorMod(texture.get_texture(), r, g, b);
     SDL_SetTextureAlphaMod(texture.get_texture(), a);
@@ -249,6 +252,55 @@ SDLPainter::draw_texture(const TextureRequest& request)
   }
 }
 
+void
+SDLPainter::draw_texture_mesh(const TextureMeshRequest& request)
+{
+  const TextureMesh& mesh = *request.mesh;
+  const auto& texture = static_cast<const SDLTexture&>(*mesh.get_texture());
+
+  Uint8 r = static_cast<Uint8>(request.color.red * 255);
+  Uint8 g = static_cast<Uint8>(request.color.green * 255);
+  Uint8 b = static_cast<Uint8>(request.color.blue * 255);
+  Uint8 a = static_cast<Uint8>(request.color.alpha * request.alpha * 255);
+
+  SDL_SetTextureColorMod(texture.get_texture(), r, g, b);
+  SDL_SetTextureAlphaMod(texture.get_texture(), a);
+  SDL_SetTextureBlendMode(texture.get_texture(), blend2sdl(request.blend));
+
+  SDL_RendererFlip flip = SDL_FLIP_NONE;
+  if ((request.flip & HORIZONTAL_FLIP) != 0)
+  {
+    flip = static_cast<SDL_RendererFlip>(flip | SDL_FLIP_HORIZONTAL);
+  }
+
+  if ((request.flip & VERTICAL_FLIP) != 0)
+  {
+    flip = static_cast<SDL_RendererFlip>(flip | SDL_FLIP_VERTICAL);
+  }
+
+  // Meshes are usually much larger than the screen, so skip everything
+  // outside of the viewport instead of letting SDL clip it.
+  const Rectf viewport(request.viewport);
+
+  const auto& srcrects = mesh.get_srcrects();
+  const auto& dstrects = mesh.get_dstrects();
+  for (size_t i = 0; i < srcrects.size(); ++i)
+  {
+    const Rectf dstrect((dstrects[i].p1() + request.origin) * request.scale,
+                        dstrects[i].get_size() * request.scale);
+    if (!dstrect.overlaps(viewport))
+      continue;
+
+    const SDL_Rect& src_rect = srcrects[i].to_rect().to_sdl();
+    const SDL_FRect& dst_rect = dstrect.to_sdl();
+
+    RenderCopyEx(m_sdl_renderer, texture.get_texture(),
+                 &src_rect, &dst_rect,
+                 0.0, nullptr, flip,
+                 texture.get_sampler());
+  }
+}
+
 void
 SDLPainter::draw_gradient(const GradientRequest& request)
 {
@@ -572,6 +624,37 @@ SDLPainter::draw_triangle(const TriangleRequest& request)
   draw_span_between_edges(m_sdl_renderer, edges[longEdge], edges[shortEdge2]);
 }
 
+void
+SDLPainter::draw_solid_batch(const SolidBatchRequest& request)
+{
+  Uint8 r = static_cast<Uint8>(request.color.red * 255);
+  Uint8 g = static_cast<Uint8>(request.color.green * 255);
+  Uint8 b = static_cast<Uint8>(request.color.blue * 255);
+  Uint8 a = static_cast<Uint8>(request.color.alpha * 255);
+
+  SDL_SetRenderDrawBlendMode(m_sdl_renderer, SDL_BLENDMODE_BLEND);
+  SDL_SetRenderDrawColor(m_sdl_renderer, r, g, b, a);
+
+  std::vector<SDL_FRect> rects;
+  rects.reserve(request.rects.size());
+  for (const auto& rect : request.rects)
+  {
+    if (rect.get_width() != 0.0f && rect.get_height() != 0.0f)
+      rects.push_back(rect.to_sdl());
+  }
+
+  if (!rects.empty())
+    SDL_RenderFillRectsF(m_sdl_renderer, rects.data(), static_cast<int>(rects.size()));
+
+  // SDL_RenderDrawLinesF() would connect all the lines, so they are
+  // drawn one by one.
+  for (size_t i = 0; i + 1 < request.lines.size(); i += 2)
+  {
+    SDL_RenderDrawLineF(m_sdl_renderer, request.lines[i].x, request.lines[i].y,
+                                        request.lines[i + 1].x, request.lines[i + 1].y);
+  }
+}
+
 void
 SDLPainter::clear(const Color& color)
 {
@@ -614,26 +697,31 @@ SDLPainter::clear_clip_rect()
 }
 
 void
-SDLPainter::get_pixel(const GetPixelRequest& request) const
+SDLPainter::get_pixel(const GetPixelRequest& request)
 {
   const Rect& rect = m_renderer.get_rect();
   const Size& logical_size = m_renderer.get_logical_size();
 
-  SDL_Rect srcrect;
-  srcrect.x = rect.left + static_cast<int>(request.pos.x * static_cast<float>(rect.get_width()) / static_cast<float>(logical_size.width));
-  srcrect.y = rect.top + static_cast<int>(request.pos.y * static_cast<float>(rect.get_height()) / static_cast<float>(logical_size.height));
-  srcrect.w = 1;
-  srcrect.h = 1;
-
-  Uint8 pixel[4];
-  int ret = SDL_RenderReadPixels(m_sdl_renderer, &srcrect,
-                                 SDL_PIXELFORMAT_RGB888,
-                                 pixel,
-                                 1);
-  if (ret != 0)
+  for (size_t i = 0; i < request.positions.size(); ++i)
   {
-    log_warning << "failed to read pixels: " << SDL_GetError() << std::endl;
-  }
+    const Vector& pos = request.positions[i];
+
+    SDL_Rect srcrect;
+    srcrect.x = rect.left + static_cast<int>(pos.x * static_cast<float>(rect.get_width()) / static_cast<float>(logical_size.width));
+    srcrect.y = rect.top + static_cast<int>(pos.y * static_cast<float>(rect.get_height()) / static_cast<float>(logical_size.height));
+    srcrect.w = 1;
+    srcrect.h = 1;
+
+    Uint8 pixel[4];
+    int ret = SDL_RenderReadPixels(m_sdl_renderer, &srcrect,
+                                   SDL_PIXELFORMAT_RGB888,
+                                   pixel,
+                                   1);
+    if (ret != 0)
+    {
+      log_warning << "failed to read pixels: " << SDL_GetError() << std::endl;
+    }
 
-  *(request.color_ptr) = Color::from_rgb888(pixel[2], pixel[1], pixel[0]);
+    *(request.color_ptrs[i]) = Color::from_rgb888(pixel[2], pixel[1], pixel[0]);
+  }
 }
@@ -44,6 +44,7 @@ public:
   {
     if (this != &other)
     {
+      SDL_FreeSurface(m_surface);
       m_surface = other.m_surface;
       other.m_surface = nullptr;
     }
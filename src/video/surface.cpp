@@ -17,6 +17,7 @@
 #include "video/surface.hpp"
 
 #include <sstream>
+#include <tuple>
 
 #include "util/reader_document.hpp"
 #include "util/reader_mapping.hpp"
@@ -82,6 +83,18 @@ Surface::from_file(const std::string& filename, const std::optional<Rect>& rect)
   }
 }
 
+SurfacePtr
+Surface::from_file_packed(const std::string& filename, const std::optional<Rect>& rect)
+{
+  if (StringUtil::has_suffix(filename, ".surface"))
+    return from_file(filename, rect);
+
+  TexturePtr texture;
+  Rect region;
+  std::tie(texture, region) = TextureManager::current()->get_packed(filename, rect);
+  return SurfacePtr(new Surface(texture, TexturePtr(), region, NO_FLIP, filename));
+}
+
 Surface::Surface(const TexturePtr& diffuse_texture,
                  const TexturePtr& displacement_texture,
                  Flip flip, const std::string& filename) :
@@ -130,7 +143,7 @@ Surface::region(const Rect& rect) const
 {
   SurfacePtr surface(new Surface(m_diffuse_texture,
                                  m_displacement_texture,
-                                 rect,
+                                 Rect(m_region.left + rect.left, m_region.top + rect.top, rect.get_size()),
                                  m_flip));
   return surface;
 }
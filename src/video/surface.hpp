@@ -36,6 +36,9 @@ class Surface final
 public:
   static SurfacePtr from_texture(const TexturePtr& texture);
   static SurfacePtr from_file(const std::string& filename, const std::optional<Rect>& rect = std::nullopt);
+  /** Like from_file(), but small images get packed into a shared
+      texture atlas, used for tiles and sprite frames */
+  static SurfacePtr from_file_packed(const std::string& filename, const std::optional<Rect>& rect = std::nullopt);
   static SurfacePtr from_reader(const ReaderMapping& mapping, const std::optional<Rect>& rect = std::nullopt, const std::string& filename = "");
 
 private:
@@ -45,6 +48,7 @@ private:
 public:
   ~Surface();
 
+  /** Returns the part @c rect of this surface, relative to its region */
   SurfacePtr region(const Rect& rect) const;
   SurfacePtr clone(Flip flip = NO_FLIP) const;
 
@@ -39,6 +39,7 @@ public:
   inline std::vector<float> move_angles() { return std::move(m_angles); }
 
   inline Color get_color() const { return m_color; }
+  inline bool empty() const { return m_dstrects.empty(); }
 
 private:
   SurfacePtr m_surface;
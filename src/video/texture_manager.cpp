@@ -28,6 +28,7 @@
 #include "util/log.hpp"
 #include "util/reader_document.hpp"
 #include "util/reader_mapping.hpp"
+#include "util/thread_pool.hpp"
 #include "video/color.hpp"
 #include "video/gl.hpp"
 #include "video/sampler.hpp"
@@ -75,6 +76,15 @@ GLenum string2filter(const std::string& text)
   }
 }
 
+// Size of the atlas textures, and the largest image that gets packed
+// into them.
+const int ATLAS_PAGE_SIZE = 2048;
+const int MAX_PACKED_IMAGE_SIZE = 256;
+
+// Packed images get surrounded by a copy of their border pixels, so
+// that linear filtering doesn't pick up their neighbours.
+const int ATLAS_PADDING = 1;
+
 SDLSurfacePtr create_image_surface(const std::string& filename)
 {
   if (PHYSFS_exists(filename.c_str()))
@@ -93,7 +103,10 @@ const std::string TextureManager::s_dummy_texture = "images/engine/missing.png";
 TextureManager::TextureManager() :
   m_image_textures(),
   m_surfaces(),
-  m_load_successful(false)
+  m_load_successful(false),
+  m_atlas_pages(),
+  m_atlas_entries(),
+  m_prefetched()
 {
 }
 
@@ -108,6 +121,9 @@ TextureManager::~TextureManager()
   }
   m_image_textures.clear();
   m_surfaces.clear();
+  m_prefetched.clear();
+  m_atlas_entries.clear();
+  m_atlas_pages.clear();
 }
 
 TexturePtr
@@ -247,6 +263,212 @@ TextureManager::get(const std::string& _filename,
   return texture;
 }
 
+std::tuple<TexturePtr, Rect>
+TextureManager::get_packed(const std::string& _filename, const std::optional<Rect>& rect)
+{
+  std::string filename = FileSystem::normalize(_filename);
+  Texture::Key key(filename, rect ? *rect : Rect(0, 0, 0, 0));
+
+  auto it = m_atlas_entries.find(key);
+  if (it != m_atlas_entries.end())
+  {
+    m_load_successful = true;
+    return { m_atlas_pages[it->second.page].texture, it->second.rect };
+  }
+
+  // Images that didn't fit before are already loaded on their own.
+  auto texture_it = m_image_textures.find(key);
+  if (texture_it != m_image_textures.end())
+  {
+    if (TexturePtr texture = texture_it->second.lock())
+    {
+      m_load_successful = true;
+      return { texture, Rect(0, 0, texture->get_image_width(), texture->get_image_height()) };
+    }
+  }
+
+  // Only images that could fit are loaded here, everything else goes
+  // the usual way.
+  if (!rect || (rect->get_width() <= MAX_PACKED_IMAGE_SIZE && rect->get_height() <= MAX_PACKED_IMAGE_SIZE))
+  {
+    try
+    {
+      const SDLSurfacePtr image = rect ?
+        create_image_surface_raw(filename, *rect, Sampler()) :
+        load_image_surface(filename);
+
+      AtlasEntry entry{0, Rect()};
+      if (pack_image(*image, entry.page, entry.rect))
+      {
+        m_load_successful = true;
+        m_atlas_entries[key] = entry;
+        return { m_atlas_pages[entry.page].texture, entry.rect };
+      }
+
+      // A whole image only turns out to be too large once it is
+      // decoded, upload it as it is instead of decoding it again.
+      if (!rect)
+      {
+        TexturePtr texture = VideoSystem::current()->new_texture(*image, Sampler());
+        texture->m_cache_key = key;
+        m_image_textures[key] = texture;
+        m_load_successful = true;
+        return { texture, Rect(0, 0, texture->get_image_width(), texture->get_image_height()) };
+      }
+    }
+    catch (const std::exception& err)
+    {
+      log_debug << "Couldn't pack texture '" << filename << "': " << err.what() << std::endl;
+    }
+  }
+
+  TexturePtr texture = rect ? get(filename, *rect) : get(filename);
+  return { texture, Rect(0, 0, texture->get_image_width(), texture->get_image_height()) };
+}
+
+bool
+TextureManager::pack_image(const SDL_Surface& image, size_t& page_index, Rect& rect)
+{
+  if (image.w > MAX_PACKED_IMAGE_SIZE || image.h > MAX_PACKED_IMAGE_SIZE)
+    return false;
+
+  const Size padded_size(image.w + 2 * ATLAS_PADDING, image.h + 2 * ATLAS_PADDING);
+
+  std::optional<Rect> padded_rect;
+  for (page_index = 0; page_index < m_atlas_pages.size(); ++page_index)
+  {
+    AtlasPage& page = m_atlas_pages[page_index];
+    if (page.full)
+      continue;
+
+    padded_rect = page.packer->insert(padded_size);
+    if (padded_rect)
+      break;
+
+    // Once an image doesn't fit, the page takes no more, so that its
+    // pixels don't have to be kept around after the upload.
+    page.full = true;
+  }
+
+  if (!padded_rect)
+  {
+    SDLSurfacePtr surface = SDLSurface::create_rgba(ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE);
+    TexturePtr texture = VideoSystem::current()->new_texture(*surface);
+    m_atlas_pages.push_back(AtlasPage{std::move(surface), std::move(texture),
+                                      std::make_unique<TexturePacker>(Size(ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE)),
+                                      0, true, false});
+
+    page_index = m_atlas_pages.size() - 1;
+    padded_rect = m_atlas_pages[page_index].packer->insert(padded_size);
+    if (!padded_rect)
+      return false;
+  }
+
+  rect = Rect(padded_rect->left + ATLAS_PADDING, padded_rect->top + ATLAS_PADDING, Size(image.w, image.h));
+  copy_to_page(image, page_index, rect);
+  m_atlas_pages[page_index].image_count += 1;
+  return true;
+}
+
+void
+TextureManager::copy_to_page(const SDL_Surface& image, size_t page_index, const Rect& rect)
+{
+  AtlasPage& page = m_atlas_pages[page_index];
+  SDL_Surface* src = const_cast<SDL_Surface*>(&image);
+
+  SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+
+  // Copies a part of the image to the given position of the page.
+  auto blit = [&](const Rect& srcrect, int x, int y) {
+    SDL_Rect sdl_srcrect = srcrect.to_sdl();
+    SDL_Rect sdl_dstrect = Rect(x, y, srcrect.get_size()).to_sdl();
+    SDL_BlitSurface(src, &sdl_srcrect, page.surface.get(), &sdl_dstrect);
+  };
+
+  const int w = image.w;
+  const int h = image.h;
+  blit(Rect(0, 0, w, h), rect.left, rect.top);
+
+  // Extend the border pixels into the padding.
+  for (int i = 1; i <= ATLAS_PADDING; ++i)
+  {
+    blit(Rect(0, 0, w, 1), rect.left, rect.top - i);
+    blit(Rect(0, h - 1, w, h), rect.left, rect.bottom - 1 + i);
+    blit(Rect(0, 0, 1, h), rect.left - i, rect.top);
+    blit(Rect(w - 1, 0, w, h), rect.right - 1 + i, rect.top);
+
+    for (int j = 1; j <= ATLAS_PADDING; ++j)
+    {
+      blit(Rect(0, 0, 1, 1), rect.left - i, rect.top - j);
+      blit(Rect(w - 1, 0, w, 1), rect.right - 1 + i, rect.top - j);
+      blit(Rect(0, h - 1, 1, h), rect.left - i, rect.bottom - 1 + j);
+      blit(Rect(w - 1, h - 1, w, h), rect.right - 1 + i, rect.bottom - 1 + j);
+    }
+  }
+
+  page.dirty = true;
+}
+
+void
+TextureManager::flush_atlas()
+{
+  reap_atlas_pages();
+
+  for (auto& page : m_atlas_pages)
+  {
+    if (page.dirty)
+    {
+      page.texture->reload(*page.surface);
+      page.dirty = false;
+    }
+
+    // Full pages don't change anymore, reload() recreates their pixels
+    // from the image files.
+    if (page.full)
+      page.surface.reset(nullptr);
+  }
+}
+
+void
+TextureManager::reap_atlas_pages()
+{
+  // Surfaces hold the page texture of their image, so a page that only
+  // the manager holds has no image in use anymore.
+  const size_t reaped = m_atlas_pages.size();
+  std::vector<size_t> new_index(m_atlas_pages.size(), reaped);
+  size_t count = 0;
+  for (size_t i = 0; i < m_atlas_pages.size(); ++i)
+  {
+    if (m_atlas_pages[i].texture.use_count() > 1)
+    {
+      if (count != i)
+        m_atlas_pages[count] = std::move(m_atlas_pages[i]);
+      new_index[i] = count;
+      count += 1;
+    }
+  }
+
+  if (count == m_atlas_pages.size())
+    return;
+
+  log_debug << "Freeing " << m_atlas_pages.size() - count << " unused atlas pages" << std::endl;
+  m_atlas_pages.erase(m_atlas_pages.begin() + count, m_atlas_pages.end());
+
+  for (auto it = m_atlas_entries.begin(); it != m_atlas_entries.end();)
+  {
+    const size_t page = new_index[it->second.page];
+    if (page == reaped)
+    {
+      it = m_atlas_entries.erase(it);
+    }
+    else
+    {
+      it->second.page = page;
+      ++it;
+    }
+  }
+}
+
 void
 TextureManager::reap_cache_entry(const Texture::Key& key)
 {
@@ -288,10 +510,91 @@ TextureManager::get_surface(const std::string& filename)
     return *i->second;
   }
 
-  SDLSurfacePtr surface = create_image_surface(filename);
+  SDLSurfacePtr surface = load_image_surface(filename);
   return *(m_surfaces[filename] = std::move(surface));
 }
 
+SDLSurfacePtr
+TextureManager::load_image_surface(const std::string& filename)
+{
+  auto it = m_prefetched.find(filename);
+  if (it != m_prefetched.end())
+  {
+    SDLSurfacePtr surface = it->second.get();
+    m_prefetched.erase(it);
+    if (surface.get())
+      return surface;
+    // Failed prefetches are loaded again to get the usual warnings
+    // and fallbacks.
+  }
+
+  return create_image_surface(filename);
+}
+
+SDLSurfacePtr
+TextureManager::decode_image(const std::string& filename)
+{
+  if (!PHYSFS_exists(filename.c_str()))
+    return SDLSurfacePtr();
+
+  try
+  {
+    return SDLSurfacePtr(IMG_Load_RW(get_physfs_SDLRWops(filename), 1));
+  }
+  catch (const std::exception&)
+  {
+    return SDLSurfacePtr();
+  }
+}
+
+void
+TextureManager::prefetch(const std::string& _filename)
+{
+  ThreadPool* thread_pool = ThreadPool::current();
+  if (!thread_pool)
+    return;
+
+  std::string filename = FileSystem::normalize(_filename);
+  if (m_prefetched.find(filename) != m_prefetched.end() || is_image_cached(filename))
+    return;
+
+  m_prefetched[filename] = thread_pool->schedule([filename]{ return decode_image(filename); });
+}
+
+void
+TextureManager::prefetch(const std::string& _filename, std::future<SDLSurfacePtr> surface)
+{
+  std::string filename = FileSystem::normalize(_filename);
+  if (m_prefetched.find(filename) != m_prefetched.end() || is_image_cached(filename))
+    return;
+
+  m_prefetched[filename] = std::move(surface);
+}
+
+void
+TextureManager::drop_prefetched()
+{
+  if (!m_prefetched.empty())
+    log_debug << "Dropping " << m_prefetched.size() << " unused prefetched images" << std::endl;
+  m_prefetched.clear();
+}
+
+bool
+TextureManager::is_image_cached(const std::string& filename) const
+{
+  // Subregions are cut from m_surfaces, whole images are only kept as
+  // textures, either on their own or packed into an atlas.
+  if (m_surfaces.find(filename) != m_surfaces.end())
+    return true;
+
+  const Texture::Key key(filename, Rect(0, 0, 0, 0));
+  if (m_atlas_entries.find(key) != m_atlas_entries.end())
+    return true;
+
+  auto it = m_image_textures.find(key);
+  return it != m_image_textures.end() && !it->second.expired();
+}
+
 SDLSurfacePtr
 TextureManager::create_image_surface_raw(const std::string& filename, const Rect& rect, const Sampler& sampler)
 {
@@ -361,7 +664,7 @@ TextureManager::create_image_texture(const std::string& filename, const Sampler&
   m_load_successful = true;
   try
   {
-    SDLSurfacePtr surface = create_image_surface(filename);
+    SDLSurfacePtr surface = load_image_surface(filename);
     return VideoSystem::current()->new_texture(*surface, sampler);
   }
   catch (const std::exception& err)
@@ -408,6 +711,9 @@ TextureManager::create_dummy_texture() const
 void
 TextureManager::reload()
 {
+  // Prefetched images may be outdated by now
+  m_prefetched.clear();
+
   // Reload surfaces
   for (auto& surface : m_surfaces)
   {
@@ -457,6 +763,42 @@ TextureManager::reload()
 
     texture_ptr->reload(*surface);
   }
+
+  // Full pages have dropped their pixels, they get drawn again from
+  // the images.
+  for (auto& page : m_atlas_pages)
+  {
+    if (!page.surface.get())
+      page.surface = SDLSurface::create_rgba(ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE);
+  }
+
+  // Reload packed images into the place they already have
+  for (const auto& it : m_atlas_entries)
+  {
+    const std::string& filename = std::get<0>(it.first);
+    const Rect& rect = std::get<1>(it.first);
+    const AtlasEntry& entry = it.second;
+
+    try
+    {
+      const SDLSurfacePtr image = rect.empty() ?
+        create_image_surface(filename) :
+        create_image_surface_raw(filename, rect, Sampler());
+
+      if (image->w != entry.rect.get_width() || image->h != entry.rect.get_height())
+      {
+        log_warning << "Packed texture '" << filename << "' changed its size, not reloading it" << std::endl;
+        continue;
+      }
+
+      copy_to_page(*image, entry.page, entry.rect);
+    }
+    catch (const std::exception& err)
+    {
+      log_warning << "Couldn't reload packed texture '" << filename << "': " << err.what() << std::endl;
+    }
+  }
+  flush_atlas();
 }
 
 void
@@ -495,4 +837,18 @@ TextureManager::debug_print(std::ostream& out) const
 
   out << "total surface count:" << m_surfaces.size() << std::endl;
   out << "total surface pixels:" << total_surface_pixels << std::endl;
+
+  out << "atlas:begin" << std::endl;
+  for (size_t i = 0; i < m_atlas_pages.size(); ++i)
+  {
+    const AtlasPage& page = m_atlas_pages[i];
+    out << "  page " << i << " "
+        << page.packer->get_size().width << "x" << page.packer->get_size().height
+        << " images:" << page.image_count
+        << " occupancy:" << static_cast<int>(page.packer->get_occupancy() * 100.0f) << "%" << std::endl;
+  }
+  out << "atlas:end" << std::endl;
+
+  out << "total atlas page count:" << m_atlas_pages.size() << std::endl;
+  out << "total packed image count:" << m_atlas_entries.size() << std::endl;
 }
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <config.h>
+#include <future>
 #include <unordered_map>
 #include <map>
 #include <memory>
@@ -31,6 +32,7 @@
 #include "video/sampler.hpp"
 #include "video/sdl_surface_ptr.hpp"
 #include "video/texture.hpp"
+#include "video/texture_packer.hpp"
 #include "video/texture_ptr.hpp"
 
 class GLTexture;
@@ -55,13 +57,48 @@ public:
                  const Sampler& sampler = Sampler());
   TexturePtr create_dummy_texture() const;
 
+  /** Like get(), but small images get packed into a shared atlas
+      texture, so that many of them can be drawn with a single draw
+      call. Returns the texture together with the region of it that
+      holds the image. */
+  std::tuple<TexturePtr, Rect> get_packed(const std::string& filename,
+                                          const std::optional<Rect>& rect = std::nullopt);
+
+  /** Uploads the atlas textures that got new images since the last
+      call, needs to be called before drawing. Frees the pages that
+      no surface uses anymore. */
+  void flush_atlas();
+
+  /** Starts decoding @c filename on the ThreadPool, so that loading
+      it later only waits for the decode and uploads the result. */
+  void prefetch(const std::string& filename);
+
+  /** Like prefetch(), for an image that is already being decoded */
+  void prefetch(const std::string& filename, std::future<SDLSurfacePtr> surface);
+
+  /** Forgets the prefetched images that nothing has loaded, so that
+      their decoded pixels don't stay around */
+  void drop_prefetched();
+
   void reload();
 
   void debug_print(std::ostream& out) const;
 
   inline bool last_load_successful() const { return m_load_successful; }
 
+  /** Loads @c filename without touching the manager or the log, so
+      that it can run on any thread. Returns an empty surface if the
+      image can't be loaded. */
+  static SDLSurfacePtr decode_image(const std::string& filename);
+
 private:
+  /** Takes the prefetched image for @c filename, or loads it now */
+  SDLSurfacePtr load_image_surface(const std::string& filename);
+
+  /** Whether loading the whole image @c filename again would take it
+      from a cache instead of decoding it */
+  bool is_image_cached(const std::string& filename) const;
+
   const SDL_Surface& get_surface(const std::string& filename);
   void reap_cache_entry(const Texture::Key& key);
 
@@ -75,11 +112,45 @@ private:
 
   static SDLSurfacePtr create_dummy_surface();
 
+  /** Copies @c image into an atlas page, returns false if it is too
+      large or all pages are full. */
+  bool pack_image(const SDL_Surface& image, size_t& page_index, Rect& rect);
+  void copy_to_page(const SDL_Surface& image, size_t page_index, const Rect& rect);
+
+  /** Removes the pages whose images are all unused, and their entries */
+  void reap_atlas_pages();
+
+private:
+  struct AtlasPage
+  {
+    SDLSurfacePtr surface;
+    TexturePtr texture;
+    std::unique_ptr<TexturePacker> packer;
+    int image_count;
+    bool dirty;
+
+    /** No more images go into the page, its surface is dropped once
+        it has been uploaded */
+    bool full;
+  };
+
+  struct AtlasEntry
+  {
+    size_t page;
+    Rect rect;
+  };
+
 private:
   std::map<Texture::Key, std::weak_ptr<Texture>> m_image_textures;
   std::unordered_map<std::string, SDLSurfacePtr> m_surfaces;
   bool m_load_successful;
 
+  std::vector<AtlasPage> m_atlas_pages;
+  std::map<Texture::Key, AtlasEntry> m_atlas_entries;
+
+  /** Images that are decoded in the background and not loaded yet */
+  std::unordered_map<std::string, std::future<SDLSurfacePtr>> m_prefetched;
+
 private:
   TextureManager(const TextureManager&) = delete;
   TextureManager& operator=(const TextureManager&) = delete;
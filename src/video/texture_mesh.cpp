@@ -0,0 +1,39 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "video/texture_mesh.hpp"
+
+#include <assert.h>
+#include <atomic>
+
+namespace {
+
+std::atomic<uint64_t> s_next_id(1);
+
+} // namespace
+
+TextureMesh::TextureMesh(const TexturePtr& texture, const TexturePtr& displacement_texture, Flip flip,
+                         std::vector<Rectf> srcrects, std::vector<Rectf> dstrects) :
+  m_id(s_next_id++),
+  m_texture(texture),
+  m_displacement_texture(displacement_texture),
+  m_flip(flip),
+  m_srcrects(std::move(srcrects)),
+  m_dstrects(std::move(dstrects))
+{
+  assert(m_srcrects.size() == m_dstrects.size());
+}
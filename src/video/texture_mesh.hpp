@@ -0,0 +1,64 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+#include "math/rectf.hpp"
+#include "video/flip.hpp"
+#include "video/texture_ptr.hpp"
+
+/**
+ * Textured quads that don't change over many frames, like a chunk of a
+ * TileMap. Renderers may keep the geometry in GPU memory for as long as
+ * the mesh exists, so a mesh can't be modified after construction,
+ * changed geometry needs a new mesh.
+ *
+ * Destination rectangles are relative to the position the mesh gets
+ * drawn at and aren't scaled yet.
+ */
+class TextureMesh final
+{
+public:
+  TextureMesh(const TexturePtr& texture, const TexturePtr& displacement_texture, Flip flip,
+              std::vector<Rectf> srcrects, std::vector<Rectf> dstrects);
+
+  /** Unique for every mesh created, used by renderers to identify their
+      cached copy of the geometry. */
+  inline uint64_t get_id() const { return m_id; }
+
+  inline const TexturePtr& get_texture() const { return m_texture; }
+  inline const TexturePtr& get_displacement_texture() const { return m_displacement_texture; }
+  inline Flip get_flip() const { return m_flip; }
+
+  inline const std::vector<Rectf>& get_srcrects() const { return m_srcrects; }
+  inline const std::vector<Rectf>& get_dstrects() const { return m_dstrects; }
+
+private:
+  uint64_t m_id;
+  TexturePtr m_texture;
+  TexturePtr m_displacement_texture;
+  Flip m_flip;
+  std::vector<Rectf> m_srcrects;
+  std::vector<Rectf> m_dstrects;
+
+private:
+  TextureMesh(const TextureMesh&) = delete;
+  TextureMesh& operator=(const TextureMesh&) = delete;
+};
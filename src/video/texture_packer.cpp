@@ -0,0 +1,134 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "video/texture_packer.hpp"
+
+#include <limits>
+
+TexturePacker::TexturePacker(const Size& size) :
+  m_size(size),
+  m_skyline(),
+  m_used_area(0)
+{
+  m_skyline.push_back(Segment{0, 0, size.width});
+}
+
+int
+TexturePacker::fit(size_t index, int width, int height) const
+{
+  const int x = m_skyline[index].x;
+  if (x + width > m_size.width)
+    return -1;
+
+  // The rectangle rests on the highest segment below it.
+  int y = 0;
+  int remaining = width;
+  for (size_t i = index; remaining > 0; ++i)
+  {
+    if (i >= m_skyline.size())
+      return -1;
+
+    y = std::max(y, m_skyline[i].y);
+    if (y + height > m_size.height)
+      return -1;
+
+    remaining -= m_skyline[i].width;
+  }
+  return y;
+}
+
+std::optional<Rect>
+TexturePacker::insert(const Size& size)
+{
+  if (size.width <= 0 || size.height <= 0)
+    return std::nullopt;
+
+  size_t best_index = 0;
+  int best_bottom = std::numeric_limits<int>::max();
+  int best_width = std::numeric_limits<int>::max();
+  int best_y = -1;
+
+  for (size_t i = 0; i < m_skyline.size(); ++i)
+  {
+    const int y = fit(i, size.width, size.height);
+    if (y < 0)
+      continue;
+
+    // Prefer the lowest position, then the narrowest segment to keep
+    // wide gaps free for wide rectangles.
+    const int bottom = y + size.height;
+    if (bottom < best_bottom || (bottom == best_bottom && m_skyline[i].width < best_width))
+    {
+      best_index = i;
+      best_bottom = bottom;
+      best_width = m_skyline[i].width;
+      best_y = y;
+    }
+  }
+
+  if (best_y < 0)
+    return std::nullopt;
+
+  const Rect rect(m_skyline[best_index].x, best_y, Size(size.width, size.height));
+
+  // Add the top of the new rectangle to the skyline and cut it out of
+  // the segments it covers.
+  m_skyline.insert(m_skyline.begin() + best_index, Segment{rect.left, rect.bottom, size.width});
+
+  for (size_t i = best_index + 1; i < m_skyline.size();)
+  {
+    Segment& segment = m_skyline[i];
+    if (segment.x >= rect.right)
+      break;
+
+    const int shrink = rect.right - segment.x;
+    if (shrink >= segment.width)
+    {
+      m_skyline.erase(m_skyline.begin() + i);
+    }
+    else
+    {
+      segment.x += shrink;
+      segment.width -= shrink;
+      break;
+    }
+  }
+
+  // Merge neighbouring segments of the same height.
+  for (size_t i = 0; i + 1 < m_skyline.size();)
+  {
+    if (m_skyline[i].y == m_skyline[i + 1].y)
+    {
+      m_skyline[i].width += m_skyline[i + 1].width;
+      m_skyline.erase(m_skyline.begin() + i + 1);
+    }
+    else
+    {
+      ++i;
+    }
+  }
+
+  m_used_area += size.width * size.height;
+  return rect;
+}
+
+float
+TexturePacker::get_occupancy() const
+{
+  const int area = m_size.width * m_size.height;
+  return area > 0 ? static_cast<float>(m_used_area) / static_cast<float>(area) : 0.0f;
+}
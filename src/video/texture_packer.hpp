@@ -0,0 +1,72 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include "math/rect.hpp"
+#include "math/size.hpp"
+
+/**
+ * Places rectangles into a fixed size area using the skyline
+ * bottom-left heuristic, used to build texture atlases.
+ *
+ * The skyline is the upper outline of everything placed so far, new
+ * rectangles are put on top of it at the position where their bottom
+ * edge ends up lowest.
+ */
+class TexturePacker final
+{
+private:
+  struct Segment
+  {
+    int x;
+    int y;
+    int width;
+  };
+
+public:
+  TexturePacker(const Size& size);
+
+  /** Returns the place for a rectangle of @c size, or nothing if it
+      doesn't fit anymore. */
+  std::optional<Rect> insert(const Size& size);
+
+  inline const Size& get_size() const { return m_size; }
+
+  /** Area of all inserted rectangles */
+  inline int get_used_area() const { return m_used_area; }
+
+  /** Fraction of the area used by inserted rectangles */
+  float get_occupancy() const;
+
+private:
+  /** Returns the y position for a rectangle of @c width placed at the
+      start of segment @c index, or -1 if it doesn't fit there. */
+  int fit(size_t index, int width, int height) const;
+
+private:
+  Size m_size;
+  std::vector<Segment> m_skyline;
+  int m_used_area;
+
+private:
+  TexturePacker(const TexturePacker&) = delete;
+  TexturePacker& operator=(const TexturePacker&) = delete;
+};
@@ -24,11 +24,73 @@
 #include "util/line_iterator.hpp"
 #include "physfs/physfs_sdl.hpp"
 #include "util/log.hpp"
+#include "util/utf8_iterator.hpp"
 #include "video/canvas.hpp"
 #include "video/surface.hpp"
 #include "video/ttf_surface_manager.hpp"
 
+namespace {
+
+/** Characters that look the same wherever they are, so they can be
+    drawn one by one. Strings with others, like those of scripts that
+    need shaping, are rendered as a whole by SDL_ttf. */
+bool is_simple_character(uint32_t chr)
+{
+  return (chr >= 0x20 && chr < 0x300) ||   // Latin
+         (chr >= 0x370 && chr < 0x590) ||  // Greek, Cyrillic and Armenian
+         (chr >= 0x2010 && chr < 0x2028);  // Dashes, quotes and ellipsis
+}
+
+struct PlacedGlyph
+{
+  const TTFGlyph* glyph;
+  Vector pos;
+};
+
+/** Appends the glyphs of @c line to @c glyphs, positioned relative to
+    the start of the line like SDL_ttf would render it. Returns false
+    and appends nothing if a character can't be drawn on its own. */
+bool layout_line(const TTFFont& font, TTFGlyphAtlas& atlas, const std::string& line,
+                 std::vector<PlacedGlyph>& glyphs)
+{
+  const size_t begin = glyphs.size();
+
+  int pen = 0;
+  int left = 0;
+  uint32_t previous = 0;
+  for (UTF8Iterator it(line); !it.done(); ++it)
+  {
+    const uint32_t chr = *it;
+    const TTFGlyph* glyph = is_simple_character(chr) ? atlas.get(font, chr) : nullptr;
+    if (!glyph)
+    {
+      glyphs.resize(begin);
+      return false;
+    }
+
+    if (previous)
+      pen += TTF_GetFontKerningSizeGlyphs32(font.get_ttf_font(), previous, chr);
+
+    left = std::min(left, pen + glyph->min_x);
+    glyphs.push_back({ glyph, Vector(static_cast<float>(pen + glyph->offset), 0.0f) });
+
+    pen += glyph->advance;
+    previous = chr;
+  }
+
+  // SDL_ttf starts the string at its leftmost pixel.
+  for (size_t i = begin; i < glyphs.size(); ++i)
+    glyphs[i].pos.x -= static_cast<float>(left);
+
+  return true;
+}
+
+} // namespace
+
+uint64_t TTFFont::s_next_id = 0;
+
 TTFFont::TTFFont(const std::string& filename, int font_size, float line_spacing, int shadow_size, int border) :
+  m_id(s_next_id++),
   m_font(),
   m_filename(filename),
   m_font_size(font_size),
@@ -47,6 +109,9 @@ TTFFont::TTFFont(const std::string& filename, int font_size, float line_spacing,
 
 TTFFont::~TTFFont()
 {
+  if (auto* surface_manager = TTFSurfaceManager::current())
+    surface_manager->get_glyph_atlas().remove_font(*this);
+
   TTF_CloseFont(m_font);
 }
 
@@ -109,6 +174,10 @@ TTFFont::draw_text(Canvas& canvas, const std::string& text,
   float last_y = init_y;
   float max_width = 0.f;
 
+  TTFSurfaceManager& surface_manager = *TTFSurfaceManager::current();
+  TTFGlyphAtlas& atlas = surface_manager.get_glyph_atlas();
+  std::vector<PlacedGlyph> glyphs;
+
   LineIterator iter(text);
   while (iter.next())
   {
@@ -116,8 +185,19 @@ TTFFont::draw_text(Canvas& canvas, const std::string& text,
 
     if (!line.empty())
     {
-      TTFSurfacePtr ttf_surface = TTFSurfaceManager::current()->create_surface(*this, line);
-      const float width = static_cast<float>(ttf_surface->get_width());
+      const size_t line_begin = glyphs.size();
+
+      TTFSurfacePtr ttf_surface;
+      float width;
+      if (layout_line(*this, atlas, line, glyphs))
+      {
+        width = get_text_width(line);
+      }
+      else
+      {
+        ttf_surface = surface_manager.create_surface(*this, line);
+        width = static_cast<float>(ttf_surface->get_width());
+      }
 
       Vector new_pos(pos.x, last_y);
 
@@ -133,13 +213,50 @@ TTFFont::draw_text(Canvas& canvas, const std::string& text,
       if (width > max_width)
         max_width = width;
 
-      // Draw text surface
-      canvas.draw_surface(ttf_surface->get_surface(), new_pos, 0.0f, color, Blend(), layer);
+      if (ttf_surface)
+      {
+        // Draw text surface
+        canvas.draw_surface(ttf_surface->get_surface(), new_pos, 0.0f, color, Blend(), layer);
+      }
+      else
+      {
+        for (size_t i = line_begin; i < glyphs.size(); ++i)
+          glyphs[i].pos += new_pos;
+      }
     }
 
     last_y += get_height();
   }
 
+  // All glyphs of a page go into one batch, with the decorations first,
+  // so that they end up below the characters like in TTFSurface.
+  size_t page_count = 0;
+  for (const auto& placed : glyphs)
+    page_count = std::max(page_count, placed.glyph->page + 1);
+
+  for (size_t page = 0; page < page_count; ++page)
+  {
+    std::vector<Rectf> srcrects;
+    std::vector<Rectf> dstrects;
+
+    for (const bool decoration : { true, false })
+    {
+      for (const auto& placed : glyphs)
+      {
+        const Rect& rect = decoration ? placed.glyph->decoration : placed.glyph->core;
+        if (placed.glyph->page != page || rect.empty())
+          continue;
+
+        srcrects.emplace_back(rect);
+        dstrects.emplace_back(placed.pos, Sizef(static_cast<float>(rect.get_width()),
+                                                static_cast<float>(rect.get_height())));
+      }
+    }
+
+    if (!srcrects.empty())
+      canvas.draw_surface_batch(atlas.get_page(page), std::move(srcrects), std::move(dstrects), color, layer);
+  }
+
   return Rectf(min_x, init_y, min_x + max_width, last_y);
 }
 
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <SDL_ttf.h>
+#include <stdint.h>
 
 #include "math/fwd.hpp"
 #include "video/color.hpp"
@@ -53,7 +54,14 @@ public:
 
   inline TTF_Font* get_ttf_font() const { return m_font; }
 
+  /** Number that no other TTFFont of this run has */
+  inline uint64_t get_id() const { return m_id; }
+
+private:
+  static uint64_t s_next_id;
+
 private:
+  uint64_t m_id;
   TTF_Font* m_font;
   std::string m_filename;
   int m_font_size;
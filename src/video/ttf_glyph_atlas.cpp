@@ -0,0 +1,261 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "video/ttf_glyph_atlas.hpp"
+
+#include <SDL_ttf.h>
+
+#include <algorithm>
+#include <string>
+
+#include "util/log.hpp"
+#include "video/sdl_surface.hpp"
+#include "video/surface.hpp"
+#include "video/texture.hpp"
+#include "video/ttf_font.hpp"
+#include "video/ttf_surface.hpp"
+#include "video/video_system.hpp"
+
+namespace {
+
+const int GLYPH_PAGE_SIZE = 512;
+const size_t MAX_GLYPH_PAGES = 8;
+
+// Transparent space around every image, so that linear filtering
+// doesn't pick up the neighbours.
+const int GLYPH_PADDING = 1;
+
+std::string encode_utf8(uint32_t codepoint)
+{
+  std::string result;
+  if (codepoint < 0x80)
+  {
+    result += static_cast<char>(codepoint);
+  }
+  else if (codepoint < 0x800)
+  {
+    result += static_cast<char>(0xc0 | (codepoint >> 6));
+    result += static_cast<char>(0x80 | (codepoint & 0x3f));
+  }
+  else if (codepoint < 0x10000)
+  {
+    result += static_cast<char>(0xe0 | (codepoint >> 12));
+    result += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3f));
+    result += static_cast<char>(0x80 | (codepoint & 0x3f));
+  }
+  else
+  {
+    result += static_cast<char>(0xf0 | (codepoint >> 18));
+    result += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3f));
+    result += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3f));
+    result += static_cast<char>(0x80 | (codepoint & 0x3f));
+  }
+  return result;
+}
+
+} // namespace
+
+TTFGlyphAtlas::TTFGlyphAtlas() :
+  m_pages(),
+  m_glyphs(),
+  m_full(false)
+{
+}
+
+const TTFGlyph*
+TTFGlyphAtlas::get(const TTFFont& font, uint32_t codepoint)
+{
+  const Key key{ font.get_id(), codepoint };
+
+  auto it = m_glyphs.find(key);
+  if (it != m_glyphs.end())
+    return &it->second;
+
+  if (m_full)
+    return nullptr;
+
+  TTFGlyph glyph;
+  if (!add(font, codepoint, glyph))
+  {
+    m_full = true;
+    log_warning << "TTF glyph atlas is full, rendering new text as whole strings" << std::endl;
+    return nullptr;
+  }
+
+  return &m_glyphs.emplace(key, glyph).first->second;
+}
+
+bool
+TTFGlyphAtlas::add(const TTFFont& font, uint32_t codepoint, TTFGlyph& glyph)
+{
+  TTF_Font* ttf_font = font.get_ttf_font();
+
+  int min_x = 0;
+  int max_x = 0;
+  int min_y = 0;
+  int max_y = 0;
+  int advance = 0;
+  if (TTF_GlyphMetrics32(ttf_font, codepoint, &min_x, &max_x, &min_y, &max_y, &advance) < 0)
+  {
+    log_debug << "Couldn't get metrics of glyph " << codepoint << ": " << TTF_GetError() << std::endl;
+  }
+
+  // SDL_ttf moves a string right when its first character reaches left
+  // of the pen, so a rendered character starts at the smaller of both.
+  glyph = TTFGlyph{ 0, Rect(), Rect(), std::min(0, min_x), min_x, advance };
+
+  // Whitespace has nothing to draw.
+  if (max_x <= min_x)
+    return true;
+
+  SDLSurfacePtr text_surface(TTF_RenderUTF8_Blended(ttf_font, encode_utf8(codepoint).c_str(),
+                                                    SDL_Color{255, 255, 255, 255}));
+  if (!text_surface)
+  {
+    log_debug << "Couldn't render glyph " << codepoint << ": " << SDL_GetError() << std::endl;
+    return true;
+  }
+
+  SDLSurfacePtr decoration;
+  if (font.get_shadow_size() > 0 || font.get_border() > 0)
+    decoration = TTFSurface::create_decoration(font, *text_surface);
+
+  // Both images go next to each other, so that they share a page.
+  const int decoration_width = decoration ? decoration->w + 2 * GLYPH_PADDING : 0;
+  const int height = std::max(decoration ? decoration->h : 0, text_surface->h);
+
+  Rect rect;
+  if (!reserve(Size(decoration_width + text_surface->w, height), glyph.page, rect))
+    return false;
+
+  if (decoration)
+  {
+    glyph.decoration = Rect(rect.left, rect.top, Size(decoration->w, decoration->h));
+    copy_to_page(*decoration, glyph.page, glyph.decoration);
+  }
+
+  glyph.core = Rect(rect.left + decoration_width, rect.top, Size(text_surface->w, text_surface->h));
+  copy_to_page(*text_surface, glyph.page, glyph.core);
+  m_pages[glyph.page].glyph_count += 1;
+  return true;
+}
+
+void
+TTFGlyphAtlas::remove_font(const TTFFont& font)
+{
+  for (auto it = m_glyphs.begin(); it != m_glyphs.end(); )
+  {
+    if (it->first.font != font.get_id())
+    {
+      ++it;
+      continue;
+    }
+
+    // Whitespace takes no room on a page.
+    if (!it->second.core.empty())
+    {
+      const size_t page_index = it->second.page;
+      m_pages[page_index].glyph_count -= 1;
+      if (m_pages[page_index].glyph_count == 0)
+        reset_page(page_index);
+    }
+    it = m_glyphs.erase(it);
+  }
+}
+
+void
+TTFGlyphAtlas::reset_page(size_t page_index)
+{
+  Page& page = m_pages[page_index];
+  page.packer = std::make_unique<TexturePacker>(Size(GLYPH_PAGE_SIZE, GLYPH_PAGE_SIZE));
+  SDL_FillRect(page.surface.get(), nullptr, 0);
+  page.dirty = true;
+  m_full = false;
+}
+
+bool
+TTFGlyphAtlas::reserve(const Size& size, size_t& page_index, Rect& rect)
+{
+  const Size padded_size(size.width + 2 * GLYPH_PADDING, size.height + 2 * GLYPH_PADDING);
+
+  std::optional<Rect> padded_rect;
+  for (page_index = 0; page_index < m_pages.size(); ++page_index)
+  {
+    padded_rect = m_pages[page_index].packer->insert(padded_size);
+    if (padded_rect)
+      break;
+  }
+
+  if (!padded_rect)
+  {
+    if (m_pages.size() >= MAX_GLYPH_PAGES)
+      return false;
+
+    SDLSurfacePtr surface = SDLSurface::create_rgba(GLYPH_PAGE_SIZE, GLYPH_PAGE_SIZE);
+    SurfacePtr texture = Surface::from_texture(VideoSystem::current()->new_texture(*surface));
+    m_pages.push_back(Page{std::move(surface), std::move(texture),
+                           std::make_unique<TexturePacker>(Size(GLYPH_PAGE_SIZE, GLYPH_PAGE_SIZE)),
+                           0, true});
+
+    page_index = m_pages.size() - 1;
+    padded_rect = m_pages[page_index].packer->insert(padded_size);
+    if (!padded_rect)
+      return false;
+  }
+
+  rect = Rect(padded_rect->left + GLYPH_PADDING, padded_rect->top + GLYPH_PADDING, size);
+  return true;
+}
+
+void
+TTFGlyphAtlas::copy_to_page(SDL_Surface& image, size_t page_index, const Rect& rect)
+{
+  Page& page = m_pages[page_index];
+
+  // Copy the pixels as they are, the page is blended when drawn.
+  SDL_SetSurfaceAlphaMod(&image, 255);
+  SDL_SetSurfaceColorMod(&image, 255, 255, 255);
+  SDL_SetSurfaceBlendMode(&image, SDL_BLENDMODE_NONE);
+
+  SDL_Rect dstrect = rect.to_sdl();
+  SDL_BlitSurface(&image, nullptr, page.surface.get(), &dstrect);
+
+  page.dirty = true;
+}
+
+int
+TTFGlyphAtlas::flush()
+{
+  int uploads = 0;
+  for (auto& page : m_pages)
+  {
+    if (page.dirty)
+    {
+      page.texture->get_texture()->reload(*page.surface);
+      page.dirty = false;
+      uploads += 1;
+    }
+  }
+  return uploads;
+}
+
+void
+TTFGlyphAtlas::clear()
+{
+  m_pages.clear();
+  m_glyphs.clear();
+  m_full = false;
+}
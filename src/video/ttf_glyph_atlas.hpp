@@ -0,0 +1,139 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <memory>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+#include "math/rect.hpp"
+#include "math/size.hpp"
+#include "video/sdl_surface_ptr.hpp"
+#include "video/surface_ptr.hpp"
+#include "video/texture_packer.hpp"
+
+class TTFFont;
+struct SDL_Surface;
+
+/** Images and metrics of one character of a TTFFont */
+struct TTFGlyph
+{
+  /** Atlas page holding the images */
+  size_t page;
+
+  /** Shadow and border, empty for fonts without them */
+  Rect decoration;
+
+  /** The white character itself, drawn on top of the decoration at
+      the same position */
+  Rect core;
+
+  /** Distance from the pen position to the left edge of the images */
+  int offset;
+
+  /** Left edge of the character's pixels relative to the pen position */
+  int min_x;
+
+  int advance;
+};
+
+/**
+ * Rasterizes the characters of TTFFonts once and packs them into
+ * shared atlas textures, so that text made of them can be drawn as a
+ * single batch no matter how often it changes.
+ */
+class TTFGlyphAtlas final
+{
+public:
+  TTFGlyphAtlas();
+
+  /** Returns the glyph of @c codepoint, rasterizing it the first time,
+      or nullptr if the atlas is full. */
+  const TTFGlyph* get(const TTFFont& font, uint32_t codepoint);
+
+  /** Forgets the glyphs of @c font, pages left without glyphs are
+      emptied for new ones. */
+  void remove_font(const TTFFont& font);
+
+  inline const SurfacePtr& get_page(size_t page) const { return m_pages[page].texture; }
+
+  /** Uploads the pages that got new glyphs, returns how many */
+  int flush();
+
+  void clear();
+
+  inline size_t get_glyph_count() const { return m_glyphs.size(); }
+  inline size_t get_page_count() const { return m_pages.size(); }
+
+private:
+  /** Rasterizes @c codepoint into a page, returns false if all pages
+      are full. */
+  bool add(const TTFFont& font, uint32_t codepoint, TTFGlyph& glyph);
+
+  /** Finds room for an image of @c size, returns false if all pages
+      are full. */
+  bool reserve(const Size& size, size_t& page_index, Rect& rect);
+  void copy_to_page(SDL_Surface& image, size_t page_index, const Rect& rect);
+
+  /** Gives the whole area of the page back to the packer */
+  void reset_page(size_t page_index);
+
+private:
+  struct Page
+  {
+    SDLSurfacePtr surface;
+    SurfacePtr texture;
+    std::unique_ptr<TexturePacker> packer;
+
+    /** Number of glyphs with images on the page */
+    int glyph_count;
+
+    bool dirty;
+  };
+
+  struct Key
+  {
+    /** TTFFont::get_id(), font addresses get reused */
+    uint64_t font;
+    uint32_t codepoint;
+
+    bool operator==(const Key& other) const
+    {
+      return font == other.font && codepoint == other.codepoint;
+    }
+  };
+
+  struct KeyHash
+  {
+    size_t operator()(const Key& key) const
+    {
+      return std::hash<uint64_t>()(key.font) ^ (static_cast<size_t>(key.codepoint) * 0x9e3779b97f4a7c15ull);
+    }
+  };
+
+private:
+  std::vector<Page> m_pages;
+  std::unordered_map<Key, TTFGlyph, KeyHash> m_glyphs;
+
+  /** Set once all pages are full, new glyphs aren't rasterized anymore */
+  bool m_full;
+
+private:
+  TTFGlyphAtlas(const TTFGlyphAtlas&) = delete;
+  TTFGlyphAtlas& operator=(const TTFGlyphAtlas&) = delete;
+};
@@ -20,10 +20,12 @@
 #include <string>
 
 #include "math/vector.hpp"
+#include "video/sdl_surface_ptr.hpp"
 #include "video/surface_ptr.hpp"
 
 class TTFFont;
 class TTFSurface;
+struct SDL_Surface;
 
 typedef std::shared_ptr<TTFSurface> TTFSurfacePtr;
 
@@ -33,6 +35,10 @@ class TTFSurface final
 public:
   static TTFSurfacePtr create(const TTFFont& font, const std::string& text);
 
+  /** Returns the shadow and border of @c text_surface, without the text
+      itself, which goes on top at the same position. */
+  static SDLSurfacePtr create_decoration(const TTFFont& font, SDL_Surface& text_surface);
+
 public:
   TTFSurface(const SurfacePtr& surface, const Vector& offset);
 
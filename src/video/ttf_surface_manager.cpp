@@ -36,7 +36,12 @@ TTFSurfaceManager::CacheEntry::CacheEntry(const TTFSurfacePtr& s) :
 
 TTFSurfaceManager::TTFSurfaceManager() :
   m_cache(),
-  m_cache_iter(m_cache.end())
+  m_cache_iter(m_cache.end()),
+  m_glyph_atlas(),
+  m_flushed_glyph_count(0),
+  m_stats{ 0, 0 },
+  m_running_stats{ 0, 0 },
+  m_running_stats_start(std::chrono::steady_clock::now())
 {
 }
 
@@ -66,6 +71,7 @@ TTFSurfaceManager::create_surface(const TTFFont& font, const std::string& text)
 
     TTFSurfacePtr ttf_surface = TTFSurface::create(font, text);
     m_cache[key] = ttf_surface;
+    m_running_stats.texture_uploads += 1;
     return ttf_surface;
   }
 }
@@ -83,11 +89,34 @@ TTFSurfaceManager::get_cached_surface_width(const TTFFont& font,
   return entry.ttf_surface->get_width();
 }
 
+void
+TTFSurfaceManager::flush()
+{
+  const size_t glyph_count = m_glyph_atlas.get_glyph_count();
+  m_running_stats.glyph_fills += static_cast<int>(glyph_count - m_flushed_glyph_count);
+  m_flushed_glyph_count = glyph_count;
+
+  m_running_stats.texture_uploads += m_glyph_atlas.flush();
+
+  const auto now = std::chrono::steady_clock::now();
+  if (now - m_running_stats_start >= std::chrono::seconds(1))
+  {
+    m_stats = m_running_stats;
+    m_running_stats = { 0, 0 };
+    m_running_stats_start = now;
+  }
+}
+
 void
 TTFSurfaceManager::clear_cache()
 {
   m_cache.clear();
   m_cache_iter = m_cache.begin();
+
+  // Fonts are reloaded after this, so none of the glyphs are needed
+  // anymore.
+  m_glyph_atlas.clear();
+  m_flushed_glyph_count = 0;
 }
 
 void
@@ -120,4 +149,6 @@ TTFSurfaceManager::print_debug_info(std::ostream& out)
     return accumulator + entry.second.ttf_surface->get_width() * entry.second.ttf_surface->get_height() * 4;
   });
   out << "TTFSurfaceManager.cache_size: " << m_cache.size() << "  " << cache_bytes / 1000 << "KB" << std::endl;
+  out << "TTFSurfaceManager.glyphs: " << m_glyph_atlas.get_glyph_count()
+      << " in " << m_glyph_atlas.get_page_count() << " pages" << std::endl;
 }
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <tuple>
 #include <map>
 #include <string>
@@ -24,17 +25,35 @@
 #include "util/currenton.hpp"
 #include "video/color.hpp"
 #include "video/surface_ptr.hpp"
+#include "video/ttf_glyph_atlas.hpp"
 #include "video/ttf_surface.hpp"
 
 class TTFFont;
 
 class TTFSurfaceManager final : public Currenton<TTFSurfaceManager>
 {
+public:
+  /** Glyphs rasterized into the atlas and textures uploaded during the
+      last second, shown in the FPS overlay */
+  struct Stats
+  {
+    int glyph_fills;
+    int texture_uploads;
+  };
+
 public:
   TTFSurfaceManager();
 
   TTFSurfacePtr create_surface(const TTFFont& font, const std::string& text);
 
+  inline TTFGlyphAtlas& get_glyph_atlas() { return m_glyph_atlas; }
+
+  /** Uploads the glyphs added since the last call, needs to be called
+      before drawing. */
+  void flush();
+
+  inline const Stats& get_stats() const { return m_stats; }
+
   // Returns -1 if there is no cached text surface
   int get_cached_surface_width(const TTFFont& font, const std::string& text);
 
@@ -61,6 +80,14 @@ private:
 
   std::map<Key, CacheEntry>::iterator m_cache_iter;
 
+  TTFGlyphAtlas m_glyph_atlas;
+  size_t m_flushed_glyph_count;
+
+  /** m_stats is replaced by m_running_stats once a second */
+  Stats m_stats;
+  Stats m_running_stats;
+  std::chrono::steady_clock::time_point m_running_stats_start;
+
 private:
   TTFSurfaceManager(const TTFSurfaceManager&) = delete;
   TTFSurfaceManager& operator=(const TTFSurfaceManager&) = delete;
@@ -0,0 +1,118 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Despawns half of the objects of a real CollisionSystem in one frame.
+// Every tenth object is a platform carrying the next one, like coins or
+// enemies resting on blocks, so removal has listeners to notify. The time
+// per remove() should stay flat as the object count grows; when remove()
+// notified every remaining object, it grew with the object count.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "audio/sound_manager.hpp"
+#include "collision/collision_object.hpp"
+#include "collision/collision_system.hpp"
+#include "squirrel/squirrel_virtual_machine.hpp"
+#include "supertux/level.hpp"
+#include "supertux/moving_object.hpp"
+#include "supertux/sector.hpp"
+
+namespace {
+
+const size_t OBJECT_COUNTS[] = { 1000, 10000, 50000 };
+
+class BenchmarkObject final : public MovingObject
+{
+public:
+  BenchmarkObject(const Vector& pos, CollisionGroup group)
+  {
+    set_group(group);
+    m_col.set_pos(pos);
+    m_col.set_size(32.0f, 32.0f);
+  }
+
+  void update(float) override {}
+  void draw(DrawingContext&) override {}
+  HitResponse collision(MovingObject&, const CollisionHit&) override { return CONTINUE; }
+  int get_layer() const override { return 0; }
+};
+
+double to_ns(std::chrono::steady_clock::duration duration, size_t count)
+{
+  return std::chrono::duration<double, std::nano>(duration).count() / static_cast<double>(count);
+}
+
+void run(Sector& sector, size_t object_count)
+{
+  CollisionSystem collision_system(sector);
+
+  std::vector<std::unique_ptr<BenchmarkObject>> objects;
+  for (size_t i = 0; i < object_count; ++i)
+  {
+    const bool platform = (i % 10 == 0);
+    const Vector pos(static_cast<float>(i / 10) * 64.0f, platform ? 64.0f : 32.0f);
+    objects.push_back(std::make_unique<BenchmarkObject>(pos, platform ? COLGROUP_MOVING_STATIC
+                                                                      : COLGROUP_MOVING));
+  }
+
+  const auto add_start = std::chrono::steady_clock::now();
+  for (auto& object : objects)
+    collision_system.add(object->get_collision_object());
+  const auto add_end = std::chrono::steady_clock::now();
+
+  // Let the riders stand on their platforms, like the static constraint
+  // pass of CollisionSystem::update() does.
+  for (size_t i = 1; i < object_count; i += 10)
+    objects[i - 1]->get_collision_object()->collision_moving_object_bottom(*objects[i]->get_collision_object());
+
+  const size_t despawn_count = object_count / 2;
+  const auto remove_start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < despawn_count; ++i)
+    collision_system.remove(objects[i * 2]->get_collision_object());
+  const auto remove_end = std::chrono::steady_clock::now();
+
+  std::cout << object_count << " objects: "
+            << "add " << to_ns(add_end - add_start, object_count) << " ns, "
+            << "remove " << to_ns(remove_end - remove_start, despawn_count) << " ns" << std::endl;
+
+  for (size_t i = 0; i < despawn_count; ++i)
+    collision_system.remove(objects[i * 2 + 1]->get_collision_object());
+}
+
+} // namespace
+
+int main(void)
+{
+  // The Sector needs a scripting environment and preloads a sound.
+  setenv("ALSOFT_DRIVERS", "null", 1);
+  SoundManager sound_manager;
+  sound_manager.enable_sound(false);
+  SquirrelVirtualMachine squirrel_vm(false);
+
+  Level level(false);
+  Sector sector(level);
+
+  for (size_t object_count : OBJECT_COUNTS)
+    run(sector, object_count);
+
+  return 0;
+}
+
+/* EOF */
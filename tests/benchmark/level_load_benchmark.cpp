@@ -0,0 +1,151 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+// Parses every level below data/levels (or the directory given as the
+// first argument) and looks up keys in all of their mappings the way
+// object constructors do: every key that is there once, plus a few
+// that aren't and fall back to defaults. Compares the old linear scan
+// of ReaderMapping::get_item() with ReaderMappingIndex.
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sexp/parser.hpp>
+#include <sexp/value.hpp>
+#include <string>
+#include <vector>
+
+#include "util/reader_mapping_index.hpp"
+
+namespace {
+
+const int MISSING_KEYS = 10;
+
+using Clock = std::chrono::steady_clock;
+
+bool is_mapping(const sexp::Value& sx)
+{
+  if (!sx.is_array() || sx.as_array().size() < 2 || !sx.as_array()[0].is_symbol())
+    return false;
+
+  const auto& arr = sx.as_array();
+  for (size_t i = 1; i < arr.size(); ++i)
+    if (!arr[i].is_array() || arr[i].as_array().empty() || !arr[i].as_array()[0].is_symbol())
+      return false;
+  return true;
+}
+
+void collect_mappings(const sexp::Value& sx, std::vector<const std::vector<sexp::Value>*>& mappings)
+{
+  if (!sx.is_array())
+    return;
+
+  if (is_mapping(sx))
+    mappings.push_back(&sx.as_array());
+
+  for (const auto& child : sx.as_array())
+    collect_mappings(child, mappings);
+}
+
+size_t find_linear(const std::vector<sexp::Value>& arr, const char* key)
+{
+  for (size_t i = 1; i < arr.size(); ++i)
+    if (arr[i].as_array()[0].as_string() == key)
+      return i;
+  return 0;
+}
+
+std::vector<std::string> get_keys(const std::vector<sexp::Value>& arr)
+{
+  std::vector<std::string> keys;
+  for (size_t i = 1; i < arr.size(); ++i)
+    keys.push_back(arr[i].as_array()[0].as_string());
+  for (int i = 0; i < MISSING_KEYS; ++i)
+    keys.push_back("missing-key-" + std::to_string(i));
+  return keys;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  const std::string directory = argc > 1 ? argv[1] : "data/levels";
+
+  std::vector<sexp::Value> documents;
+  double parse_ms = 0.0;
+  for (const auto& entry : std::filesystem::recursive_directory_iterator(directory))
+  {
+    if (entry.path().extension() != ".stl")
+      continue;
+
+    std::ifstream in(entry.path());
+    const auto start = Clock::now();
+    documents.push_back(sexp::Parser::from_stream(in, sexp::Parser::USE_ARRAYS));
+    parse_ms += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+  }
+
+  std::vector<const std::vector<sexp::Value>*> mappings;
+  for (const auto& doc : documents)
+    collect_mappings(doc, mappings);
+
+  std::vector<std::vector<std::string>> keys;
+  size_t lookups = 0;
+  for (const auto* mapping : mappings)
+  {
+    keys.push_back(get_keys(*mapping));
+    lookups += keys.back().size();
+  }
+
+  size_t linear_found = 0;
+  auto start = Clock::now();
+  for (size_t i = 0; i < mappings.size(); ++i)
+    for (const auto& key : keys[i])
+      linear_found += find_linear(*mappings[i], key.c_str()) != 0;
+  const double linear_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+  // Same as ReaderMapping::get_item(): small mappings are still scanned.
+  size_t indexed_found = 0;
+  start = Clock::now();
+  for (size_t i = 0; i < mappings.size(); ++i)
+  {
+    const auto& arr = *mappings[i];
+    if (arr.size() <= ReaderMappingIndex::MIN_SIZE)
+    {
+      for (const auto& key : keys[i])
+        indexed_found += find_linear(arr, key.c_str()) != 0;
+      continue;
+    }
+
+    ReaderMappingIndex index;
+    index.build(arr);
+    for (const auto& key : keys[i])
+      indexed_found += index.find(arr, key.c_str()) != 0;
+  }
+  const double indexed_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+  std::cout << documents.size() << " levels, " << mappings.size() << " mappings, "
+            << lookups << " lookups" << std::endl
+            << "parsing: " << parse_ms << " ms" << std::endl
+            << "linear scan: " << linear_ms << " ms" << std::endl
+            << "indexed: " << indexed_ms << " ms"
+            << (linear_found == indexed_found ? "" : " (MISMATCH)") << std::endl;
+
+  return 0;
+}
+
+/* EOF */
@@ -0,0 +1,249 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Compares the per-frame cost of the snow particle system before and
+// after it moved to the ParticleStore. The old layout allocated every
+// particle on its own, referred to its texture through a shared_ptr and
+// found its own particle type with dynamic_cast; its update is kept here
+// as the reference. The new side runs the real SnowParticleSystem and
+// RainParticleSystem in a Sector. Both systems spawn their particles
+// along the width of the screen, so the null video system is given a
+// screen wide enough for the wanted count. Clouds and ghosts only ever
+// have a handful of particles and aren't measured.
+//
+// CustomParticleSystem keeps its particles in blocks of its own and runs
+// without a Sector, so its real update() is measured as well.
+
+#include <physfs.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "audio/sound_manager.hpp"
+#include "object/camera.hpp"
+#include "object/custom_particle_system.hpp"
+#include "object/rain_particle_system.hpp"
+#include "object/snow_particle_system.hpp"
+#include "squirrel/squirrel_virtual_machine.hpp"
+#include "supertux/gameconfig.hpp"
+#include "supertux/globals.hpp"
+#include "supertux/level.hpp"
+#include "supertux/sector.hpp"
+#include "video/null/null_video_system.hpp"
+
+namespace {
+
+const int FRAMES = 100;
+const float DT = 0.01f;
+const int SCREEN_HEIGHT_PX = 1080;
+
+// SnowParticleSystem spawns a flake per 5 pixels of screen width,
+// RainParticleSystem a drop per 3 pixels.
+const int SNOW_PIXELS_PER_PARTICLE = 5;
+const int RAIN_PIXELS_PER_PARTICLE = 3;
+
+// Square root of the default Sector gravity.
+const float GRAVITY_ROOT = 3.1622777f;
+const float GUST = 12.0f;
+const float EPSILON = 0.5f;
+const float WOBBLE_DECAY = 0.99f;
+const float WOBBLE_FACTOR = 4 * .005f;
+
+struct SnowTexture
+{
+  int id = 0;
+};
+
+class Particle
+{
+public:
+  virtual ~Particle() {}
+
+  float x = 0.0f;
+  float y = 0.0f;
+  float angle = 0.0f;
+  std::shared_ptr<SnowTexture> texture = {};
+  float alpha = 0.0f;
+};
+
+class SnowParticle : public Particle
+{
+public:
+  float speed = 0.0f;
+  float wobble = 0.0f;
+  float anchorx = 0.0f;
+  float drift_speed = 0.0f;
+  float spin_speed = 0.0f;
+  unsigned int flake_size = 0;
+};
+
+double update_old(std::vector<std::unique_ptr<Particle>>& particles, std::mt19937& rng)
+{
+  std::uniform_real_distribution<float> noise(-EPSILON, EPSILON);
+
+  const auto start = std::chrono::steady_clock::now();
+  for (int frame = 0; frame < FRAMES; ++frame)
+  {
+    for (auto& part : particles)
+    {
+      auto particle = dynamic_cast<SnowParticle*>(part.get());
+      if (!particle)
+        continue;
+
+      particle->y += particle->speed * DT * GRAVITY_ROOT;
+      particle->drift_speed += (GUST - particle->drift_speed) / static_cast<float>(particle->flake_size) + noise(rng);
+      particle->anchorx += particle->drift_speed * DT;
+      particle->x += particle->wobble * DT * GRAVITY_ROOT;
+      const float anchor_delta = particle->anchorx - particle->x;
+      particle->wobble += (WOBBLE_FACTOR * anchor_delta) + noise(rng);
+      particle->wobble *= WOBBLE_DECAY;
+      particle->angle += particle->spin_speed * DT;
+      particle->angle = fmodf(particle->angle, 360.0f);
+    }
+  }
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count() / FRAMES;
+}
+
+double run_old(size_t count)
+{
+  const std::vector<std::shared_ptr<SnowTexture>> textures = {
+    std::make_shared<SnowTexture>(), std::make_shared<SnowTexture>(), std::make_shared<SnowTexture>()
+  };
+
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+  std::vector<std::unique_ptr<Particle>> particles;
+  for (size_t i = 0; i < count; ++i)
+  {
+    const int size = static_cast<int>(i % 3);
+    auto particle = std::make_unique<SnowParticle>();
+    particle->x = dist(rng) * 1280.0f;
+    particle->y = dist(rng) * 800.0f;
+    particle->anchorx = particle->x;
+    particle->speed = 6.32f * (1.0f + dist(rng));
+    particle->angle = dist(rng) * 360.0f;
+    particle->spin_speed = dist(rng) * 120.0f - 60.0f;
+    particle->flake_size = static_cast<unsigned int>(powf(static_cast<float>(size) + 3.0f, 4.0f));
+    particle->texture = textures[size];
+    particles.push_back(std::move(particle));
+  }
+
+  return update_old(particles, rng);
+}
+
+double update_system(GameObject& system)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (int frame = 0; frame < FRAMES; ++frame)
+    system.update(DT);
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count() / FRAMES;
+}
+
+// Adds a T to an active Sector on a screen of the given width and times
+// its update().
+template<typename T>
+double run_in_sector(int screen_width)
+{
+  NullVideoSystem video_system(Size(screen_width, SCREEN_HEIGHT_PX));
+
+  Level level(false);
+  Sector sector(level);
+  sector.add<Camera>("Camera");
+  sector.flush_game_objects();
+  sector.activate(Vector(0.0f, 0.0f));
+
+  T& system = sector.add<T>();
+  sector.flush_game_objects();
+
+  return update_system(system);
+}
+
+void run_custom()
+{
+  NullVideoSystem video_system;
+
+  for (const int count : {10000, 50000})
+  {
+    // Every particle lives through the whole run and fades in, drifts,
+    // feathers and spins, so each step of the block update has work.
+    CustomParticleSystem system;
+    system.set_max_amount(count);
+    system.set_delay(1000.0f);
+    system.set_lifetime(1000.0f);
+    system.set_birth_mode("Fade");
+    system.set_birth_time(FRAMES * DT * 2);
+    system.set_speed_x(20.0f);
+    system.set_speed_y(40.0f);
+    system.set_speed_variation_x(10.0f);
+    system.set_speed_variation_y(10.0f);
+    system.set_acceleration_y(5.0f);
+    system.set_friction_x(0.1f);
+    system.set_feather_factor(0.01f);
+    system.set_rotation_speed(90.0f);
+    system.set_rotation_speed_variation(45.0f);
+    system.spawn_particles(count, true);
+
+    std::cout << count << " particles: custom particle system " << update_system(system)
+              << " ms/frame" << std::endl;
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  if (argc < 1 || !PHYSFS_init(argv[0]) || !PHYSFS_mount(BENCHMARK_DATA_DIR, nullptr, 1))
+  {
+    std::cerr << "Couldn't mount " << BENCHMARK_DATA_DIR << std::endl;
+    return 1;
+  }
+
+  Config config;
+  g_config = &config;
+
+  // The Sector needs a scripting environment and preloads a sound.
+  setenv("ALSOFT_DRIVERS", "null", 1);
+  SoundManager sound_manager;
+  sound_manager.enable_sound(false);
+  SquirrelVirtualMachine squirrel_vm(false);
+
+  for (const int count : {10000, 100000})
+  {
+    const double old_ms = run_old(count);
+    const double snow_ms = run_in_sector<SnowParticleSystem>(count * SNOW_PIXELS_PER_PARTICLE);
+    const double rain_ms = run_in_sector<RainParticleSystem>(count * RAIN_PIXELS_PER_PARTICLE);
+
+    std::cout << count << " particles: separate snow objects " << old_ms << " ms/frame, "
+              << "snow particle system " << snow_ms << " ms/frame, "
+              << "rain particle system " << rain_ms << " ms/frame" << std::endl;
+  }
+
+  run_custom();
+
+  g_config = nullptr;
+  PHYSFS_deinit();
+  return 0;
+}
+
+/* EOF */
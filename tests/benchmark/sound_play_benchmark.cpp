@@ -0,0 +1,175 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Plays bursts of short sound effects through the real SoundManager and
+// compares playing them by filename with playing them by cached SoundId
+// handles. OpenAL runs on its null output, so no audio device is needed,
+// and the sound files are replaced by silent in-memory samples, so the
+// disk isn't measured either. Allocations are counted by replacing the
+// global operator new.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "audio/sound_file.hpp"
+#include "audio/sound_manager.hpp"
+#include "util/log.hpp"
+
+namespace {
+
+size_t g_allocations = 0;
+
+const int PLAYS = 200000;
+
+const char* const SOUNDS[] = {
+  "sounds/jump.wav", "sounds/bigjump.wav", "sounds/coin.wav", "sounds/squish.wav",
+  "sounds/brick.wav", "sounds/kick.wav", "sounds/fall.wav", "sounds/hurt.wav"
+};
+const int SOUND_COUNT = sizeof(SOUNDS) / sizeof(SOUNDS[0]);
+
+/** A quarter second of 16 bit mono silence */
+class SilentSoundFile final : public SoundFile
+{
+public:
+  SilentSoundFile() :
+    m_position(0)
+  {
+    m_channels = 1;
+    m_rate = 22050;
+    m_bits_per_sample = 16;
+    m_size = 22050 / 4 * 2;
+  }
+
+  size_t read(void* buffer, size_t buffer_size) override
+  {
+    const size_t size = std::min(buffer_size, m_size - m_position);
+    memset(buffer, 0, size);
+    m_position += size;
+    return size;
+  }
+
+  void reset() override
+  {
+    m_position = 0;
+  }
+
+private:
+  size_t m_position;
+};
+
+float get_gain(int i)
+{
+  return 0.25f + static_cast<float>(i % 4) * 0.25f;
+}
+
+template<typename F>
+void run(const char* label, const F& play)
+{
+  const size_t allocations = g_allocations;
+  const auto start = std::chrono::steady_clock::now();
+  play();
+  const auto end = std::chrono::steady_clock::now();
+
+  const double seconds = std::chrono::duration<double>(end - start).count();
+  std::cout << label << ": " << seconds * 1000000000.0 / static_cast<double>(PLAYS)
+            << " ns/play, " << g_allocations - allocations << " allocations" << std::endl;
+}
+
+} // namespace
+
+// The parts of the game that SoundManager uses besides OpenAL.
+
+LogLevel g_log_level = LOG_WARNING;
+float g_real_time = 0.0f;
+
+std::ostream& log_debug_f(const char*, int, bool) { return std::cerr; }
+std::ostream& log_info_f(const char*, int) { return std::cerr; }
+std::ostream& log_warning_f(const char*, int) { return std::cerr; }
+std::ostream& log_fatal_f(const char*, int) { return std::cerr; }
+
+std::unique_ptr<SoundFile> load_sound_file(const std::string&)
+{
+  return std::make_unique<SilentSoundFile>();
+}
+
+void* operator new(size_t size)
+{
+  g_allocations += 1;
+  if (void* ptr = std::malloc(size ? size : 1))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+  std::free(ptr);
+}
+
+int main(void)
+{
+  // OpenAL Soft mixes into nothing with its null backend.
+  setenv("ALSOFT_DRIVERS", "null", 1);
+
+  SoundManager sound_manager;
+  if (!sound_manager.is_audio_enabled())
+  {
+    std::cerr << "OpenAL null device not available" << std::endl;
+    return 1;
+  }
+  sound_manager.set_sound_volume(100);
+
+  std::vector<std::string> names;
+  std::vector<SoundManager::SoundId> ids;
+  for (const char* sound : SOUNDS)
+  {
+    names.push_back(sound);
+    ids.push_back(SoundManager::get_sound_id(sound));
+    sound_manager.preload(sound);
+  }
+
+  // All voices stay busy during the runs, so most plays steal one.
+  run("play by filename", [&sound_manager] {
+    for (int i = 0; i < PLAYS; ++i)
+      sound_manager.play(SOUNDS[i % SOUND_COUNT], Vector(static_cast<float>(i % 640), 100.0f), get_gain(i));
+  });
+
+  run("play by stored filename", [&sound_manager, &names] {
+    for (int i = 0; i < PLAYS; ++i)
+      sound_manager.play(names[i % SOUND_COUNT], Vector(static_cast<float>(i % 640), 100.0f), get_gain(i));
+  });
+
+  run("play by SoundId", [&sound_manager, &ids] {
+    for (int i = 0; i < PLAYS; ++i)
+      sound_manager.play(ids[i % SOUND_COUNT], Vector(static_cast<float>(i % 640), 100.0f), get_gain(i));
+  });
+
+  sound_manager.stop_sounds();
+  return 0;
+}
+
+/* EOF */
@@ -0,0 +1,119 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Compares the cost of setting a sprite action per frame, as Player::draw()
+// does, between the old path, which built the action name from strings,
+// and interned ActionId handles, which are joined through cached tables.
+// Both go through the real Sprite::set_action() on Tux's sprite, loaded
+// from the data directory with the null video system. A steady action and
+// one that changes every frame are measured.
+
+#include <physfs.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "sprite/action_id.hpp"
+#include "sprite/sprite.hpp"
+#include "sprite/sprite_data.hpp"
+#include "supertux/direction.hpp"
+#include "supertux/gameconfig.hpp"
+#include "supertux/globals.hpp"
+#include "video/null/null_video_system.hpp"
+
+namespace {
+
+const int FRAMES = 2000000;
+
+const char* const PREFIX = "big";
+const char* const POSES[] = { "stand", "walk", "run", "jump", "skid", "kick" };
+const int POSE_COUNT = sizeof(POSES) / sizeof(POSES[0]);
+
+// The pose of frame i, either the same one all the time or a new one
+// every frame.
+int get_pose(int i, bool changing)
+{
+  return changing ? i % POSE_COUNT : 1;
+}
+
+Direction get_dir(int i, bool changing)
+{
+  return (changing && (i / POSE_COUNT) % 2) ? Direction::RIGHT : Direction::LEFT;
+}
+
+template<typename F>
+void run(const char* label, Sprite& sprite, const F& set_action)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < FRAMES; ++i)
+    set_action(sprite, i);
+  const auto end = std::chrono::steady_clock::now();
+
+  const double seconds = std::chrono::duration<double>(end - start).count();
+  std::cout << label << ": " << seconds * 1000000000.0 / static_cast<double>(FRAMES)
+            << " ns/frame (" << sprite.get_action() << ")" << std::endl;
+}
+
+void run_strings(const char* label, Sprite& sprite, bool changing)
+{
+  const std::string prefix = PREFIX;
+  run(label, sprite, [&prefix, changing](Sprite& spr, int i) {
+    spr.set_action(prefix + "-" + POSES[get_pose(i, changing)], get_dir(i, changing));
+  });
+}
+
+void run_handles(const char* label, Sprite& sprite, bool changing)
+{
+  const ActionId prefix(PREFIX);
+  std::vector<ActionId> poses;
+  for (const char* pose : POSES)
+    poses.push_back(ActionId(pose));
+
+  run(label, sprite, [&prefix, &poses, changing](Sprite& spr, int i) {
+    spr.set_action(ActionId::join(prefix, poses[get_pose(i, changing)]), get_dir(i, changing));
+  });
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  if (argc < 1 || !PHYSFS_init(argv[0]) || !PHYSFS_mount(BENCHMARK_DATA_DIR, nullptr, 1))
+  {
+    std::cerr << "Couldn't mount " << BENCHMARK_DATA_DIR << std::endl;
+    return 1;
+  }
+
+  Config config;
+  g_config = &config;
+  NullVideoSystem video_system;
+
+  SpriteData data("images/creatures/tux/tux.sprite");
+  Sprite sprite(data);
+
+  run_strings("strings, steady action", sprite, false);
+  run_handles("handles, steady action", sprite, false);
+  run_strings("strings, changing action", sprite, true);
+  run_handles("handles, changing action", sprite, true);
+
+  g_config = nullptr;
+  PHYSFS_deinit();
+  return 0;
+}
+
+/* EOF */
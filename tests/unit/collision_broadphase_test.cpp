@@ -0,0 +1,107 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "st_assert.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "collision/collision_broadphase.hpp"
+#include "math/rectf.hpp"
+
+namespace {
+
+bool contains(const std::vector<size_t>& result, size_t index)
+{
+  return std::find(result.begin(), result.end(), index) != result.end();
+}
+
+} // namespace
+
+int main(void)
+{
+  CollisionBroadphase broadphase(32.0f);
+  std::vector<size_t> result;
+
+  broadphase.reset(5);
+  broadphase.set(0, Rectf(0.0f, 0.0f, 16.0f, 16.0f));
+  broadphase.set(1, Rectf(100.0f, 0.0f, 116.0f, 16.0f));
+  broadphase.set(2, Rectf(16.0f, 0.0f, 32.0f, 16.0f));
+  broadphase.set(3, Rectf(-10000.0f, -10000.0f, 10000.0f, 10000.0f));
+  Rectf negative_rect(500.0f, 500.0f, 510.0f, 510.0f);
+  negative_rect.set_right(490.0f);
+  broadphase.set(4, negative_rect);
+
+  broadphase.query(Rectf(0.0f, 0.0f, 16.0f, 16.0f), result);
+  ST_ASSERT("query finds overlapping entry", contains(result, 0));
+  ST_ASSERT("query finds touching entry", contains(result, 2));
+  ST_ASSERT("query skips far away entry", !contains(result, 1));
+  ST_ASSERT("query always finds large entry", contains(result, 3));
+  ST_ASSERT("query results are sorted", std::is_sorted(result.begin(), result.end()));
+
+  broadphase.query(Rectf(495.0f, 505.0f, 496.0f, 506.0f), result);
+  ST_ASSERT("query finds entry with negative size", contains(result, 4));
+
+  const uint32_t revision = broadphase.get_revision();
+  broadphase.set(0, Rectf(1.0f, 1.0f, 17.0f, 17.0f));
+  ST_ASSERT("moving inside cells keeps revision", revision == broadphase.get_revision());
+
+  broadphase.set(0, Rectf(200.0f, 200.0f, 216.0f, 216.0f));
+  ST_ASSERT("moving to other cells changes revision", revision != broadphase.get_revision());
+
+  broadphase.query(Rectf(0.0f, 0.0f, 16.0f, 16.0f), result);
+  ST_ASSERT("moved entry is gone from old cells", !contains(result, 0));
+
+  broadphase.query(Rectf(210.0f, 210.0f, 220.0f, 220.0f), result);
+  ST_ASSERT("moved entry is found in new cells", contains(result, 0));
+
+  Rectf nan_rect;
+  nan_rect.set_pos(Vector(std::numeric_limits<float>::quiet_NaN(), 0.0f));
+  broadphase.set(1, nan_rect);
+  broadphase.query(Rectf(1000.0f, 1000.0f, 1001.0f, 1001.0f), result);
+  ST_ASSERT("entry without finite position is always found", contains(result, 1));
+
+  broadphase.query(nan_rect, result);
+  ST_ASSERT("query without finite position finds everything", result.size() == 5);
+
+  // Compare against a full scan with many entries.
+  const size_t count = 1000;
+  std::vector<Rectf> rects;
+  broadphase.reset(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    const float x = static_cast<float>((i * 7919) % 3000);
+    const float y = static_cast<float>((i * 104729) % 2000);
+    const float size = static_cast<float>(8 + (i % 5) * 20);
+    rects.push_back(Rectf(x, y, x + size, y + size));
+    broadphase.set(i, rects.back());
+  }
+
+  bool matches_full_scan = true;
+  for (size_t i = 0; i < count; ++i)
+  {
+    broadphase.query(rects[i], result);
+    for (size_t j = 0; j < count; ++j)
+      if (rects[i].overlaps(rects[j]) && !contains(result, j))
+        matches_full_scan = false;
+  }
+  ST_ASSERT("query finds every overlapping entry", matches_full_scan);
+
+  return 0;
+}
+
+/* EOF */
@@ -0,0 +1,61 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "st_assert.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "util/radix_sort.hpp"
+
+int main(void)
+{
+  std::vector<uint64_t> scratch;
+
+  std::vector<uint64_t> empty;
+  radix_sort(empty, scratch);
+  ST_ASSERT("empty input stays empty", empty.empty());
+
+  std::vector<uint64_t> keys = { 5, 0xffffffffffffffff, 0, 1ull << 40, 5, 3 };
+  std::vector<uint64_t> expected = keys;
+  std::sort(expected.begin(), expected.end());
+  radix_sort(keys, scratch);
+  ST_ASSERT("small input is sorted", keys == expected);
+
+  // Keys that only differ in the low bytes, like requests of one layer.
+  keys.clear();
+  for (uint64_t i = 0; i < 1000; ++i)
+    keys.push_back((50ull << 32) | (999 - i));
+  expected = keys;
+  std::sort(expected.begin(), expected.end());
+  radix_sort(keys, scratch);
+  ST_ASSERT("keys with equal high bytes are sorted", keys == expected);
+
+  std::mt19937_64 rng(42);
+  keys.clear();
+  for (int i = 0; i < 100000; ++i)
+    keys.push_back(rng());
+  expected = keys;
+  std::sort(expected.begin(), expected.end());
+  radix_sort(keys, scratch);
+  ST_ASSERT("random keys are sorted", keys == expected);
+
+  return 0;
+}
+
+/* EOF */
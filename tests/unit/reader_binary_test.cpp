@@ -0,0 +1,88 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "st_assert.hpp"
+
+#include <sexp/io.hpp>
+#include <sexp/parser.hpp>
+#include <sstream>
+
+#include "util/reader_binary.hpp"
+
+namespace {
+
+sexp::Value parse(const std::string& text)
+{
+  std::istringstream stream(text);
+  return sexp::Parser::from_stream(stream, sexp::Parser::USE_ARRAYS);
+}
+
+std::string to_string(const sexp::Value& sx)
+{
+  std::ostringstream out;
+  out << sx;
+  return out.str();
+}
+
+} // namespace
+
+int main(void)
+{
+  const sexp::Value sx = parse("(supertux-level\n"
+                               "  (version 3)\n"
+                               "  (name (_ \"Test\"))\n"
+                               "  (sector\n"
+                               "    (name \"main\")\n"
+                               "    (music \"\")\n"
+                               "    (gravity 10.5)\n"
+                               "    (solid #t)\n"
+                               "    (tilemap\n"
+                               "      (width 4) (height 2)\n"
+                               "      (tiles 1 2 3 4\n"
+                               "             -3 0 7 8))))\n");
+
+  std::string data;
+  ReaderBinary::write(sx, "key", data);
+
+  const auto result = ReaderBinary::read(data.data(), data.size(), "key");
+  ST_ASSERT("document survives the round trip", result && to_string(*result) == to_string(sx));
+
+  if (result)
+  {
+    const auto& sector = result->as_array()[3].as_array();
+    ST_ASSERT("reals stay reals", sector[3].as_array()[1].is_real() && !sector[3].as_array()[1].is_integer());
+
+    const auto& tiles = sector[5].as_array()[3].as_array();
+    const int expected_tiles[] = { 1, 2, 3, 4, -3, 0, 7, 8 };
+    bool tiles_kept = (tiles.size() == 9);
+    for (size_t i = 1; tiles_kept && i < tiles.size(); ++i)
+      tiles_kept = tiles[i].is_integer() && tiles[i].as_int() == expected_tiles[i - 1];
+    ST_ASSERT("integers stay integers", tiles_kept);
+    ST_ASSERT("lines are kept", sector[1].get_line() == sx.as_array()[3].as_array()[1].get_line());
+  }
+
+  ST_ASSERT("other key is rejected", !ReaderBinary::read(data.data(), data.size(), "other"));
+  ST_ASSERT("truncated data is rejected", !ReaderBinary::read(data.data(), data.size() - 1, "key"));
+
+  std::string other_version = data;
+  other_version[4] = static_cast<char>(other_version[4] + 1);
+  ST_ASSERT("other version is rejected", !ReaderBinary::read(other_version.data(), other_version.size(), "key"));
+
+  return 0;
+}
+
+/* EOF */
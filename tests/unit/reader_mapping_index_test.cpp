@@ -0,0 +1,62 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "st_assert.hpp"
+
+#include <sexp/parser.hpp>
+#include <sstream>
+#include <string>
+
+#include "util/reader_mapping_index.hpp"
+
+int main(void)
+{
+  std::ostringstream text;
+  text << "(object";
+  for (int i = 0; i < 100; ++i)
+    text << " (key" << i << " " << i << ")";
+  text << " (key7 \"duplicate\") (empty) (\"string\" 1))";
+
+  std::istringstream stream(text.str());
+  const sexp::Value sx = sexp::Parser::from_stream(stream, sexp::Parser::USE_ARRAYS);
+  const auto& arr = sx.as_array();
+
+  ReaderMappingIndex index;
+  ST_ASSERT("index starts out empty", !index.is_built());
+  index.build(arr);
+  ST_ASSERT("index is built", index.is_built());
+
+  bool all_found = true;
+  for (int i = 0; i < 100; ++i)
+  {
+    const std::string key = "key" + std::to_string(i);
+    const size_t pos = index.find(arr, key.c_str());
+    if (pos == 0 || arr[pos].as_array()[1].as_int() != i)
+      all_found = false;
+  }
+  ST_ASSERT("every key is found", all_found);
+
+  ST_ASSERT("first of duplicate keys is found", arr[index.find(arr, "key7")].as_array()[1].is_integer());
+  ST_ASSERT("key without value is found", index.find(arr, "empty") == 102);
+  ST_ASSERT("missing key isn't found", index.find(arr, "key100") == 0);
+  ST_ASSERT("mapping name isn't a key", index.find(arr, "object") == 0);
+  ST_ASSERT("strings aren't keys", index.find(arr, "string") == 0);
+
+  return 0;
+}
+
+/* EOF */
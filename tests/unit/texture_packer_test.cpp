@@ -0,0 +1,75 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "st_assert.hpp"
+
+#include <vector>
+
+#include "video/texture_packer.hpp"
+
+int main(void)
+{
+  TexturePacker packer(Size(256, 256));
+
+  ST_ASSERT("empty packer has no occupancy", packer.get_occupancy() == 0.0f);
+  ST_ASSERT("empty size is rejected", !packer.insert(Size(0, 16)));
+  ST_ASSERT("too wide size is rejected", !packer.insert(Size(257, 16)));
+
+  const auto first = packer.insert(Size(32, 32));
+  ST_ASSERT("first rect is placed", first.has_value());
+  ST_ASSERT("first rect is placed in the corner", *first == Rect(0, 0, 32, 32));
+
+  const auto second = packer.insert(Size(64, 16));
+  ST_ASSERT("second rect is placed next to the first", second && *second == Rect(32, 0, 96, 16));
+
+  // Fill the rest with differently sized rects and check that none of
+  // them overlap or leave the area.
+  std::vector<Rect> rects = { *first, *second };
+  for (int i = 0; ; ++i)
+  {
+    const auto rect = packer.insert(Size(8 + (i * 7) % 40, 8 + (i * 13) % 40));
+    if (!rect)
+      break;
+    rects.push_back(*rect);
+  }
+
+  bool inside = true;
+  bool overlapping = false;
+  int area = 0;
+  for (size_t i = 0; i < rects.size(); ++i)
+  {
+    area += rects[i].get_area();
+    if (!Rect(0, 0, 256, 256).contains(rects[i]))
+      inside = false;
+
+    for (size_t j = i + 1; j < rects.size(); ++j)
+    {
+      if (rects[i].left < rects[j].right && rects[j].left < rects[i].right &&
+          rects[i].top < rects[j].bottom && rects[j].top < rects[i].bottom)
+        overlapping = true;
+    }
+  }
+
+  ST_ASSERT("all rects are inside the area", inside);
+  ST_ASSERT("no rects overlap", !overlapping);
+  ST_ASSERT("used area is tracked", packer.get_used_area() == area);
+  ST_ASSERT("area is filled well", packer.get_occupancy() > 0.75f);
+
+  return 0;
+}
+
+/* EOF */
@@ -0,0 +1,118 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "st_assert.hpp"
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "util/thread_pool.hpp"
+
+int main(void)
+{
+  ThreadPool pool(3);
+  ST_ASSERT("pool counts the calling thread", pool.get_thread_count() == 4);
+
+  std::vector<int> calls(1000, 0);
+  for (int round = 0; round < 100; ++round)
+  {
+    pool.parallel_for(calls.size(), [&calls](size_t i) { calls[i] += 1; });
+  }
+
+  bool all_called = true;
+  for (const int count : calls)
+    if (count != 100)
+      all_called = false;
+  ST_ASSERT("every index is called once per loop", all_called);
+
+  const std::thread::id caller_id = std::this_thread::get_id();
+  bool caller_task_on_caller = false;
+  std::atomic<int> calls_with_caller_task(0);
+  pool.parallel_for(100, [&calls_with_caller_task](size_t) { calls_with_caller_task += 1; },
+                    [&caller_task_on_caller, caller_id] {
+                      caller_task_on_caller = std::this_thread::get_id() == caller_id;
+                    });
+  ST_ASSERT("caller task runs on the caller", caller_task_on_caller);
+  ST_ASSERT("loop runs next to the caller task", calls_with_caller_task == 100);
+
+  std::atomic<int> empty_calls(0);
+  pool.parallel_for(0, [&empty_calls](size_t) { empty_calls += 1; });
+  ST_ASSERT("empty loop calls nothing", empty_calls == 0);
+
+  bool thrown = false;
+  try
+  {
+    pool.parallel_for(100, [](size_t i) {
+      if (i == 42)
+        throw std::runtime_error("task failed");
+    });
+  }
+  catch (const std::runtime_error&)
+  {
+    thrown = true;
+  }
+  ST_ASSERT("exceptions reach the caller", thrown);
+
+  std::atomic<int> calls_after_error(0);
+  pool.parallel_for(100, [&calls_after_error](size_t) { calls_after_error += 1; });
+  ST_ASSERT("pool works after an exception", calls_after_error == 100);
+
+  std::vector<std::future<int>> jobs;
+  for (int i = 0; i < 50; ++i)
+    jobs.push_back(pool.schedule([i] { return i * 2; }));
+
+  // Loops still run while jobs are waiting.
+  std::atomic<int> calls_next_to_jobs(0);
+  pool.parallel_for(100, [&calls_next_to_jobs](size_t) { calls_next_to_jobs += 1; });
+  ST_ASSERT("loop runs next to jobs", calls_next_to_jobs == 100);
+
+  bool all_results = true;
+  for (int i = 0; i < 50; ++i)
+    if (jobs[i].get() != i * 2)
+      all_results = false;
+  ST_ASSERT("jobs deliver their results", all_results);
+
+  auto nested = pool.schedule([&pool] { return pool.schedule([] { return 7; }); });
+  ST_ASSERT("jobs can schedule jobs", nested.get().get() == 7);
+
+  auto failing = pool.schedule([]() -> int { throw std::runtime_error("job failed"); });
+  bool job_thrown = false;
+  try
+  {
+    failing.get();
+  }
+  catch (const std::runtime_error&)
+  {
+    job_thrown = true;
+  }
+  ST_ASSERT("job exceptions reach the future", job_thrown);
+
+  ThreadPool serial_pool(0);
+  int serial_calls = 0;
+  serial_pool.parallel_for(10, [&serial_calls](size_t) { serial_calls += 1; });
+  ST_ASSERT("pool without workers runs on the caller", serial_calls == 10);
+
+  auto serial_job = serial_pool.schedule([] { return std::this_thread::get_id(); });
+  ST_ASSERT("pool without workers runs jobs on the caller", serial_job.get() == caller_id);
+
+  return 0;
+}
+
+/* EOF */